@@ -0,0 +1,108 @@
+#include <arena_allocator.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <expression.hpp>
+#include <memory>
+#include <numa_allocator.hpp>
+#include <plane.hpp>
+#include <reshape.hpp>
+#include <shape_transmutation.hpp>
+#include <slab_allocator.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+// The rows of the source plane are padded, which forces reshape to allocate a new plane
+constexpr nt::Dimensions<30u, 32u> dimensions;
+constexpr nt::Dimensions<32u, 30u> reshaped_dimensions;
+constexpr std::size_t num_steps = 16u;
+constexpr std::size_t num_temporaries = 2u * num_steps;
+
+/*
+ * Simulates a request that creates temporary planes: each step reshapes the source plane (allocating a copy), and
+ * evaluates an expression into a newly created plane
+ */
+template <typename Buffer>
+void run_request() {
+  auto source = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<Buffer, dimensions>());
+  nt::execute([](float& v) { v = 1.0f; }, source);
+
+  for (std::size_t step = 0u; step < num_steps; ++step) {
+    auto reshaped = nt::reshape<reshaped_dimensions>(source);
+    auto result = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<Buffer, reshaped_dimensions>());
+    nt::assign(result, reshaped * reshaped + reshaped);
+    bm::do_not_optimize(result.slicing_value(0u, 0u, 0u));
+  }
+}
+
+nt::LinearArena<> linear_arena;
+nt::FreeListArena<> free_list_arena;
+
+}  // namespace
+
+NT_BENCHMARK(allocator_request_aligned_malloc, num_temporaries) { run_request<nt::DenseBuffer<float>>(); }
+
+NT_BENCHMARK(allocator_request_linear, num_temporaries) {
+  {
+    nt::ArenaScope scope{linear_arena};
+    run_request<nt::DenseBuffer<float, nt::LinearAllocator<float>>>();
+  }
+  linear_arena.reset();
+}
+
+NT_BENCHMARK(allocator_request_free_list, num_temporaries) {
+  nt::ArenaScope scope{free_list_arena};
+  run_request<nt::DenseBuffer<float, nt::FreeListAllocator<float>>>();
+}
+
+NT_BENCHMARK(allocator_request_slab, num_temporaries) { run_request<nt::PooledBuffer<float>>(); }
+
+namespace {
+
+// A plane much larger than the caches, whose pages are all written for the first time
+constexpr nt::Dimensions<2048u, 2048u> large_dimensions;
+constexpr std::size_t num_large_elements = 2048u * 2048u;
+
+constexpr auto scale = [](float& v) { v = v * 0.5f + 1.0f; };
+
+/*
+ * Creates a large plane, and passes over it once in parallel
+ */
+template <typename Create>
+void run_large_plane(Create&& create) {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(create());
+  nt::execute(nt::par, scale, tensor);
+  bm::do_not_optimize(tensor.slicing_value(0u, 0u, 0u));
+}
+
+}  // namespace
+
+// The pages are placed by the single thread initializing the plane
+NT_BENCHMARK(allocator_large_plane_sequential_touch, num_large_elements) {
+  run_large_plane([] {
+    auto plane = nt::create_plane<nt::DenseBuffer<float>, large_dimensions>();
+    nt::execute([](float& v) { v = 0.0f; }, nt::create_tensor<nt::ShapeTransmutation>(plane));
+    return plane;
+  });
+}
+
+// The pages are placed by the threads of the parallel pass
+NT_BENCHMARK(allocator_large_plane_parallel_touch, num_large_elements) {
+  run_large_plane([] { return nt::create_plane<nt::DenseBuffer<float>, large_dimensions>(nt::par); });
+}
+
+NT_BENCHMARK(allocator_large_plane_numa_first_touch, num_large_elements) {
+  run_large_plane([] {
+    return nt::create_plane<nt::NumaBuffer<float>, large_dimensions>(
+        nt::par, std::allocator_arg, nt::NumaAllocator<float>{nt::numa_placement::first_touch});
+  });
+}
+
+NT_BENCHMARK(allocator_large_plane_numa_interleave, num_large_elements) {
+  run_large_plane([] { return nt::create_plane<nt::NumaBuffer<float>, large_dimensions>(nt::par); });
+}
@@ -0,0 +1,87 @@
+#include <async.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <optional>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sstream>
+#include <stream_io.hpp>
+#include <string>
+#include <string_view>
+#include <tensor.hpp>
+#include <thread_pool.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<128u, 128u> dimensions;
+constexpr std::size_t num_planes = 16u;
+constexpr std::size_t num_elements = 128u * 128u;
+
+auto make_tensor() {
+  return nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+}
+
+// Text of each plane, as read from a file
+const std::vector<std::string> texts = [] {
+  std::vector<std::string> texts;
+  for (std::size_t i = 0u; i < num_planes; ++i) {
+    auto tensor = make_tensor();
+    int value = static_cast<int>(i);
+    nt::execute([&value](int& v) { v = value++ % 1000; }, tensor);
+    std::stringstream ss;
+    nt::write_to_sink(tensor, ss);
+    texts.emplace_back(ss.str());
+  }
+  return texts;
+}();
+
+auto load(const std::string& text) {
+  auto tensor = make_tensor();
+  nt::load_from_source(tensor, text);
+  return tensor;
+}
+
+template <typename Tensor>
+Tensor transform(Tensor tensor) {
+  nt::execute([](int& v) { v = v * 3 + 1; }, tensor);
+  return tensor;
+}
+
+template <typename Tensor>
+std::size_t write(const Tensor& tensor) {
+  std::stringstream ss;
+  nt::write_to_sink(tensor, ss);
+  return ss.view().size();
+}
+
+}  // namespace
+
+// Items are the elements of all planes, each of which is loaded, transformed and written
+NT_BENCHMARK(pipeline_load_transform_write_sequential, num_planes * num_elements) {
+  std::size_t size = 0u;
+  for (const auto& text : texts) {
+    size += write(transform(load(text)));
+  }
+  bm::do_not_optimize(size);
+}
+
+NT_BENCHMARK(pipeline_load_transform_write_run_pipeline, num_planes * num_elements) {
+  std::size_t next = 0u;
+  std::size_t size = 0u;
+  auto future = nt::run_pipeline(
+      nt::default_thread_pool(), 2u,
+      [&next]() -> std::optional<std::string_view> {
+        if (next == texts.size()) return std::nullopt;
+        return texts[next++];
+      },
+      [](std::string_view text) { return transform(load(std::string{text})); },
+      [&size](const auto& tensor) { size += write(tensor); });
+  nt::await_future(nt::default_thread_pool(), future);
+  bm::do_not_optimize(size);
+}
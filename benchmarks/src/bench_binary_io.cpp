@@ -0,0 +1,47 @@
+#include <binary_io.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <filesystem>
+#include <fstream>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1000u, 1024u> dimensions;
+constexpr std::size_t num_elements = 1000u * 1024u;
+
+auto tensor = [] {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+  nt::execute([](float& v) { v = 1.0f; }, tensor);
+  return tensor;
+}();
+
+const auto path = std::filesystem::temp_directory_path() / "ntensor_bench_binary_io.bin";
+
+}  // namespace
+
+NT_BENCHMARK(binary_write, num_elements) {
+  std::ofstream stream{path, std::ios::binary};
+  nt::write_binary(tensor, stream);
+}
+
+NT_BENCHMARK(binary_load, num_elements) {
+  std::ifstream stream{path, std::ios::binary};
+  nt::load_binary(tensor, stream);
+  bm::do_not_optimize(tensor.slicing_value(0u, 0u, 0u));
+}
+
+// Maps the file and reads every element once, so the cost of faulting the pages in is included
+NT_BENCHMARK(binary_map_and_read, num_elements) {
+  auto mapped_tensor = nt::map_binary<decltype(tensor)>(path);
+  float sum = 0.0f;
+  nt::execute([&sum](const float& v) { sum += v; }, mapped_tensor);
+  bm::do_not_optimize(sum);
+}
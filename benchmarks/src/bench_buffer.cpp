@@ -0,0 +1,77 @@
+#include <dense_buffer.hpp>
+#include <sparse_buffer.hpp>
+#include <sparse_containers.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr std::size_t num_elements = 1u << 20u;
+constexpr std::size_t num_accesses = 1u << 16u;
+
+// Pseudo-random locations, identical for all buffers
+const auto locations = [] {
+  std::vector<std::size_t> locations;
+  std::size_t state = 1u;
+  for (std::size_t i = 0u; i < num_accesses; ++i) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    locations.push_back((state >> 33u) % num_elements);
+  }
+  return locations;
+}();
+
+// Every 100th element is non-zero
+template <typename Buffer>
+Buffer make_buffer() {
+  Buffer buffer{num_elements};
+  for (std::size_t i = 0u; i < num_elements; i += 100u) {
+    buffer[i] = 1.0f;
+  }
+  return buffer;
+}
+
+const auto dense = make_buffer<nt::DenseBuffer<float>>();
+const auto hashed = make_buffer<nt::SparseBuffer<float>>();
+const auto coo = make_buffer<nt::SparseBuffer<float, nt::CooContainer<float>>>();
+const auto csr = make_buffer<nt::SparseBuffer<float, nt::CsrContainer<float, 1024u>>>();
+
+template <typename Buffer>
+void sequential_read(const Buffer& buffer) {
+  float sum = 0.0f;
+  for (std::size_t i = 0u; i < num_elements; ++i) {
+    sum += buffer[i];
+  }
+  bm::do_not_optimize(sum);
+}
+
+template <typename Buffer>
+void random_read(const Buffer& buffer) {
+  float sum = 0.0f;
+  for (std::size_t location : locations) {
+    sum += buffer[location];
+  }
+  bm::do_not_optimize(sum);
+}
+
+}  // namespace
+
+NT_BENCHMARK(buffer_sequential_read_dense, num_elements) { sequential_read(dense); }
+
+NT_BENCHMARK(buffer_sequential_read_sparse_hashed, num_elements) { sequential_read(hashed); }
+
+NT_BENCHMARK(buffer_sequential_read_sparse_coo, num_elements) { sequential_read(coo); }
+
+NT_BENCHMARK(buffer_sequential_read_sparse_csr, num_elements) { sequential_read(csr); }
+
+NT_BENCHMARK(buffer_random_read_dense, num_accesses) { random_read(dense); }
+
+NT_BENCHMARK(buffer_random_read_sparse_hashed, num_accesses) { random_read(hashed); }
+
+NT_BENCHMARK(buffer_random_read_sparse_coo, num_accesses) { random_read(coo); }
+
+NT_BENCHMARK(buffer_random_read_sparse_csr, num_accesses) { random_read(csr); }
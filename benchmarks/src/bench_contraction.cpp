@@ -0,0 +1,66 @@
+#include <contraction.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+// Square matrices of floats. The items of a run are the multiply-adds of the product
+constexpr std::size_t size = 256u;
+constexpr nt::Dimensions<size, size> dimensions;
+constexpr std::size_t num_multiply_adds = size * size * size;
+
+template <typename T>
+auto make_matrix(int seed) {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<T>, dimensions>());
+  nt::execute([&seed](T& v) { v = static_cast<T>((seed = (seed * 7 + 3) % 11) - 5); }, tensor);
+  return tensor;
+}
+
+auto lhs = make_matrix<float>(1);
+auto rhs = make_matrix<float>(2);
+auto transposed_rhs = rhs.template permute<0u, 1u, 0u>();
+
+// The product written as a triple loop over slicing_value, as it was computed before matmul existed
+template <typename Rhs>
+void loop_matmul(Rhs& rhs) {
+  auto result = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+  for (std::size_t m = 0u; m < size; ++m) {
+    for (std::size_t n = 0u; n < size; ++n) {
+      float sum = 0.0f;
+      for (std::size_t k = 0u; k < size; ++k) {
+        sum += lhs.slicing_value(0u, k, m) * rhs.slicing_value(0u, n, k);
+      }
+      result.slicing_value(0u, n, m) = sum;
+    }
+  }
+  bm::do_not_optimize(result.slicing_value(0u, 0u, 0u));
+}
+
+}  // namespace
+
+NT_BENCHMARK(contraction_matmul_loops, num_multiply_adds) { loop_matmul(rhs); }
+
+NT_BENCHMARK(contraction_matmul, num_multiply_adds) {
+  auto result = nt::matmul(lhs, rhs);
+  bm::do_not_optimize(result.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(contraction_matmul_parallel, num_multiply_adds) {
+  auto result = nt::matmul(nt::par, lhs, rhs);
+  bm::do_not_optimize(result.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(contraction_matmul_transposed_loops, num_multiply_adds) { loop_matmul(transposed_rhs); }
+
+NT_BENCHMARK(contraction_matmul_transposed, num_multiply_adds) {
+  auto result = nt::matmul(lhs, transposed_rhs);
+  bm::do_not_optimize(result.slicing_value(0u, 0u, 0u));
+}
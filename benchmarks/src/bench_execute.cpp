@@ -0,0 +1,246 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+// Planes with the same product of dimensions, but different shapes. The aligned strides of the first plane contain a
+// padding, so the positions of its elements can't be computed from the positions of the second plane's elements
+constexpr nt::Dimensions<100u, 64u, 32u> first_dimensions;
+constexpr nt::Dimensions<200u, 32u, 32u> second_dimensions;
+constexpr std::size_t num_elements = 100u * 64u * 32u;
+
+auto first_plane = nt::create_plane<nt::DenseBuffer<float>, first_dimensions>();
+auto second_plane = nt::create_plane<nt::DenseBuffer<float>, second_dimensions>();
+auto third_plane = nt::create_plane<nt::DenseBuffer<float>, first_dimensions>();
+
+// Rows of 30 floats: the aligned strides pad every row to the alignment, the unaligned strides pack the rows
+constexpr nt::Dimensions<100u, 64u, 30u> padded_dimensions;
+constexpr std::size_t num_padded_elements = 100u * 64u * 30u;
+
+auto aligned_lhs = nt::create_plane<nt::DenseBuffer<float>, padded_dimensions>();
+auto aligned_rhs = nt::create_plane<nt::DenseBuffer<float>, padded_dimensions>();
+auto unaligned_lhs = nt::create_plane<nt::DenseBuffer<float>, padded_dimensions, 1u, false>();
+auto unaligned_rhs = nt::create_plane<nt::DenseBuffer<float>, padded_dimensions, 1u, false>();
+
+/*
+ * The iteration used by iterative_execute before the position counters were introduced: the positions of all elements
+ * are computed from their indexes using a division and a modulo per dimension
+ */
+template <typename Invocable, typename... Planes>
+void divmod_iterative_execute(Invocable&& invocable, Planes&&... planes) {
+  using first_plane_type = std::decay_t<nt::fts_t<Planes...>>;
+  static constexpr std::size_t N = nt::product(first_plane_type::dimensions());
+  static constexpr std::size_t channels = first_plane_type::channels();
+  static constexpr std::tuple strides{std::decay_t<Planes>::strides()...};
+  static constexpr std::tuple unaligned_strides{nt::compute_unaligned_strides(std::decay_t<Planes>::dimensions())...};
+
+  for (std::size_t idx = 0u; idx < N; ++idx) {
+    for (std::size_t c = 0u; c < channels; ++c) {
+      [c, idx, &invocable, &planes...]<std::size_t... is>(std::index_sequence<is...>) {
+        const std::array positions{nt::compute_array_position_from_index<channels>(std::get<is>(unaligned_strides),
+                                                                                   std::get<is>(strides), c, idx)...};
+        invocable(planes.at(positions[is])...);
+      }(std::make_index_sequence<sizeof...(Planes)>());
+    }
+  }
+}
+
+constexpr auto copy = [](float& lhs, const float& rhs) { lhs = rhs; };
+
+}  // namespace
+
+NT_BENCHMARK(iterative_execute_divmod, num_elements) {
+  divmod_iterative_execute(copy, first_plane, second_plane);
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+NT_BENCHMARK(iterative_execute_position_counter, num_elements) {
+  nt::iterative_execute(copy, first_plane, second_plane);
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+NT_BENCHMARK(recursive_execute_matching_dimensions, num_elements) {
+  nt::recursive_execute(copy, first_plane, third_plane);
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+NT_BENCHMARK(iterative_execute_matching_dimensions, num_elements) {
+  nt::iterative_execute(copy, first_plane, third_plane);
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+NT_BENCHMARK(recursive_execute_aligned_strides, num_padded_elements) {
+  nt::recursive_execute(copy, aligned_lhs, aligned_rhs);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(recursive_execute_unaligned_strides, num_padded_elements) {
+  nt::recursive_execute(copy, unaligned_lhs, unaligned_rhs);
+  bm::do_not_optimize(unaligned_lhs[0u]);
+}
+
+NT_BENCHMARK(iterative_execute_aligned_strides, num_padded_elements) {
+  nt::iterative_execute(copy, aligned_lhs, aligned_rhs);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(iterative_execute_unaligned_strides, num_padded_elements) {
+  nt::iterative_execute(copy, unaligned_lhs, unaligned_rhs);
+  bm::do_not_optimize(unaligned_lhs[0u]);
+}
+
+namespace {
+
+// The same planes as first_plane and third_plane, whose dimensions are only known at runtime
+auto dynamic_lhs = nt::to_dynamic_plane(first_plane);
+auto dynamic_rhs = nt::to_dynamic_plane(third_plane);
+
+}  // namespace
+
+NT_BENCHMARK(recursive_execute_dynamic_plane, num_elements) {
+  nt::recursive_execute(copy, dynamic_lhs, dynamic_rhs);
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+NT_BENCHMARK(recursive_execute_dispatch_static, num_elements) {
+  nt::dispatch_static<first_dimensions>(dynamic_lhs, [](auto&& lhs) {
+    nt::dispatch_static<first_dimensions>(dynamic_rhs, [&lhs](auto&& rhs) { nt::recursive_execute(copy, lhs, rhs); });
+  });
+  bm::do_not_optimize(first_plane[0u]);
+}
+
+namespace {
+
+// Many small planes, such as 4x4 transforms or 3x3 pixel neighbourhoods, iterated one after another
+constexpr std::size_t num_small_planes = 4096u;
+
+using small_plane_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<4u, 4u>{}>());
+using small_rgb_plane_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<3u, 3u>{}, 3u>());
+
+template <typename Plane>
+std::vector<Plane> create_small_planes() {
+  std::vector<Plane> planes;
+  planes.reserve(num_small_planes);
+  for (std::size_t i = 0u; i < num_small_planes; ++i) {
+    planes.push_back(nt::create_plane<typename Plane::buffer_type, Plane::dimensions(), Plane::channels()>());
+  }
+  return planes;
+}
+
+auto small_lhs = create_small_planes<small_plane_type>();
+auto small_rhs = create_small_planes<small_plane_type>();
+auto small_rgb_lhs = create_small_planes<small_rgb_plane_type>();
+auto small_rgb_rhs = create_small_planes<small_rgb_plane_type>();
+
+constexpr auto multiply_add = [](float& lhs, const float& rhs) { lhs = lhs * 0.5f + rhs; };
+
+}  // namespace
+
+// recursive_execute is the loop that sequenced_recursive_execute used for all planes before small planes were unrolled
+NT_BENCHMARK(recursive_execute_small_planes_loops, num_small_planes * 16u) {
+  for (std::size_t i = 0u; i < num_small_planes; ++i) {
+    nt::recursive_execute(multiply_add, small_lhs[i], small_rhs[i]);
+  }
+  bm::do_not_optimize(small_lhs[0u][0u]);
+}
+
+NT_BENCHMARK(recursive_execute_small_planes_unrolled, num_small_planes * 16u) {
+  for (std::size_t i = 0u; i < num_small_planes; ++i) {
+    nt::sequenced_recursive_execute<nt::sequenced_policy>(multiply_add, small_lhs[i], small_rhs[i]);
+  }
+  bm::do_not_optimize(small_lhs[0u][0u]);
+}
+
+NT_BENCHMARK(recursive_execute_small_rgb_planes_loops, num_small_planes * 27u) {
+  for (std::size_t i = 0u; i < num_small_planes; ++i) {
+    nt::recursive_execute(multiply_add, small_rgb_lhs[i], small_rgb_rhs[i]);
+  }
+  bm::do_not_optimize(small_rgb_lhs[0u][0u]);
+}
+
+NT_BENCHMARK(recursive_execute_small_rgb_planes_unrolled, num_small_planes * 27u) {
+  for (std::size_t i = 0u; i < num_small_planes; ++i) {
+    nt::sequenced_recursive_execute<nt::sequenced_policy>(multiply_add, small_rgb_lhs[i], small_rgb_rhs[i]);
+  }
+  bm::do_not_optimize(small_rgb_lhs[0u][0u]);
+}
+
+namespace {
+
+// A bias added to each row, and a scale multiplied with each column of the padded planes
+auto bias = nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<100u>{}>();
+auto column_scale = nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<1u, 64u, 30u>{}>();
+auto broadcast_lhs = nt::create_tensor<nt::ShapeTransmutation>(aligned_lhs);
+const auto broadcast_bias = nt::create_tensor<nt::ShapeTransmutation>(bias);
+const auto broadcast_column_scale = nt::create_tensor<nt::ShapeTransmutation>(column_scale);
+
+// The planes repeated to the dimensions of aligned_lhs, as they had to be before execute supported broadcasting
+const auto repeated_bias = nt::create_tensor<nt::ShapeTransmutation>(aligned_rhs);
+const auto repeated_column_scale =
+    nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, padded_dimensions>());
+
+constexpr auto add = nt::vectorized([](auto& lhs, const auto& rhs) { lhs += rhs; });
+constexpr auto multiply = nt::vectorized([](auto& lhs, const auto& rhs) { lhs *= rhs; });
+
+}  // namespace
+
+NT_BENCHMARK(execute_add_repeated_row, num_padded_elements) {
+  nt::execute(nt::unseq, add, broadcast_lhs, repeated_bias);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(execute_add_broadcast_row, num_padded_elements) {
+  nt::execute(nt::unseq, add, broadcast_lhs, broadcast_bias);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(execute_multiply_repeated_column, num_padded_elements) {
+  nt::execute(nt::unseq, multiply, broadcast_lhs, repeated_column_scale);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(execute_multiply_broadcast_column, num_padded_elements) {
+  nt::execute(nt::unseq, multiply, broadcast_lhs, broadcast_column_scale);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+NT_BENCHMARK(execute_multiply_broadcast_column_sequenced, num_padded_elements) {
+  nt::execute(nt::seq, multiply, broadcast_lhs, broadcast_column_scale);
+  bm::do_not_optimize(aligned_lhs[0u]);
+}
+
+namespace {
+
+// Planes of a YUV 4:2:0 image, whose chroma planes have a quarter of the elements of the luma plane
+auto yuv = nt::create_tensor<nt::ShapeTransmutation>(
+    nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<1920u, 1080u>{}>(),
+    nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<960u, 540u>{}>(),
+    nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<960u, 540u>{}>());
+constexpr std::size_t num_yuv_elements = 1920u * 1080u * 3u / 2u;
+
+constexpr auto scale = [](auto& v) { v = v * 0.5f + 1.0f; };
+
+}  // namespace
+
+// Each plane is split into chunks, and all chunks of a plane are completed before the next plane starts
+NT_BENCHMARK(execute_yuv_planes_par, num_yuv_elements) {
+  nt::execute(nt::par, scale, yuv);
+  bm::do_not_optimize(yuv.slicing_value(0u, 0u, 0u));
+}
+
+// The planes run concurrently, starting with the luma plane
+NT_BENCHMARK(for_each_plane_yuv_planes_par, num_yuv_elements) {
+  nt::for_each_plane(
+      nt::par, [](auto& plane) { nt::execute(nt::seq, scale, nt::create_tensor<nt::ShapeTransmutation>(plane)); },
+      yuv);
+  bm::do_not_optimize(yuv.slicing_value(0u, 0u, 0u));
+}
@@ -0,0 +1,47 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <expression.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1000u, 1024u> dimensions;
+constexpr std::size_t num_elements = 1000u * 1024u;
+
+auto make_tensor(float value) {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+  nt::execute([value](float& v) { v = value; }, tensor);
+  return tensor;
+}
+
+auto a = make_tensor(1.0f);
+auto b = make_tensor(2.0f);
+auto c = make_tensor(3.0f);
+auto d = make_tensor(0.0f);
+
+}  // namespace
+
+// d = a * b + c computed with one execute pass per operation
+NT_BENCHMARK(expression_separate_passes, num_elements) {
+  nt::execute([](float& dst, const float& lhs, const float& rhs) { dst = lhs * rhs; }, d, a, b);
+  nt::execute([](float& dst, const float& rhs) { dst += rhs; }, d, c);
+  nt::execute([](float& dst) { dst *= 0.5f; }, d);
+  bm::do_not_optimize(d.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(expression_fused_seq, num_elements) {
+  nt::assign(d, (a * b + c) * 0.5f);
+  bm::do_not_optimize(d.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(expression_fused_unseq, num_elements) {
+  nt::assign(nt::unseq, d, (a * b + c) * 0.5f);
+  bm::do_not_optimize(d.slicing_value(0u, 0u, 0u));
+}
@@ -0,0 +1,50 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <materialize.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1024u, 1024u> dimensions;
+constexpr std::size_t num_elements = 1024u * 1024u;
+
+template <typename T>
+auto make_transposed() {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<T>, dimensions>());
+  nt::execute([](T& v) { v = T{1}; }, tensor);
+  return tensor.template permute<0u, 1u, 0u>();
+}
+
+auto transposed_float = make_transposed<float>();
+auto transposed_double = make_transposed<double>();
+
+// The copy used before materialize existed: the destination is walked in order, the source across its rows
+template <typename T, typename Tensor>
+void execute_copy(Tensor& transposed) {
+  auto copy = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<T>, dimensions>());
+  nt::execute([](T& lhs, const T& rhs) { lhs = rhs; }, copy, transposed);
+  bm::do_not_optimize(copy.slicing_value(0u, 0u, 0u));
+}
+
+}  // namespace
+
+NT_BENCHMARK(materialize_transpose_execute_copy_float, num_elements) { execute_copy<float>(transposed_float); }
+
+NT_BENCHMARK(materialize_transpose_float, num_elements) {
+  auto materialized = nt::materialize(transposed_float);
+  bm::do_not_optimize(materialized.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(materialize_transpose_execute_copy_double, num_elements) { execute_copy<double>(transposed_double); }
+
+NT_BENCHMARK(materialize_transpose_double, num_elements) {
+  auto materialized = nt::materialize(transposed_double);
+  bm::do_not_optimize(materialized.slicing_value(0u, 0u, 0u));
+}
@@ -0,0 +1,48 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <functional>
+#include <plane.hpp>
+#include <reduce.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1000u, 1024u> dimensions;
+constexpr std::size_t num_elements = 1000u * 1024u;
+
+auto tensor = [] {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+  nt::execute([](float& v) { v = 1.0f; }, tensor);
+  return tensor;
+}();
+
+}  // namespace
+
+// The pattern used before the reduction engine was introduced: a single accumulator captured by the invocable
+NT_BENCHMARK(reduce_sum_captured_accumulator, num_elements) {
+  float sum = 0.0f;
+  nt::execute([&sum](const float& v) { sum += v; }, tensor);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(reduce_sum_seq, num_elements) { bm::do_not_optimize(nt::reduce(tensor, std::plus<>{}, 0.0f)); }
+
+NT_BENCHMARK(reduce_sum_unseq, num_elements) {
+  bm::do_not_optimize(nt::reduce(nt::unseq, tensor, std::plus<>{}, 0.0f));
+}
+
+NT_BENCHMARK(reduce_sum_par, num_elements) { bm::do_not_optimize(nt::reduce(nt::par, tensor, std::plus<>{}, 0.0f)); }
+
+NT_BENCHMARK(reduce_sum_innermost_axis, num_elements) {
+  bm::do_not_optimize(nt::reduce<0u>(tensor, std::plus<>{}, 0.0f));
+}
+
+NT_BENCHMARK(reduce_sum_outermost_axis, num_elements) {
+  bm::do_not_optimize(nt::reduce<1u>(tensor, std::plus<>{}, 0.0f));
+}
@@ -0,0 +1,62 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <reshape.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1000u, 30u> dimensions;
+constexpr nt::Dimensions<30u, 1000u> reshaped_dimensions;
+constexpr std::size_t num_elements = 1000u * 30u;
+
+template <bool aligned_strides>
+auto make_tensor() {
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+      nt::create_plane<nt::DenseBuffer<float>, dimensions, 1u, aligned_strides>());
+  nt::execute([](float& v) { v = 1.0f; }, tensor);
+  return tensor;
+}
+
+// The rows of 30 floats are padded by the aligned strides, so reshape has to copy the elements into a new plane
+auto padded = make_tensor<true>();
+// Without the padding, reshape only changes the layout of the plane
+auto packed = make_tensor<false>();
+
+}  // namespace
+
+NT_BENCHMARK(reshape_copy, num_elements) {
+  auto reshaped = nt::reshape<reshaped_dimensions>(padded);
+  bm::do_not_optimize(reshaped.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(reshape_in_place, num_elements) {
+  auto reshaped = nt::reshape<reshaped_dimensions>(packed);
+  bm::do_not_optimize(reshaped.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(reshape_view, num_elements) {
+  auto reshaped = nt::reshape<reshaped_dimensions, 0u, nt::reshape_mode::view>(padded);
+  bm::do_not_optimize(reshaped.slicing_value(0u, 0u, 0u));
+}
+
+// Reads all elements of the reshaped plane, so the cost of mapping the indexes of the view is included
+NT_BENCHMARK(reshape_copy_and_sum, num_elements) {
+  auto reshaped = nt::reshape<reshaped_dimensions>(padded);
+  float sum = 0.0f;
+  nt::execute([&sum](float v) { sum += v; }, reshaped);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(reshape_view_and_sum, num_elements) {
+  auto reshaped = nt::reshape<reshaped_dimensions, 0u, nt::reshape_mode::view>(padded);
+  float sum = 0.0f;
+  nt::execute([&sum](float v) { sum += v; }, reshaped);
+  bm::do_not_optimize(sum);
+}
@@ -0,0 +1,67 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+#include <utility>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+// The innermost dimension isn't a multiple of the pack width, so each row also has a scalar tail
+constexpr nt::Dimensions<1000u, 256u> dimensions;
+constexpr std::size_t num_elements = 1000u * 256u;
+
+auto first_tensor =
+    nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+auto second_tensor =
+    nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+
+// Short rows, where the head and the tail of each row are a large part of it
+constexpr nt::Dimensions<100u, 40u> short_dimensions;
+constexpr std::size_t num_short_elements = 100u * 40u;
+
+auto first_short_tensor =
+    nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, short_dimensions>());
+auto second_short_tensor =
+    nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, short_dimensions>());
+
+constexpr auto scale = nt::vectorized([](auto& v) { v = v * 0.5f + 1.0f; });
+constexpr auto axpy = nt::vectorized([](auto& lhs, const auto& rhs) { lhs = lhs * 0.5f + rhs; });
+
+}  // namespace
+
+NT_BENCHMARK(execute_scale_seq, num_elements) {
+  nt::execute(nt::seq, scale, first_tensor);
+  bm::do_not_optimize(first_tensor.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(execute_scale_unseq, num_elements) {
+  nt::execute(nt::unseq, scale, first_tensor);
+  bm::do_not_optimize(first_tensor.slicing_value(0u, 0u, 0u));
+}
+
+// The second tensor is only read, so it's passed as a const tensor, whose packs aren't stored
+NT_BENCHMARK(execute_axpy_seq, num_elements) {
+  nt::execute(nt::seq, axpy, first_tensor, std::as_const(second_tensor));
+  bm::do_not_optimize(first_tensor.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(execute_axpy_unseq, num_elements) {
+  nt::execute(nt::unseq, axpy, first_tensor, std::as_const(second_tensor));
+  bm::do_not_optimize(first_tensor.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(execute_short_rows_axpy_seq, num_short_elements) {
+  nt::execute(nt::seq, axpy, first_short_tensor, std::as_const(second_short_tensor));
+  bm::do_not_optimize(first_short_tensor.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(execute_short_rows_axpy_unseq, num_short_elements) {
+  nt::execute(nt::unseq, axpy, first_short_tensor, std::as_const(second_short_tensor));
+  bm::do_not_optimize(first_short_tensor.slicing_value(0u, 0u, 0u));
+}
@@ -0,0 +1,89 @@
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sparse_buffer.hpp>
+#include <sparse_containers.hpp>
+#include <sparse_execute.hpp>
+#include <tensor.hpp>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<1000u, 1024u> dimensions;
+constexpr std::size_t num_elements = 1000u * 1024u;
+
+// 1% of the elements are stored
+template <typename Container>
+auto make_tensor() {
+  auto tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::SparseBuffer<float, Container>, dimensions>());
+  for (unsigned j = 0u; j < 1024u; ++j) {
+    for (unsigned i = j % 100u; i < 1000u; i += 100u) {
+      tensor.slicing_value(0u, i, j) = 1.0f;
+    }
+  }
+  return tensor;
+}
+
+auto hashed = make_tensor<std::unordered_map<std::size_t, float>>();
+auto coo = make_tensor<nt::CooContainer<float>>();
+
+// Sorted coordinate list used by the ingestion benchmarks
+constexpr std::size_t num_ingested = 10000u;
+const auto ingested_indices = [] {
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0u; i < num_ingested; ++i) {
+    indices.push_back(i * 97u);
+  }
+  return indices;
+}();
+const std::vector<float> ingested_values(num_ingested, 1.0f);
+
+template <typename Container>
+void ingest_elementwise() {
+  nt::SparseBuffer<float, Container> buffer{num_elements};
+  for (std::size_t i = 0u; i < num_ingested; ++i) {
+    buffer[ingested_indices[i]] = ingested_values[i];
+  }
+  bm::do_not_optimize(buffer.nonzeros());
+}
+
+}  // namespace
+
+NT_BENCHMARK(sparse_execute_all_indices_hashed, num_elements) {
+  float sum = 0.0f;
+  nt::execute([&sum](const auto& v) { sum += v; }, hashed);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(sparse_execute_stored_hashed, num_elements) {
+  float sum = 0.0f;
+  nt::execute_sparse([&sum](const float& v) { sum += v; }, hashed);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(sparse_execute_all_indices_coo, num_elements) {
+  float sum = 0.0f;
+  nt::execute([&sum](const auto& v) { sum += v; }, coo);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(sparse_execute_stored_coo, num_elements) {
+  float sum = 0.0f;
+  nt::execute_sparse([&sum](const float& v) { sum += v; }, coo);
+  bm::do_not_optimize(sum);
+}
+
+NT_BENCHMARK(sparse_ingest_elementwise_coo, num_ingested) { ingest_elementwise<nt::CooContainer<float>>(); }
+
+NT_BENCHMARK(sparse_ingest_elementwise_csr, num_ingested) { ingest_elementwise<nt::CsrContainer<float, 1024u>>(); }
+
+NT_BENCHMARK(sparse_ingest_insert_range_coo, num_ingested) {
+  nt::SparseBuffer<float, nt::CooContainer<float>> buffer{num_elements};
+  buffer.insert_range(ingested_indices, ingested_values);
+  bm::do_not_optimize(buffer.nonzeros());
+}
@@ -0,0 +1,62 @@
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sstream>
+#include <stream_io.hpp>
+#include <string>
+#include <tensor.hpp>
+
+#include "benchmark.hpp"
+
+namespace nt = ntensor;
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+constexpr nt::Dimensions<256u, 256u> dimensions;
+constexpr std::size_t num_elements = 256u * 256u;
+
+auto make_tensor() {
+  return nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>());
+}
+
+auto tensor = [] {
+  auto tensor = make_tensor();
+  int value = 0;
+  nt::execute([&value](int& v) { v = value++ % 100000; }, tensor);
+  return tensor;
+}();
+
+const std::string text = [] {
+  std::stringstream ss;
+  nt::write_to_sink(tensor, ss);
+  return ss.str();
+}();
+
+auto loaded = make_tensor();
+
+}  // namespace
+
+// Items are the elements of all channels
+NT_BENCHMARK(stream_io_write_text, 3u * num_elements) {
+  std::stringstream ss;
+  nt::write_to_sink(tensor, ss);
+  bm::do_not_optimize(ss.view().size());
+}
+
+NT_BENCHMARK(stream_io_load_text, 3u * num_elements) {
+  nt::load_from_source(loaded, text);
+  bm::do_not_optimize(loaded.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(stream_io_load_text_streamed, 3u * num_elements) {
+  std::stringstream ss{text};
+  nt::load_from_stream(loaded, ss);
+  bm::do_not_optimize(loaded.slicing_value(0u, 0u, 0u));
+}
+
+NT_BENCHMARK(stream_io_load_text_parallel, 3u * num_elements) {
+  nt::load_from_source(nt::par, loaded, text);
+  bm::do_not_optimize(loaded.slicing_value(0u, 0u, 0u));
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ntensor::benchmark {
+
+/*
+ * Prevents the compiler from optimizing away the computation of a value
+ * Parameters:
+ * @param value: value whose computation has to be preserved
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__clang__) || defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+/*
+ * A registered benchmark
+ * items_per_run is the number of elements processed by a single run, and it's used for computing the throughput
+ */
+struct benchmark {
+  std::string name;
+  std::size_t items_per_run;
+  std::function<void()> run;
+};
+
+/*
+ * Result of measuring a benchmark
+ */
+struct measurement {
+  double ns_per_run;
+  std::size_t runs;
+};
+
+/*
+ * Returns all registered benchmarks
+ */
+[[nodiscard]] inline std::vector<benchmark>& registry() {
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+/*
+ * Registers a benchmark during static initialization
+ */
+struct registrar {
+  registrar(std::string name, std::size_t items_per_run, std::function<void()> run) {
+    registry().push_back({std::move(name), items_per_run, std::move(run)});
+  }
+};
+
+/*
+ * Measures the time needed for a single run of the invocable
+ * The invocable is executed in batches whose size is doubled until a batch takes at least min_batch_time. The fastest
+ * of several such batches is reported, which filters out most of the noise caused by other processes
+ * Parameters:
+ * @param run: invocable that's measured
+ * @param min_batch_time: minimum duration of a batch
+ * @param num_batches: number of measured batches
+ * @return: duration of a single run, and the total number of runs
+ */
+[[nodiscard]] inline measurement measure(const std::function<void()>& run,
+                                         std::chrono::nanoseconds min_batch_time = std::chrono::milliseconds{50},
+                                         std::size_t num_batches = 5u) {
+  using clock = std::chrono::steady_clock;
+
+  // Warm up the caches and the allocators
+  run();
+
+  std::size_t batch_size = 1u;
+  std::size_t total_runs = 1u;
+  double best = 0.0;
+
+  for (std::size_t batch = 0u; batch < num_batches;) {
+    const auto start = clock::now();
+    for (std::size_t i = 0u; i < batch_size; ++i) {
+      run();
+    }
+    const auto elapsed = clock::now() - start;
+    total_runs += batch_size;
+
+    if (elapsed < min_batch_time) {
+      batch_size *= 2u;
+      continue;
+    }
+
+    const double ns_per_run = std::chrono::duration<double, std::nano>(elapsed).count() / batch_size;
+    best = batch == 0u ? ns_per_run : std::min(best, ns_per_run);
+    ++batch;
+  }
+
+  return {best, total_runs};
+}
+
+}  // namespace ntensor::benchmark
+
+#define NT_BENCHMARK_CONCAT_DETAIL(x, y) x##y
+#define NT_BENCHMARK_CONCAT(x, y) NT_BENCHMARK_CONCAT_DETAIL(x, y)
+
+/*
+ * Defines and registers a benchmark
+ * Parameters:
+ * @param name: unique name of the benchmark
+ * @param items_per_run: number of elements processed by a single run
+ */
+#define NT_BENCHMARK(name, items_per_run)                                                                      \
+  static void name();                                                                                          \
+  static const ntensor::benchmark::registrar NT_BENCHMARK_CONCAT(name, _registrar){#name, items_per_run, name}; \
+  static void name()
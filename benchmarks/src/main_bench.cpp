@@ -0,0 +1,155 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace bm = ntensor::benchmark;
+
+namespace {
+
+/*
+ * Command line options
+ * filter: only the benchmarks whose name contains the filter are run
+ * json: whether the results are written as JSON instead of a table
+ * json_path: file to which the JSON results are written. If empty, the results are written to the standard output
+ * min_batch_time: minimum duration of a measured batch
+ */
+struct options {
+  std::string_view filter;
+  bool json{false};
+  std::string_view json_path;
+  std::chrono::nanoseconds min_batch_time{std::chrono::milliseconds{50}};
+};
+
+[[noreturn]] void print_usage_and_exit(const char* program) {
+  std::fprintf(stderr, "usage: %s [filter] [--json[=path]] [--min-time=milliseconds]\n", program);
+  std::exit(EXIT_FAILURE);
+}
+
+[[nodiscard]] options parse_options(int argc, char** argv) {
+  options parsed;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+
+    if (argument == "--json") {
+      parsed.json = true;
+    } else if (argument.starts_with("--json=")) {
+      parsed.json = true;
+      parsed.json_path = argument.substr(7u);
+    } else if (argument.starts_with("--min-time=")) {
+      const long milliseconds = std::strtol(argument.substr(11u).data(), nullptr, 10);
+      if (milliseconds <= 0) print_usage_and_exit(argv[0]);
+      parsed.min_batch_time = std::chrono::milliseconds{milliseconds};
+    } else if (argument.starts_with("--") || !parsed.filter.empty()) {
+      print_usage_and_exit(argv[0]);
+    } else {
+      parsed.filter = argument;
+    }
+  }
+
+  return parsed;
+}
+
+/*
+ * Result of a single benchmark
+ */
+struct result {
+  const bm::benchmark* benchmark;
+  bm::measurement measurement;
+
+  [[nodiscard]] double ns_per_item() const {
+    return measurement.ns_per_run / static_cast<double>(benchmark->items_per_run);
+  }
+};
+
+/*
+ * Writes the results as a JSON document, so they can be stored and compared between builds
+ */
+void write_json(std::FILE* file, const std::vector<result>& results, const options& parsed) {
+  std::fprintf(file, "{\n  \"context\": {\n");
+#if defined(__clang__)
+  std::fprintf(file, "    \"compiler\": \"clang %d.%d\",\n", __clang_major__, __clang_minor__);
+#elif defined(__GNUC__)
+  std::fprintf(file, "    \"compiler\": \"gcc %d.%d\",\n", __GNUC__, __GNUC_MINOR__);
+#elif defined(_MSC_VER)
+  std::fprintf(file, "    \"compiler\": \"msvc %d\",\n", _MSC_VER);
+#else
+  std::fprintf(file, "    \"compiler\": \"unknown\",\n");
+#endif
+#ifdef ENABLE_NT_EXPECTS
+  std::fprintf(file, "    \"expects\": true,\n");
+#else
+  std::fprintf(file, "    \"expects\": false,\n");
+#endif
+  std::fprintf(file, "    \"alignment\": %d,\n", NT_ALIGNMENT);
+#ifdef NT_SIMD_WIDTH
+  std::fprintf(file, "    \"simd_width\": %d,\n", NT_SIMD_WIDTH);
+#endif
+  std::fprintf(file, "    \"min_batch_time_ns\": %lld\n  },\n  \"benchmarks\": [",
+               static_cast<long long>(parsed.min_batch_time.count()));
+
+  // Benchmark names are C++ identifiers, so they never need to be escaped
+  for (std::size_t i = 0u; i < results.size(); ++i) {
+    const auto& [benchmark, measurement] = results[i];
+    std::fprintf(file,
+                 "%s\n    {\"name\": \"%s\", \"items_per_run\": %zu, \"runs\": %zu, \"ns_per_run\": %.3f, "
+                 "\"ns_per_item\": %.6f, \"items_per_second\": %.1f}",
+                 i ? "," : "", benchmark->name.c_str(), benchmark->items_per_run, measurement.runs,
+                 measurement.ns_per_run, results[i].ns_per_item(), 1e9 / results[i].ns_per_item());
+  }
+
+  std::fprintf(file, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+/*
+ * Runs all registered benchmarks whose name contains the filter passed as the first argument (if any)
+ * The results are printed as a table, or written as JSON if the --json option is given
+ */
+int main(int argc, char** argv) {
+  const options parsed = parse_options(argc, argv);
+  // The table is still printed while writing the JSON results to a file, so the progress remains visible
+  const bool print_table = !parsed.json || !parsed.json_path.empty();
+
+  if (print_table) {
+    std::printf("%-48s %16s %14s %14s\n", "benchmark", "ns/run", "ns/item", "Mitems/s");
+  }
+
+  std::vector<result> results;
+
+  for (const auto& benchmark : bm::registry()) {
+    if (!parsed.filter.empty() && benchmark.name.find(parsed.filter) == std::string::npos) {
+      continue;
+    }
+
+    const auto& current = results.emplace_back(&benchmark, bm::measure(benchmark.run, parsed.min_batch_time));
+
+    if (print_table) {
+      std::printf("%-48s %16.1f %14.3f %14.2f\n", benchmark.name.c_str(), current.measurement.ns_per_run,
+                  current.ns_per_item(), 1e3 / current.ns_per_item());
+      std::fflush(stdout);
+    }
+  }
+
+  if (parsed.json) {
+    if (parsed.json_path.empty()) {
+      write_json(stdout, results, parsed);
+    } else {
+      std::FILE* file = std::fopen(std::string{parsed.json_path}.c_str(), "w");
+      if (!file) {
+        std::fprintf(stderr, "unable to open %s\n", std::string{parsed.json_path}.c_str());
+        return EXIT_FAILURE;
+      }
+      write_json(file, results, parsed);
+      std::fclose(file);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
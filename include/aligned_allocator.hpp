@@ -20,9 +20,9 @@ namespace ntensor {
  * using the Linear allocator or the Free-List allocator. So each time a new allocation is requested, the Slab allocator
  * would first check if any of its slabs has enough unused memory that can be used, instead of performing a new
  * allocation. And only if it fails would it allocate a new slab with the requested size. So it would be a hybrid
- * allocator that has both properties of a Slab allocator and a Linear allocator/Free-List allocator. However,
- * implementing those allocators, assuring that they work, and writing STL adapters for those would take too much time
- * at this moment. So I left them out for a future release instead.
+ * allocator that has both properties of a Slab allocator and a Linear allocator/Free-List allocator.
+ * The Linear and the Free-List allocators, together with their STL adapters, are found in arena_allocator.hpp, and the
+ * Slab allocator is found in slab_allocator.hpp.
  *
  * Parameters:
  * @tparam T: memory type that needs to be allocated
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+
+#if defined ENABLE_NT_EXPECTS || defined ENABLE_NT_ENSURES
+#include "assert.hpp"
+#endif
+
+namespace ntensor {
+
+/*
+ * Rounds a number of bytes up to a multiple of NT_ALIGNMENT, so that consecutive allocations stay aligned
+ */
+[[nodiscard]] constexpr std::size_t align_allocation_size(std::size_t bytes) noexcept {
+  return (std::max<std::size_t>(bytes, 1u) + NT_ALIGNMENT - 1u) / NT_ALIGNMENT * NT_ALIGNMENT;
+}
+
+/*
+ * Linear (bump) arena
+ * Memory is handed out by advancing a pointer inside large blocks, so an allocation costs a comparison and an addition.
+ * Single allocations aren't freed (except the most recent one); instead, all of the memory is reclaimed at once by
+ * calling reset, while the blocks are kept for the next round of allocations. This makes it a good fit for temporaries
+ * that all die at the same point, for example the planes created while processing a single request
+ * The arena isn't thread-safe, and it has to outlive all of the buffers allocated from it
+ * Parameters:
+ * @tparam BaseAllocator: allocator used for allocating the blocks
+ */
+template <typename BaseAllocator = AlignedMallocAllocator<std::byte>>
+class LinearArena {
+ private:
+  struct block {
+    std::byte* memory;
+    std::size_t size;
+  };
+
+  BaseAllocator _base{};
+  std::vector<block> _blocks;
+  std::size_t _block_size;
+  std::size_t _current{};
+  std::size_t _used{};
+  std::size_t _live{};
+
+ public:
+  /*
+   * Creates an empty arena. Blocks are allocated on demand
+   * Parameters:
+   * @param block_size: minimum size of the allocated blocks in bytes
+   */
+  explicit LinearArena(std::size_t block_size = 1u << 20u) : _block_size{align_allocation_size(block_size)} {}
+
+  LinearArena(const LinearArena&) = delete;
+  LinearArena& operator=(const LinearArena&) = delete;
+
+  /*
+   * Releases all blocks
+   * Constraints:
+   * All of the memory allocated from the arena has to be deallocated
+   */
+  ~LinearArena() {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(!_live);
+#endif
+    for (const auto& [memory, size] : _blocks) {
+      _base.deallocate(memory, size);
+    }
+  }
+
+  /*
+   * Allocates the given number of bytes. The returned memory is aligned to NT_ALIGNMENT
+   */
+  [[nodiscard]] void* allocate(std::size_t bytes) {
+    bytes = align_allocation_size(bytes);
+    ++_live;
+
+    for (; _current < _blocks.size(); ++_current, _used = 0u) {
+      if (_blocks[_current].size - _used >= bytes) {
+        void* memory = _blocks[_current].memory + _used;
+        _used += bytes;
+        return memory;
+      }
+    }
+
+    const std::size_t size = std::max(_block_size, bytes);
+    _blocks.push_back({_base.allocate(size), size});
+    _current = _blocks.size() - 1u;
+    _used = bytes;
+    return _blocks.back().memory;
+  }
+
+  /*
+   * Deallocates memory. Only the most recent allocation is actually reclaimed; the rest of the memory is reclaimed by
+   * the reset method
+   */
+  void deallocate(void* memory, std::size_t bytes) noexcept {
+    bytes = align_allocation_size(bytes);
+    --_live;
+
+    if (_current < _blocks.size() && _used >= bytes &&
+        static_cast<std::byte*>(memory) + bytes == _blocks[_current].memory + _used) {
+      _used -= bytes;
+    }
+  }
+
+  /*
+   * Reclaims all of the memory at once, keeping the blocks for future allocations
+   * Constraints:
+   * All of the memory allocated from the arena has to be deallocated
+   */
+  void reset() noexcept {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(!_live);
+#endif
+    _current = 0u;
+    _used = 0u;
+  }
+
+  /*
+   * Returns the total size of the allocated blocks in bytes
+   */
+  [[nodiscard]] std::size_t capacity() const noexcept {
+    std::size_t capacity = 0u;
+    for (const auto& b : _blocks) {
+      capacity += b.size;
+    }
+    return capacity;
+  }
+};
+
+/*
+ * Free-list arena
+ * Allocation sizes are rounded up to a power of two (and at least NT_ALIGNMENT bytes), and each size class has its own
+ * list of freed blocks. Deallocated blocks are pushed onto their list and handed out again by the next allocation of
+ * the same class, so a steady state of allocations and deallocations never reaches the base allocator
+ * Rounding up wastes up to half of each block, which is acceptable for temporaries that are repeatedly created with the
+ * same sizes
+ * The arena isn't thread-safe, and it has to outlive all of the buffers allocated from it
+ * Parameters:
+ * @tparam BaseAllocator: allocator used for allocating the blocks
+ */
+template <typename BaseAllocator = AlignedMallocAllocator<std::byte>>
+class FreeListArena {
+ private:
+  struct node {
+    node* next;
+  };
+
+  static constexpr std::size_t num_classes = 64u;
+
+  BaseAllocator _base{};
+  std::array<node*, num_classes> _free_lists{};
+  std::size_t _live{};
+
+  /*
+   * Returns the size class of an allocation. The size of the class is 2^class
+   */
+  [[nodiscard]] static std::size_t size_class(std::size_t bytes) noexcept {
+    return static_cast<std::size_t>(std::bit_width(std::bit_ceil(align_allocation_size(bytes))) - 1);
+  }
+
+ public:
+  /*
+   * Creates an empty arena
+   */
+  FreeListArena() noexcept = default;
+
+  FreeListArena(const FreeListArena&) = delete;
+  FreeListArena& operator=(const FreeListArena&) = delete;
+
+  /*
+   * Returns all free blocks to the base allocator
+   * Constraints:
+   * All of the memory allocated from the arena has to be deallocated
+   */
+  ~FreeListArena() {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(!_live);
+#endif
+    trim();
+  }
+
+  /*
+   * Allocates the given number of bytes. The returned memory is aligned to NT_ALIGNMENT
+   */
+  [[nodiscard]] void* allocate(std::size_t bytes) {
+    const std::size_t cls = size_class(bytes);
+    ++_live;
+
+    if (node* head = _free_lists[cls]) {
+      _free_lists[cls] = head->next;
+      return head;
+    }
+
+    return _base.allocate(std::size_t{1u} << cls);
+  }
+
+  /*
+   * Deallocates memory by pushing it onto the free list of its size class
+   */
+  void deallocate(void* memory, std::size_t bytes) noexcept {
+    const std::size_t cls = size_class(bytes);
+    --_live;
+    _free_lists[cls] = ::new (memory) node{_free_lists[cls]};
+  }
+
+  /*
+   * Returns all free blocks to the base allocator
+   */
+  void trim() noexcept {
+    for (std::size_t cls = 0u; cls < num_classes; ++cls) {
+      while (node* head = _free_lists[cls]) {
+        _free_lists[cls] = head->next;
+        _base.deallocate(reinterpret_cast<std::byte*>(head), std::size_t{1u} << cls);
+      }
+    }
+  }
+};
+
+/*
+ * Makes an arena the current arena of the calling thread for the lifetime of the scope
+ * Arena allocators that are default-constructed (for example by the DenseBuffer) use the current arena, so all of the
+ * buffers created inside the scope are allocated from it. Scopes can be nested; the previous arena is restored when the
+ * scope ends
+ * Parameters:
+ * @tparam Arena: type of the arena
+ */
+template <typename Arena>
+class ArenaScope {
+ private:
+  inline static thread_local Arena* _current{nullptr};
+  Arena* _previous;
+
+ public:
+  /*
+   * Makes the arena the current arena of the calling thread
+   */
+  explicit ArenaScope(Arena& arena) noexcept : _previous{std::exchange(_current, &arena)} {}
+
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  /*
+   * Restores the previous arena
+   */
+  ~ArenaScope() { _current = _previous; }
+
+  /*
+   * Returns the current arena of the calling thread, or nullptr if there's no active scope
+   */
+  [[nodiscard]] static Arena* current() noexcept { return _current; }
+};
+
+/*
+ * Allocator handing out the memory of an arena
+ * The allocator only holds a pointer to the arena, so it's cheap to copy, and it can be used with the DenseBuffer and
+ * the standard containers. A default-constructed allocator uses the current arena of the calling thread (see
+ * ArenaScope). If there's no current arena, the allocator falls back to the AlignedMallocAllocator
+ * Parameters:
+ * @tparam T: memory type that needs to be allocated
+ * @tparam Arena: type of the arena
+ */
+template <typename T, typename Arena>
+class ArenaAllocator {
+ private:
+  Arena* _arena;
+
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = ArenaAllocator<U, Arena>;
+  };
+
+  /*
+   * Creates an allocator using the current arena of the calling thread
+   */
+  ArenaAllocator() noexcept : _arena{ArenaScope<Arena>::current()} {}
+
+  /*
+   * Creates an allocator using the given arena
+   */
+  explicit ArenaAllocator(Arena& arena) noexcept : _arena{&arena} {}
+
+  /*
+   * Construct the allocator using a allocator with a different type. Both allocators use the same arena
+   */
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U, Arena>& other) noexcept : _arena{other.arena()} {}
+
+  /*
+   * Allocates n * sizeof(T) bytes of uninitialized storage
+   * Parameters:
+   * @param n: the number of objects to allocate storage for
+   */
+  [[nodiscard]] value_type* allocate(std::size_t n) {
+    if (!_arena) {
+      return AlignedMallocAllocator<T>{}.allocate(n);
+    }
+    return static_cast<value_type*>(_arena->allocate(n * sizeof(value_type)));
+  }
+
+  /*
+   * Deallocates the storage referenced by the pointer p
+   * Parameters:
+   * @param p: pointer pointing to the allocated memory
+   * @param n: the number of objects that the storage was allocated for
+   */
+  void deallocate(value_type* p, std::size_t n) noexcept {
+    if (!_arena) {
+      AlignedMallocAllocator<T>{}.deallocate(p, n);
+    } else if (p) {
+      _arena->deallocate(p, n * sizeof(value_type));
+    }
+  }
+
+  /*
+   * Returns the arena used by the allocator, or nullptr if the allocator falls back to the AlignedMallocAllocator
+   */
+  [[nodiscard]] Arena* arena() const noexcept { return _arena; }
+
+  /*
+   * Compares two allocators. Allocators are equal if they use the same arena
+   */
+  template <typename U>
+  [[nodiscard]] friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U, Arena>& rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+  }
+};
+
+template <typename T>
+using LinearAllocator = ArenaAllocator<T, LinearArena<>>;
+
+template <typename T>
+using FreeListAllocator = ArenaAllocator<T, FreeListArena<>>;
+
+}  // namespace ntensor
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "execute.hpp"
+#include "execution_policy.hpp"
+#include "thread_pool.hpp"
+
+namespace ntensor {
+
+/*
+ * Concept satisfied by the executors on which the asynchronous operations are scheduled
+ * An executor only has to accept tasks through a submit method, and run each of them eventually, on any thread. The
+ * ThreadPool is an executor
+ */
+template <typename T>
+concept executor = requires(T& executor, std::function<void()> task) { executor.submit(std::move(task)); };
+
+/*
+ * Calls an invocable asynchronously on an executor
+ * The invocable and the arguments are copied (or moved) into the task, so tensors passed as arguments keep their
+ * buffers alive until the task completes
+ * Parameters:
+ * @param executor: executor on which the invocable is called
+ * @param invocable: invocable that's called
+ * @param args: arguments passed to the invocable
+ * @return: future holding the result of the invocable, or the exception it threw
+ */
+template <executor Executor, typename Invocable, typename... Args>
+[[nodiscard]] auto async(Executor& executor, Invocable&& invocable, Args&&... args) {
+  using result_type = std::invoke_result_t<std::decay_t<Invocable>, std::decay_t<Args>...>;
+
+  // std::function requires a copyable task, while the packaged_task can only be moved
+  auto task = std::make_shared<std::packaged_task<result_type()>>(
+      [invocable = std::forward<Invocable>(invocable), ... args = std::forward<Args>(args)]() mutable -> result_type {
+        return std::invoke(std::move(invocable), std::move(args)...);
+      });
+  auto future = task->get_future();
+  executor.submit([task] { (*task)(); });
+  return future;
+}
+
+/*
+ * Calls an invocable on each element of one or more tensors asynchronously, using the specified execution policy
+ * See the execute method for details. The tensors are copied into the task, which shares their buffers
+ * Parameters:
+ * @param executor: executor on which the execute method is called
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param invocable: Invocable called on each element of a tensor/s
+ * @param tensors: Variadic number of tensors
+ * @return: future which becomes ready once all elements are processed
+ */
+template <executor Executor, execution_policy Policy, typename Invocable, typename... Tensors>
+[[nodiscard]] std::future<void> async_execute(Executor& executor, Policy&& policy, Invocable&& invocable,
+                                              Tensors&&... tensors) {
+  return async(
+      executor,
+      [](auto&& policy, auto&& invocable, auto&&... tensors) { execute(policy, invocable, tensors...); },
+      std::forward<Policy>(policy), std::forward<Invocable>(invocable), std::forward<Tensors>(tensors)...);
+}
+
+/*
+ * Calls an invocable on each element of one or more tensors asynchronously
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @param executor: executor on which the execute method is called
+ * @param invocable: Invocable called on each element of a tensor/s
+ * @param tensors: Variadic number of tensors
+ * @return: future which becomes ready once all elements are processed
+ */
+template <executor Executor, typename Invocable, typename... Tensors>
+  requires(!execution_policy<Invocable>)
+[[nodiscard]] std::future<void> async_execute(Executor& executor, Invocable&& invocable, Tensors&&... tensors) {
+  return async_execute(executor, seq, std::forward<Invocable>(invocable), std::forward<Tensors>(tensors)...);
+}
+
+/*
+ * Waits for a future, executing the pending tasks of a thread pool in the meantime
+ * Waiting for a future on a worker thread of the pool that computes it would block the worker, and with all workers
+ * blocked, the future would never become ready. Like the parallel algorithms, this method helps the pool instead
+ * Parameters:
+ * @param pool: thread pool on which the future's task is executed
+ * @param future: future that's waited for
+ * @return: result of the future
+ */
+template <typename T>
+decltype(auto) await_future(ThreadPool& pool, std::future<T>& future) {
+  while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+    if (!pool.try_run_pending_task()) {
+      std::this_thread::yield();
+    }
+  }
+  return future.get();
+}
+
+inline namespace internal {
+
+/*
+ * Type of the values produced by a stage of a pipeline
+ * Parameters:
+ * @tparam stage: index of the stage, where the stage 0 is the source
+ * @tparam Source: type of the source
+ * @tparam Stages: types of the remaining stages
+ */
+template <std::size_t stage, typename Source, typename... Stages>
+struct pipeline_value {
+  using type = std::invoke_result_t<std::tuple_element_t<stage - 1u, std::tuple<Stages...>>&,
+                                    typename pipeline_value<stage - 1u, Source, Stages...>::type&&>;
+};
+
+template <typename Source, typename... Stages>
+struct pipeline_value<0u, Source, Stages...> {
+  using type = typename std::invoke_result_t<Source&>::value_type;
+};
+
+template <std::size_t stage, typename Source, typename... Stages>
+using pipeline_value_t = typename pipeline_value<stage, Source, Stages...>::type;
+
+/*
+ * State of a pipeline started by run_pipeline
+ * Each stage processes one value per task, and tasks are only submitted for stages that have an input value and room
+ * for their output value, so no thread ever blocks on a full or an empty queue. At most one task of each stage is
+ * running at any time, so the stages are called in order, and they don't have to be thread-safe. Values of different
+ * stages are processed concurrently, if the executor has several threads
+ * Parameters:
+ * @tparam Source: type of the source, returning an optional value (an empty optional ends the pipeline)
+ * @tparam Stages: types of the remaining stages, where the last stage consumes the values
+ */
+template <typename Source, typename... Stages>
+class pipeline_state : public std::enable_shared_from_this<pipeline_state<Source, Stages...>> {
+ private:
+  static constexpr std::size_t N = sizeof...(Stages) + 1u;
+
+  // Queue i holds the values produced by the stage i
+  using queues_type = decltype([]<std::size_t... is>(std::index_sequence<is...>) {
+    return std::tuple<std::deque<pipeline_value_t<is, Source, Stages...>>...>{};
+  }(std::make_index_sequence<N - 1u>()));
+
+  std::function<void(std::function<void()>)> _submit;
+  std::size_t _capacity;
+  Source _source;
+  std::tuple<Stages...> _stages;
+
+  std::mutex _mutex;
+  queues_type _queues;
+  std::array<bool, N> _running{};
+  std::array<bool, N> _finished{};
+  std::exception_ptr _exception;
+  std::promise<void> _promise;
+  bool _completed{false};
+
+  /*
+   * Checks whether a task of a stage can be submitted. The mutex has to be locked
+   */
+  template <std::size_t stage>
+  [[nodiscard]] bool is_ready() const noexcept {
+    if (_running[stage] || _finished[stage] || _exception) return false;
+    if constexpr (stage > 0u) {
+      if (std::get<stage - 1u>(_queues).empty()) return false;
+    }
+    if constexpr (stage < N - 1u) {
+      if (std::get<stage>(_queues).size() >= _capacity) return false;
+    }
+    return true;
+  }
+
+  /*
+   * Marks the stages that can run as running, and completes the pipeline once the last stage is finished or once a
+   * stage threw and no other stage is running. The mutex has to be locked
+   * @return: stages whose tasks have to be submitted, once the mutex is unlocked
+   */
+  [[nodiscard]] std::array<bool, N> schedule() {
+    std::array<bool, N> ready{};
+    [this, &ready]<std::size_t... is>(std::index_sequence<is...>) {
+      // A stage is finished once the previous stage is finished and all of its values are consumed
+      ((_finished[is] = _finished[is] || (is > 0u && !_running[is] && _finished[is - (is > 0u)] &&
+                                          std::get<is - (is > 0u)>(_queues).empty())),
+       ...);
+      ((ready[is] = is_ready<is>(), _running[is] = _running[is] || ready[is]), ...);
+    }(std::make_index_sequence<N>());
+
+    const bool idle = std::none_of(_running.begin(), _running.end(), [](bool running) { return running; });
+    if (!_completed && (_finished[N - 1u] || (_exception && idle))) {
+      _completed = true;
+      if (_exception) {
+        _promise.set_exception(_exception);
+      } else {
+        _promise.set_value();
+      }
+    }
+    return ready;
+  }
+
+  /*
+   * Submits the tasks of the stages returned by schedule. The mutex mustn't be locked, so that the executor may run
+   * the tasks on the calling thread
+   */
+  void submit(const std::array<bool, N>& ready) {
+    [this, &ready]<std::size_t... is>(std::index_sequence<is...>) {
+      (
+          [this, &ready] {
+            if (ready[is]) _submit([self = this->shared_from_this()] { self->template run<is>(); });
+          }(),
+          ...);
+    }(std::make_index_sequence<N>());
+  }
+
+  /*
+   * Processes a single value by a stage
+   */
+  template <std::size_t stage>
+  void run() {
+    try {
+      if constexpr (stage == 0u) {
+        auto value = _source();
+
+        std::scoped_lock lock{_mutex};
+        if (value) {
+          std::get<0u>(_queues).emplace_back(std::move(*value));
+        } else {
+          _finished[0u] = true;
+        }
+      } else {
+        auto value = [this] {
+          std::scoped_lock lock{_mutex};
+          auto& queue = std::get<stage - 1u>(_queues);
+          auto value = std::move(queue.front());
+          queue.pop_front();
+          return value;
+        }();
+
+        if constexpr (stage < N - 1u) {
+          auto result = std::invoke(std::get<stage - 1u>(_stages), std::move(value));
+
+          std::scoped_lock lock{_mutex};
+          std::get<stage>(_queues).emplace_back(std::move(result));
+        } else {
+          std::invoke(std::get<stage - 1u>(_stages), std::move(value));
+        }
+      }
+    } catch (...) {
+      std::scoped_lock lock{_mutex};
+      if (!_exception) _exception = std::current_exception();
+    }
+
+    const auto ready = [this] {
+      std::scoped_lock lock{_mutex};
+      _running[stage] = false;
+      return schedule();
+    }();
+    submit(ready);
+  }
+
+ public:
+  /*
+   * Creates the state of a pipeline. The pipeline is started by the start method
+   */
+  pipeline_state(std::function<void(std::function<void()>)> submit, std::size_t capacity, Source source,
+                 Stages... stages)
+      : _submit{std::move(submit)},
+        _capacity{std::max<std::size_t>(capacity, 1u)},
+        _source{std::move(source)},
+        _stages{std::move(stages)...} {}
+
+  /*
+   * Submits the first task of the source
+   * @return: future which becomes ready once all values are consumed by the last stage
+   */
+  [[nodiscard]] std::future<void> start() {
+    auto future = _promise.get_future();
+    const auto ready = [this] {
+      std::scoped_lock lock{_mutex};
+      return schedule();
+    }();
+    submit(ready);
+    return future;
+  }
+};
+
+}  // namespace internal
+
+/*
+ * Runs a pipeline of stages asynchronously on an executor
+ * The source produces values until it returns an empty optional, each following stage transforms the values of the
+ * previous stage, and the last stage consumes them. For example, the source can read the text of the next plane, the
+ * second stage can load it into a tensor and compute on it, and the last stage can write the result. While a value is
+ * processed by a stage, the next value is already processed by the previous stage, so reading, computing and writing
+ * overlap (given an executor with several threads)
+ * Between each two stages, at most capacity values are waiting. Once a stage falls behind, the stages before it stop
+ * being scheduled until it catches up, so a fast source never reads ahead more than a few values (back-pressure).
+ * Stages are never blocked while waiting: tasks are only submitted for stages that can make progress, so a pipeline
+ * can run on a thread pool with fewer threads than stages, and alongside the parallel algorithms
+ * Each stage is called by one task at a time, in the order of the values. If a stage throws, no further values are
+ * processed, and the exception is stored in the returned future
+ * Parameters:
+ * @param executor: executor on which the stages are called. It has to outlive the pipeline
+ * @param capacity: maximum number of values waiting between two stages
+ * @param source: invocable returning an std::optional of the next value, or an empty optional once it's exhausted
+ * @param stages: invocables called with the values of the previous stage. The last stage's result is discarded
+ * @return: future which becomes ready once the last stage consumed all values
+ */
+template <executor Executor, typename Source, typename... Stages>
+  requires(sizeof...(Stages) > 0u)
+[[nodiscard]] std::future<void> run_pipeline(Executor& executor, std::size_t capacity, Source source,
+                                             Stages... stages) {
+  auto state = std::make_shared<pipeline_state<Source, Stages...>>(
+      [&executor](std::function<void()> task) { executor.submit(std::move(task)); }, capacity, std::move(source),
+      std::move(stages)...);
+  return state->start();
+}
+
+}  // namespace ntensor
@@ -0,0 +1,640 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "mapped_buffer.hpp"
+#include "plane.hpp"
+#include "tensor.hpp"
+
+namespace ntensor {
+
+/*
+ * Kind of the elements stored in a binary tensor file
+ * Together with the element size, it describes the type of the elements, so that a file can't be loaded into planes
+ * of a different type
+ */
+enum class binary_dtype : std::uint32_t {
+  opaque = 0u,
+  signed_integer = 1u,
+  unsigned_integer = 2u,
+  floating_point = 3u
+};
+
+inline namespace internal {
+
+/*
+ * Binary tensor file layout (all values are stored in the native byte order):
+ * 1) file header (binary_file_header)
+ * 2) one descriptor per plane (binary_plane_descriptor), each followed by rank dimensions (uint64) and rank strides
+ * (int64), innermost first
+ * 3) one payload per plane, starting at an offset aligned to the alignment stored in the file header
+ * Each payload stores the elements of a plane laid out with the aligned strides of its dimensions (the same layout that
+ * create_plane allocates), including the channels and the padding, so a payload can be used as a plane's buffer without
+ * any conversion
+ */
+inline constexpr std::array<char, 8u> binary_magic{'N', 'T', 'E', 'N', 'S', 'O', 'R', 'B'};
+inline constexpr std::uint32_t binary_version = 1u;
+inline constexpr std::uint32_t binary_byte_order_mark = 0x01020304u;
+inline constexpr std::size_t binary_alignment = NT_ALIGNMENT;
+
+/*
+ * Header found at the beginning of a binary tensor file
+ */
+struct binary_file_header {
+  std::array<char, 8u> magic{binary_magic};
+  std::uint32_t version{binary_version};
+  std::uint32_t byte_order{binary_byte_order_mark};
+  std::uint32_t alignment{binary_alignment};
+  std::uint32_t num_planes{};
+  std::uint64_t reserved{};
+};
+
+/*
+ * Description of a single plane stored in a binary tensor file
+ */
+struct binary_plane_descriptor {
+  binary_dtype dtype{};
+  std::uint32_t element_size{};
+  std::uint32_t rank{};
+  std::uint32_t channels{};
+  std::uint64_t payload_offset{};
+  std::uint64_t payload_size{};
+};
+
+static_assert(sizeof(binary_file_header) == 32u && std::is_trivially_copyable_v<binary_file_header>);
+static_assert(sizeof(binary_plane_descriptor) == 32u && std::is_trivially_copyable_v<binary_plane_descriptor>);
+
+/*
+ * Plane descriptor together with the plane's dimensions and strides
+ */
+struct binary_plane_record {
+  binary_plane_descriptor descriptor{};
+  std::vector<std::uint64_t> dimensions;
+  std::vector<std::int64_t> strides;
+};
+
+/*
+ * Throws an exception describing a malformed or incompatible binary tensor file, or a failed write of one
+ */
+[[noreturn]] inline void binary_format_error(const char* message) {
+  throw std::runtime_error(std::string{"ntensor binary format: "} + message);
+}
+
+/*
+ * Rounds the offset up to the alignment of the payloads
+ */
+[[nodiscard]] constexpr std::uint64_t align_binary_offset(std::uint64_t offset) noexcept {
+  return (offset + binary_alignment - 1u) / binary_alignment * binary_alignment;
+}
+
+/*
+ * Returns the kind of the elements of type T
+ */
+template <typename T>
+[[nodiscard]] consteval binary_dtype binary_dtype_of() noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    return binary_dtype::floating_point;
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    return binary_dtype::signed_integer;
+  } else if constexpr (std::is_integral_v<T>) {
+    return binary_dtype::unsigned_integer;
+  } else {
+    return binary_dtype::opaque;
+  }
+}
+
+/*
+ * Strides used to lay out the payload of a plane
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval auto payload_strides() noexcept {
+  return compute_aligned_strides<typename Plane::value_type>(Plane::dimensions());
+}
+
+/*
+ * Number of elements stored in the payload of a plane
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval std::size_t payload_elements() noexcept {
+  return static_cast<std::size_t>(max_product(Plane::dimensions(), payload_strides<Plane>())) * Plane::channels();
+}
+
+/*
+ * Checks whether the plane's elements are already laid out like its payload, so the payload can be copied to/from the
+ * plane's memory in a single operation
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval bool has_payload_layout() noexcept {
+  return contiguous_buffer<typename Plane::buffer_type> &&
+         std::is_same_v<decltype(Plane::strides()), decltype(payload_strides<Plane>())>;
+}
+
+/*
+ * Creates the record describing a plane of the given type. The payload offset isn't set
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] binary_plane_record make_binary_plane_record() {
+  using value_type = typename Plane::value_type;
+  static_assert(std::is_trivially_copyable_v<value_type>,
+                "Only planes with trivially copyable elements can be stored in the binary format");
+
+  static constexpr std::size_t rank = Plane::rank();
+  static constexpr auto strides = payload_strides<Plane>();
+
+  binary_plane_record record{};
+  record.descriptor.dtype = binary_dtype_of<value_type>();
+  record.descriptor.element_size = sizeof(value_type);
+  record.descriptor.rank = rank;
+  record.descriptor.channels = Plane::channels();
+  record.descriptor.payload_size = payload_elements<Plane>() * sizeof(value_type);
+
+  [&record]<std::size_t... is>(std::index_sequence<is...>) {
+    record.dimensions = {static_cast<std::uint64_t>(Plane::dimensions().template at<is>())...};
+    record.strides = {static_cast<std::int64_t>(strides.template at<is>())...};
+  }(std::make_index_sequence<rank>());
+
+  return record;
+}
+
+/*
+ * Checks whether the record read from a file describes a plane of the given type
+ * Parameters:
+ * @tparam Plane: type of the plane into which the payload is loaded
+ * @param record: record read from a file
+ * Exceptions:
+ * std::runtime_error if the plane types don't match
+ */
+template <typename Plane>
+void validate_binary_plane_record(const binary_plane_record& record) {
+  const auto expected = make_binary_plane_record<Plane>();
+
+  if (record.descriptor.dtype != expected.descriptor.dtype ||
+      record.descriptor.element_size != expected.descriptor.element_size) {
+    binary_format_error("element type mismatch");
+  }
+
+  if (record.dimensions != expected.dimensions || record.descriptor.channels != expected.descriptor.channels) {
+    binary_format_error("dimensions or channels mismatch");
+  }
+
+  if (record.strides != expected.strides || record.descriptor.payload_size != expected.descriptor.payload_size) {
+    binary_format_error("payload layout mismatch");
+  }
+}
+
+/*
+ * Reads the file header and the plane records
+ * The number of planes and the ranks are checked before any memory is allocated for the records, so a corrupt file
+ * can't request huge allocations
+ * Parameters:
+ * @param read: invocable reading the given number of bytes into the given memory, returning false on failure
+ * @param num_planes: number of planes of the tensor into which the file is loaded
+ * @param max_rank: largest rank of the planes of the tensor into which the file is loaded
+ * @return: plane records
+ * Exceptions:
+ * std::runtime_error if the data isn't a binary tensor file written by this version of the library, or if it has a
+ * different number of planes or a larger rank than the tensor
+ */
+template <typename Read>
+[[nodiscard]] std::vector<binary_plane_record> read_binary_records(Read&& read, std::size_t num_planes,
+                                                                   std::size_t max_rank) {
+  binary_file_header header{};
+
+  if (!read(&header, sizeof(header)) || header.magic != binary_magic) {
+    binary_format_error("not a binary tensor file");
+  }
+
+  if (header.version != binary_version) {
+    binary_format_error("unsupported version");
+  }
+
+  if (header.byte_order != binary_byte_order_mark) {
+    binary_format_error("byte order mismatch");
+  }
+
+  if (header.alignment != binary_alignment) {
+    binary_format_error("alignment mismatch");
+  }
+
+  if (header.num_planes != num_planes) {
+    binary_format_error("number of planes mismatch");
+  }
+
+  std::vector<binary_plane_record> records(header.num_planes);
+
+  for (auto& record : records) {
+    if (!read(&record.descriptor, sizeof(record.descriptor))) {
+      binary_format_error("truncated plane descriptor");
+    }
+
+    if (record.descriptor.rank > max_rank) {
+      binary_format_error("dimensions or channels mismatch");
+    }
+
+    record.dimensions.resize(record.descriptor.rank);
+    record.strides.resize(record.descriptor.rank);
+
+    if (!read(record.dimensions.data(), record.dimensions.size() * sizeof(std::uint64_t)) ||
+        !read(record.strides.data(), record.strides.size() * sizeof(std::int64_t))) {
+      binary_format_error("truncated plane descriptor");
+    }
+
+    if (record.descriptor.payload_offset % binary_alignment) {
+      binary_format_error("misaligned payload");
+    }
+  }
+
+  return records;
+}
+
+/*
+ * Writes the elements of a plane to a stream in the payload layout, using a small staging buffer
+ * Padding elements are written as value-initialized elements
+ * Parameters:
+ * @tparam T: type of the written elements
+ */
+template <typename T>
+class PayloadWriter {
+ private:
+  static constexpr std::size_t staging_size = (1u << 16u) / sizeof(T) + 1u;
+
+  std::ostream& _sink;
+  std::vector<T> _staging;
+  std::size_t _position{};
+
+  void flush() {
+    _sink.write(reinterpret_cast<const char*>(_staging.data()),
+                static_cast<std::streamsize>(_staging.size() * sizeof(T)));
+    _staging.clear();
+  }
+
+  void push(const T& value) {
+    _staging.push_back(value);
+    ++_position;
+
+    if (_staging.size() == staging_size) [[unlikely]] {
+      flush();
+    }
+  }
+
+ public:
+  explicit PayloadWriter(std::ostream& sink) : _sink{sink} { _staging.reserve(staging_size); }
+
+  /*
+   * Writes an element at the given payload position. Positions have to be increasing
+   */
+  void put(std::size_t position, const T& value) {
+    while (_position < position) {
+      push(T{});
+    }
+    push(value);
+  }
+
+  /*
+   * Pads the payload to the given number of elements, and writes the staged elements
+   */
+  void finish(std::size_t size) {
+    while (_position < size) {
+      push(T{});
+    }
+    flush();
+  }
+};
+
+/*
+ * Reads the elements of a plane from a stream in the payload layout, using a small staging buffer
+ * Parameters:
+ * @tparam T: type of the read elements
+ */
+template <typename T>
+class PayloadReader {
+ private:
+  static constexpr std::size_t staging_size = (1u << 16u) / sizeof(T) + 1u;
+
+  std::istream& _source;
+  std::vector<T> _staging;
+  std::size_t _first{};
+  std::size_t _size{};
+  std::size_t _available{};
+
+ public:
+  /*
+   * Parameters:
+   * @param source: stream positioned at the beginning of the payload
+   * @param size: number of elements in the payload
+   */
+  PayloadReader(std::istream& source, std::size_t size) : _source{source}, _staging(staging_size), _size{size} {}
+
+  /*
+   * Returns the element at the given payload position. Positions have to be increasing
+   */
+  [[nodiscard]] const T& get(std::size_t position) {
+    while (position >= _first + _available) {
+      _first += _available;
+      _available = std::min(staging_size, _size - _first);
+
+      if (!_source.read(reinterpret_cast<char*>(_staging.data()), static_cast<std::streamsize>(_available * sizeof(T))))
+        [[unlikely]] {
+        binary_format_error("truncated payload");
+      }
+    }
+
+    return _staging[position - _first];
+  }
+
+  /*
+   * Consumes the rest of the payload
+   */
+  void finish() {
+    _source.ignore(static_cast<std::streamsize>((_size - _first - _available) * sizeof(T)));
+  }
+};
+
+/*
+ * Walks the elements of a plane in the order in which they're stored in its payload
+ * Parameters:
+ * @param plane: iterated plane (or a part of it)
+ * @param invocable: invocable called with each element and its position inside the payload
+ * @param position: payload position of the plane's first element
+ */
+template <typename Plane, typename Invocable>
+void walk_payload(Plane&& plane, Invocable&& invocable, std::size_t position = 0u) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  static constexpr std::size_t channels = plane_type::channels();
+  static constexpr auto strides = payload_strides<plane_type>();
+
+  if constexpr (rank > 1u) {
+    for (std::size_t i = 0u; i < plane_type::dimensions().template at<rank - 1u>(); ++i) {
+      walk_payload(plane.template like<remove_nth_element<rank - 1u>(plane_type::dimensions()),
+                                       remove_nth_element<rank - 1u>(plane_type::strides())>(
+                       i * plane_type::strides().template at<rank - 1u>() * channels),
+                   invocable, position + i * strides.template at<rank - 1u>() * channels);
+    }
+  } else {
+    for (std::size_t d = 0u; d < plane_type::dimensions().template at<0u>(); ++d) {
+      for (std::size_t c = 0u; c < channels; ++c) {
+        invocable(plane.at(d * plane_type::strides().template at<0u>() * channels + c),
+                  position + d * strides.template at<0u>() * channels + c);
+      }
+    }
+  }
+}
+
+/*
+ * Writes the payload of a plane to a stream
+ */
+template <typename Plane>
+void write_binary_payload(const Plane& plane, std::ostream& sink) {
+  using value_type = typename Plane::value_type;
+  static constexpr std::size_t size = payload_elements<Plane>();
+
+  if constexpr (has_payload_layout<Plane>()) {
+    if (plane.offset() >= 0 && plane.effective_size() >= size) {
+      sink.write(reinterpret_cast<const char*>(&plane[0u]), static_cast<std::streamsize>(size * sizeof(value_type)));
+      return;
+    }
+  }
+
+  PayloadWriter<value_type> writer{sink};
+  walk_payload(plane, [&writer](const value_type& value, std::size_t position) { writer.put(position, value); });
+  writer.finish(size);
+}
+
+/*
+ * Reads the payload of a plane from a stream
+ */
+template <typename Plane>
+void read_binary_payload(Plane& plane, std::istream& source) {
+  using value_type = typename Plane::value_type;
+  static constexpr std::size_t size = payload_elements<Plane>();
+
+  if constexpr (has_payload_layout<Plane>()) {
+    if (plane.offset() >= 0 && plane.effective_size() >= size) {
+      if (!source.read(reinterpret_cast<char*>(&plane[0u]), static_cast<std::streamsize>(size * sizeof(value_type)))) {
+        binary_format_error("truncated payload");
+      }
+      return;
+    }
+  }
+
+  PayloadReader<value_type> reader{source, size};
+  walk_payload(plane, [&reader](auto&& element, std::size_t position) { element = reader.get(position); });
+  reader.finish();
+}
+
+/*
+ * Type of a plane whose elements are stored in a mapped binary tensor file
+ * Parameters:
+ * @tparam Plane: type of the plane that was written to the file
+ * @tparam mode: mapping mode of the file
+ */
+template <typename Plane, mapping_mode mode>
+using mapped_plane_t = ntensor::Plane<MappedBuffer<typename Plane::value_type, mode>, Plane::dimensions(),
+                                      payload_strides<Plane>(), Plane::channels()>;
+
+template <typename, mapping_mode>
+struct mapped_tensor;
+
+/*
+ * Type of a tensor whose planes are stored in a mapped binary tensor file. The tensor keeps the original policies
+ * Parameters:
+ * @tparam PlaneTypes: types of the planes that were written to the file
+ * @tparam Policies: policies of the tensor that was written to the file
+ * @tparam mode: mapping mode of the file
+ */
+template <typename... PlaneTypes, template <typename> typename... Policies, mapping_mode mode>
+struct mapped_tensor<Tensor<Planes<PlaneTypes...>, Policies...>, mode> {
+  using type = Tensor<Planes<mapped_plane_t<PlaneTypes, mode>...>, Policies...>;
+};
+
+}  // namespace internal
+
+/*
+ * Writes a tensor to a stream in the binary tensor format
+ * The format consists of a header describing each plane (element type, dimensions, strides and channels) followed by
+ * the raw, aligned payloads of the planes. Planes stored contiguously with aligned strides are written with a single
+ * write call per plane, other planes are gathered through a small staging buffer
+ * Parameters:
+ * @param tensor: tensor that's written to the stream
+ * @param sink: binary output stream
+ * Exceptions:
+ * std::runtime_error if writing to the stream fails, so a truncated file is never left behind silently
+ * Constraints:
+ * The elements of the tensor have to be trivially copyable
+ */
+template <typename Tensor>
+void write_binary(Tensor&& tensor, std::ostream& sink) {
+  std::vector<binary_plane_record> records;
+  for_each_plane(
+      [&records](auto&& plane) { records.push_back(make_binary_plane_record<std::decay_t<decltype(plane)>>()); },
+      tensor);
+
+  binary_file_header header{};
+  header.num_planes = static_cast<std::uint32_t>(records.size());
+
+  std::uint64_t offset = sizeof(header);
+  for (const auto& record : records) {
+    offset += sizeof(record.descriptor) + record.descriptor.rank * (sizeof(std::uint64_t) + sizeof(std::int64_t));
+  }
+
+  for (auto& record : records) {
+    record.descriptor.payload_offset = offset = align_binary_offset(offset);
+    offset += record.descriptor.payload_size;
+  }
+
+  sink.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!sink) {
+    binary_format_error("failed to write the header");
+  }
+
+  std::uint64_t position = sizeof(header);
+  for (const auto& record : records) {
+    sink.write(reinterpret_cast<const char*>(&record.descriptor), sizeof(record.descriptor));
+    sink.write(reinterpret_cast<const char*>(record.dimensions.data()),
+               static_cast<std::streamsize>(record.dimensions.size() * sizeof(std::uint64_t)));
+    sink.write(reinterpret_cast<const char*>(record.strides.data()),
+               static_cast<std::streamsize>(record.strides.size() * sizeof(std::int64_t)));
+    position += sizeof(record.descriptor) + record.descriptor.rank * (sizeof(std::uint64_t) + sizeof(std::int64_t));
+  }
+  if (!sink) {
+    binary_format_error("failed to write the plane descriptors");
+  }
+
+  static constexpr std::array<char, binary_alignment> padding{};
+  std::size_t idx = 0u;
+
+  for_each_plane(
+      [&](auto&& plane) {
+        const auto& descriptor = records[idx++].descriptor;
+        sink.write(padding.data(), static_cast<std::streamsize>(descriptor.payload_offset - position));
+        write_binary_payload(plane, sink);
+        if (!sink) {
+          binary_format_error("failed to write a payload");
+        }
+        position = descriptor.payload_offset + descriptor.payload_size;
+      },
+      tensor);
+}
+
+/*
+ * Loads a tensor written in the binary tensor format from a stream into an existing tensor
+ * The payloads are read directly into the memory of planes stored contiguously with aligned strides, other planes are
+ * filled through a small staging buffer, so no copy of the whole tensor is ever made
+ * Parameters:
+ * @param tensor: tensor into which the elements are loaded
+ * @param source: binary input stream
+ * Exceptions:
+ * std::runtime_error if the stream doesn't contain a binary tensor with the same number of planes, element types,
+ * dimensions and channels as the given tensor
+ */
+template <typename Tensor>
+void load_binary(Tensor&& tensor, std::istream& source) {
+  std::size_t num_planes = 0u;
+  std::size_t max_rank = 0u;
+  for_each_plane(
+      [&num_planes, &max_rank](const auto& plane) {
+        ++num_planes;
+        max_rank = std::max(max_rank, std::decay_t<decltype(plane)>::rank());
+      },
+      tensor);
+
+  std::uint64_t position = 0u;
+  const auto records = read_binary_records(
+      [&source, &position](void* destination, std::size_t size) {
+        position += size;
+        return static_cast<bool>(source.read(static_cast<char*>(destination), static_cast<std::streamsize>(size)));
+      },
+      num_planes, max_rank);
+
+  std::size_t idx = 0u;
+
+  for_each_plane(
+      [&](auto& plane) {
+        using plane_type = std::decay_t<decltype(plane)>;
+        const auto& record = records[idx++];
+        validate_binary_plane_record<plane_type>(record);
+
+        if (record.descriptor.payload_offset < position) {
+          binary_format_error("overlapping payloads");
+        }
+
+        source.ignore(static_cast<std::streamsize>(record.descriptor.payload_offset - position));
+        read_binary_payload(plane, source);
+        position = record.descriptor.payload_offset + record.descriptor.payload_size;
+      },
+      tensor);
+}
+
+/*
+ * Maps a file written in the binary tensor format into memory, and creates a tensor viewing it
+ * No elements are copied; each plane uses a MappedBuffer viewing its payload inside the mapped file, and the mapping is
+ * released once the last plane referencing it is destroyed
+ * Parameters:
+ * @tparam Tensor: type of the tensor that was written to the file. The returned tensor has the same dimensions,
+ * channels and policies, while its planes use the MappedBuffer and the aligned strides of the payloads
+ * @tparam mode: mapping mode. With the copy_on_write mode the tensor can be modified without changing the file, while
+ * with the shared mode the changes are written to the file
+ * @param path: path of the binary tensor file
+ * @return: tensor viewing the mapped file
+ * Exceptions:
+ * std::system_error if the file can't be mapped
+ * std::runtime_error if the file doesn't contain a tensor with the same planes as the given tensor type
+ */
+template <typename Tensor, mapping_mode mode = mapping_mode::read_only>
+[[nodiscard]] auto map_binary(const std::filesystem::path& path) {
+  using tensor_type = typename mapped_tensor<std::remove_cvref_t<Tensor>, mode>::type;
+
+  const auto mapping = std::make_shared<const FileMapping>(path, mode);
+
+  return [&]<typename... PlaneTypes, template <typename> typename... Policies>(
+             std::type_identity<ntensor::Tensor<Planes<PlaneTypes...>, Policies...>>) {
+    std::size_t position = 0u;
+    const auto records = read_binary_records(
+        [&mapping, &position](void* destination, std::size_t size) {
+          if (size > mapping->size() - position) {
+            return false;
+          }
+          std::memcpy(destination, mapping->data() + position, size);
+          position += size;
+          return true;
+        },
+        sizeof...(PlaneTypes), std::max({std::size_t{0u}, PlaneTypes::rank()...}));
+
+    return [&]<std::size_t... is>(std::index_sequence<is...>) {
+      auto create_plane = [&mapping]<typename PlaneType>(const binary_plane_record& record) {
+        using value_type = typename PlaneType::value_type;
+        validate_binary_plane_record<PlaneType>(record);
+
+        if (record.descriptor.payload_offset > mapping->size() ||
+            record.descriptor.payload_size > mapping->size() - record.descriptor.payload_offset) {
+          binary_format_error("truncated payload");
+        }
+
+        return mapped_plane_t<PlaneType, mode>{MappedBuffer<value_type, mode>{
+            mapping, static_cast<std::size_t>(record.descriptor.payload_offset), payload_elements<PlaneType>()}};
+      };
+
+      return tensor_type{Planes{create_plane.template operator()<PlaneTypes>(records[is])...}};
+    }(std::index_sequence_for<PlaneTypes...>());
+  }(std::type_identity<std::remove_cvref_t<Tensor>>());
+}
+
+}  // namespace ntensor
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <type_traits>
 
 namespace ntensor {
 
@@ -91,4 +92,18 @@ concept buffer = requires(std::remove_reference_t<T> const v) {
                            { v[0u] } -> std::same_as<typename T::reference>;
                          })));
 
+/*
+ * Concept specifying the requirements for a buffer whose elements are stored contiguously in memory
+ * Constraints:
+ * The type has to satisfy the buffer concept
+ * The buffer's reference alias has to be an lvalue reference to an arithmetic type
+ * The buffer has to have a method named "data", which returns a pointer to its first element
+ */
+template <typename T>
+concept contiguous_buffer =
+    buffer<T> && std::is_lvalue_reference_v<typename T::reference> &&
+    arithmetic<std::remove_reference_t<typename T::reference>> && requires(std::remove_reference_t<T> v) {
+      { v.data() } -> std::same_as<typename T::pointer>;
+    };
+
 }  // namespace ntensor
@@ -0,0 +1,528 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concepts.hpp"
+#include "dense_buffer.hpp"
+#include "execute.hpp"
+#include "execution_policy.hpp"
+#include "plane.hpp"
+#include "simd.hpp"
+#include "tensor.hpp"
+#include "thread_pool.hpp"
+
+#ifndef NT_L1_CACHE_SIZE
+#define NT_L1_CACHE_SIZE 32768
+#endif
+
+#ifndef NT_L2_CACHE_SIZE
+#define NT_L2_CACHE_SIZE 262144
+#endif
+
+namespace ntensor {
+
+inline namespace internal {
+
+/*
+ * Number of rows of the block of the result computed by the micro-kernel of a contraction
+ */
+inline constexpr std::size_t gemm_kernel_rows = 4u;
+
+/*
+ * Number of columns of the block of the result computed by the micro-kernel of a contraction. Each row of the block is
+ * a single simd pack, so the whole block is kept in registers
+ */
+template <typename T>
+inline constexpr std::size_t gemm_kernel_columns = simd_width_v<T>;
+
+/*
+ * Length of the contracted dimension of the packed blocks. A packed panel of the right-hand side (one row of packs per
+ * contracted element) fills half of the L1 cache, and it stays there while all panels of the left-hand side are
+ * multiplied with it
+ */
+template <typename T>
+inline constexpr std::size_t gemm_depth_block =
+    std::max<std::size_t>(NT_L1_CACHE_SIZE / 2u / (gemm_kernel_columns<T> * sizeof(T)), 1u);
+
+/*
+ * Number of rows of the packed blocks of the left-hand side. A packed block fills half of the L2 cache
+ */
+template <typename T>
+inline constexpr std::size_t gemm_row_block = std::max<std::size_t>(
+    NT_L2_CACHE_SIZE / 2u / (gemm_depth_block<T> * sizeof(T)) / gemm_kernel_rows * gemm_kernel_rows, gemm_kernel_rows);
+
+/*
+ * Number of columns of the packed blocks of the right-hand side. A packed block takes 4 MiB, which is a fraction of a
+ * typical L3 cache
+ */
+template <typename T>
+inline constexpr std::size_t gemm_column_block = std::max<std::size_t>(
+    (1u << 22u) / (gemm_depth_block<T> * sizeof(T)) / gemm_kernel_columns<T> * gemm_kernel_columns<T>,
+    gemm_kernel_columns<T>);
+
+/*
+ * Returns every other axis of a list of pairs of contracted axes
+ * Parameters:
+ * @tparam first: 0 for the axes of the left-hand side, 1 for the axes of the right-hand side
+ * @param pairs: pairs of contracted axes
+ */
+template <std::size_t first, std::size_t N>
+[[nodiscard]] consteval auto contracted_axes(const std::array<std::size_t, N>& pairs) noexcept {
+  std::array<std::size_t, N / 2u> axes{};
+  for (std::size_t i = 0u; i < N / 2u; ++i) axes[i] = pairs[2u * i + first];
+  return axes;
+}
+
+/*
+ * Returns the axes in the range [first, last)
+ */
+template <std::size_t first, std::size_t last>
+[[nodiscard]] consteval auto axes_range() noexcept {
+  std::array<std::size_t, last - first> axes{};
+  for (std::size_t i = 0u; i < axes.size(); ++i) axes[i] = first + i;
+  return axes;
+}
+
+/*
+ * Returns the dimensions of a plane as an array
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval auto dimensions_array() noexcept {
+  return []<std::size_t... is>(std::index_sequence<is...>) {
+    return std::array<std::size_t, sizeof...(is)>{static_cast<std::size_t>(Plane::dimensions().template at<is>())...};
+  }(std::make_index_sequence<Plane::rank()>());
+}
+
+/*
+ * Checks whether the contracted axes of a plane are valid: all of them have to be lower than the rank of the plane,
+ * and none of them can be repeated
+ * Parameters:
+ * @tparam rank: rank of the plane
+ * @param axes: contracted axes
+ */
+template <std::size_t rank, std::size_t N>
+[[nodiscard]] consteval bool are_valid_contracted_axes(std::array<std::size_t, N> axes) noexcept {
+  std::sort(axes.begin(), axes.end());
+  return std::adjacent_find(axes.begin(), axes.end()) == axes.end() &&
+         std::all_of(axes.begin(), axes.end(), [](std::size_t axis) { return axis < rank; });
+}
+
+/*
+ * Returns the axes of a plane that aren't contracted, in ascending order
+ * Parameters:
+ * @tparam rank: rank of the plane
+ * @param contracted: contracted axes
+ */
+template <std::size_t rank, std::size_t N>
+[[nodiscard]] consteval auto free_axes(const std::array<std::size_t, N>& contracted) noexcept {
+  std::array<std::size_t, rank - N> axes{};
+  for (std::size_t axis = 0u, i = 0u; axis < rank; ++axis) {
+    if (std::find(contracted.begin(), contracted.end(), axis) == contracted.end()) axes[i++] = axis;
+  }
+  return axes;
+}
+
+/*
+ * Computes the positions of the elements of a plane along a group of its dimensions
+ * The group is flattened like a plane with the same dimensions, from the innermost to the outermost dimension of the
+ * group, so the i-th position belongs to the i-th element of the flattened group. The positions are multiplied by the
+ * number of channels. An empty group has a single element, at the position 0
+ * Parameters:
+ * @param plane: plane whose positions are computed
+ * @param axes: dimensions of the group
+ * @return: positions of the elements of the group, relative to the plane's offset
+ */
+template <typename Plane, std::size_t N>
+[[nodiscard]] std::vector<long long> contraction_positions(const Plane& plane, const std::array<std::size_t, N>& axes) {
+  const auto dimensions = plane_dimensions(plane);
+  const auto strides = plane_strides(plane);
+
+  std::size_t size = 1u;
+  for (const std::size_t axis : axes) size *= dimensions[axis];
+
+  std::vector<long long> positions(size);
+  std::array<std::size_t, N> indexes{};
+  long long position = 0;
+  for (std::size_t i = 0u; i < size; ++i) {
+    positions[i] = position * static_cast<long long>(std::decay_t<Plane>::channels());
+    for (std::size_t d = 0u; d < N; ++d) {
+      position += strides[axes[d]];
+      if (++indexes[d] < dimensions[axes[d]]) break;
+      position -= strides[axes[d]] * static_cast<long long>(dimensions[axes[d]]);
+      indexes[d] = 0u;
+    }
+  }
+  return positions;
+}
+
+/*
+ * Operand of a contraction, viewed as a matrix
+ * The rows and the columns of the matrix are flattened groups of the plane's dimensions, so an element of the matrix
+ * is found by adding the positions of its row and its column. Any strides are supported, so views created by permute or
+ * by slicing are read directly while they're packed, without materializing them first
+ */
+template <typename Plane>
+struct contraction_operand {
+  const Plane& plane;
+  std::vector<long long> rows;
+  std::vector<long long> columns;
+
+  /*
+   * Returns an element of the matrix
+   * Parameters:
+   * @param row: row of the element
+   * @param column: column of the element
+   * @param channel: channel of the element
+   */
+  template <typename T>
+  [[nodiscard]] T element(std::size_t row, std::size_t column, std::size_t channel) const {
+    const auto position = static_cast<std::size_t>(rows[row] + columns[column]) + channel;
+    if constexpr (requires { plane[position]; }) {
+      return static_cast<T>(plane[position]);
+    } else {
+      return static_cast<T>(plane.at(position));
+    }
+  }
+};
+
+/*
+ * Copies a block of the left-hand side of a contraction into panels of gemm_kernel_rows rows. Within a panel, the
+ * elements of all rows that belong to one column are consecutive, in the order in which the micro-kernel reads them.
+ * The rows missing from the last panel are filled with zeros
+ * Parameters:
+ * @param lhs: left-hand side of the contraction
+ * @param channel: packed channel
+ * @param first_row: first packed row
+ * @param rows: number of packed rows
+ * @param first_column: first packed column
+ * @param columns: number of packed columns
+ * @param packed: memory to which the panels are written
+ */
+template <typename T, typename Operand>
+void pack_lhs(const Operand& lhs, std::size_t channel, std::size_t first_row, std::size_t rows,
+              std::size_t first_column, std::size_t columns, T* packed) {
+  static constexpr std::size_t kernel_rows = gemm_kernel_rows;
+
+  for (std::size_t panel = 0u; panel < rows; panel += kernel_rows) {
+    for (std::size_t k = 0u; k < columns; ++k) {
+      for (std::size_t i = 0u; i < kernel_rows; ++i) {
+        *packed++ =
+            panel + i < rows ? lhs.template element<T>(first_row + panel + i, first_column + k, channel) : T{};
+      }
+    }
+  }
+}
+
+/*
+ * Copies a block of the right-hand side of a contraction into panels of gemm_kernel_columns columns. Within a panel,
+ * the elements of a row are consecutive, so the micro-kernel loads them as a single simd pack. The columns missing from
+ * the last panel are filled with zeros
+ * Parameters:
+ * @param rhs: right-hand side of the contraction
+ * @param channel: packed channel
+ * @param first_row: first packed row
+ * @param rows: number of packed rows
+ * @param first_column: first packed column
+ * @param columns: number of packed columns
+ * @param packed: memory to which the panels are written
+ */
+template <typename T, typename Operand>
+void pack_rhs(const Operand& rhs, std::size_t channel, std::size_t first_row, std::size_t rows,
+              std::size_t first_column, std::size_t columns, T* packed) {
+  static constexpr std::size_t kernel_columns = gemm_kernel_columns<T>;
+
+  for (std::size_t panel = 0u; panel < columns; panel += kernel_columns) {
+    for (std::size_t k = 0u; k < rows; ++k) {
+      for (std::size_t j = 0u; j < kernel_columns; ++j) {
+        *packed++ =
+            panel + j < columns ? rhs.template element<T>(first_row + k, first_column + panel + j, channel) : T{};
+      }
+    }
+  }
+}
+
+/*
+ * Multiplies a packed panel of the left-hand side with a packed panel of the right-hand side
+ * Each row of the computed block is accumulated in its own simd pack, and each element of the left-hand side is
+ * broadcast and multiplied with a whole row of the right-hand side. The accumulators never leave the registers, so
+ * every loaded element is used gemm_kernel_rows (or gemm_kernel_columns) times
+ * Parameters:
+ * @param lhs: packed panel of the left-hand side
+ * @param rhs: packed panel of the right-hand side
+ * @param depth: length of the contracted dimension of the panels
+ * @return: computed block
+ */
+template <typename T>
+[[nodiscard]] inline auto gemm_kernel(const T* lhs, const T* rhs, std::size_t depth) noexcept {
+  using pack_type = simd_pack<T, gemm_kernel_columns<T>>;
+  static constexpr std::size_t kernel_rows = gemm_kernel_rows;
+  static constexpr std::size_t kernel_columns = gemm_kernel_columns<T>;
+
+  std::array<pack_type, kernel_rows> accumulators;
+  accumulators.fill(pack_type{T{}});
+
+  for (std::size_t k = 0u; k < depth; ++k) {
+    const pack_type row = pack_type::load(rhs + k * kernel_columns);
+    [&accumulators, &row, lhs = lhs + k * kernel_rows]<std::size_t... is>(std::index_sequence<is...>) {
+      ((accumulators[is] += pack_type{lhs[is]} * row), ...);
+    }(std::make_index_sequence<kernel_rows>());
+  }
+
+  return accumulators;
+}
+
+/*
+ * Contracts a single channel of two operands, and writes the result into the memory of the result plane
+ * The operands are multiplied like matrices, using the blocking of a packed GEMM: the right-hand side is packed in
+ * blocks of gemm_depth_block rows and gemm_column_block columns, the left-hand side in blocks of gemm_row_block rows,
+ * and the packed blocks are multiplied panel by panel by the micro-kernel. With a thread pool, the blocks of the
+ * left-hand side are multiplied concurrently, since they write into different rows of the result
+ * Parameters:
+ * @param pool: thread pool, or nullptr for a sequential contraction
+ * @param lhs: left-hand side, whose columns are contracted
+ * @param rhs: right-hand side, whose rows are contracted
+ * @param channel: contracted channel
+ * @param result: memory of the result plane, starting at the contracted channel
+ * @param result_rows: positions of the rows of the result
+ * @param result_columns: positions of the columns of the result
+ */
+template <typename T, typename Lhs, typename Rhs>
+void contract_channel(ThreadPool* pool, const contraction_operand<Lhs>& lhs, const contraction_operand<Rhs>& rhs,
+                      std::size_t channel, T* result, const std::vector<long long>& result_rows,
+                      const std::vector<long long>& result_columns) {
+  static constexpr std::size_t kernel_rows = gemm_kernel_rows;
+  static constexpr std::size_t kernel_columns = gemm_kernel_columns<T>;
+  const std::size_t M = lhs.rows.size();
+  const std::size_t K = lhs.columns.size();
+  const std::size_t N = rhs.columns.size();
+
+  const auto round_up = [](std::size_t value, std::size_t multiple) {
+    return (value + multiple - 1u) / multiple * multiple;
+  };
+
+  // Smaller blocks of the left-hand side are used when there are fewer than one block per thread
+  const std::size_t num_threads = pool ? pool->size() : 1u;
+  const std::size_t row_block =
+      std::min(round_up((M + num_threads - 1u) / num_threads, kernel_rows), gemm_row_block<T>);
+  const std::size_t num_row_blocks = (M + row_block - 1u) / row_block;
+
+  const std::size_t depth_block = std::min(K, gemm_depth_block<T>);
+  DenseBuffer<T> packed_rhs{round_up(std::min(N, gemm_column_block<T>), kernel_columns) * depth_block};
+
+  for (std::size_t jc = 0u; jc < N; jc += gemm_column_block<T>) {
+    const std::size_t nc = std::min(gemm_column_block<T>, N - jc);
+
+    for (std::size_t pc = 0u; pc < K; pc += depth_block) {
+      const std::size_t kc = std::min(depth_block, K - pc);
+      pack_rhs(rhs, channel, pc, kc, jc, nc, packed_rhs.data());
+
+      auto multiply = [&](std::size_t first, std::size_t last) {
+        DenseBuffer<T> packed_lhs{row_block * kc};
+
+        for (std::size_t block = first; block < last; ++block) {
+          const std::size_t ic = block * row_block;
+          const std::size_t mc = std::min(row_block, M - ic);
+          pack_lhs(lhs, channel, ic, mc, pc, kc, packed_lhs.data());
+
+          for (std::size_t jr = 0u; jr < nc; jr += kernel_columns) {
+            const std::size_t columns = std::min(kernel_columns, nc - jr);
+            for (std::size_t ir = 0u; ir < mc; ir += kernel_rows) {
+              const std::size_t rows = std::min(kernel_rows, mc - ir);
+              const auto block_result = gemm_kernel(packed_lhs.data() + ir * kc, packed_rhs.data() + jr * kc, kc);
+
+              // The first block of the contracted dimension overwrites the uninitialized result
+              for (std::size_t i = 0u; i < rows; ++i) {
+                T* row = result + result_rows[ic + ir + i];
+                for (std::size_t j = 0u; j < columns; ++j) {
+                  T& element = row[result_columns[jc + jr + j]];
+                  element = pc ? element + block_result[i][j] : block_result[i][j];
+                }
+              }
+            }
+          }
+        }
+      };
+
+      if (pool && num_row_blocks > 1u) {
+        pool->parallel_for(0u, num_row_blocks, 1u, multiply);
+      } else {
+        multiply(0u, num_row_blocks);
+      }
+    }
+  }
+}
+
+/*
+ * Contracts two planes along pairs of their axes
+ * Parameters:
+ * @tparam axes: pairs of contracted axes, the first axis of a pair belongs to the left-hand side
+ * @param pool: thread pool, or nullptr for a sequential contraction
+ * @param lhs: left-hand side plane
+ * @param rhs: right-hand side plane
+ * @return: new plane, whose dimensions are the free dimensions of the right-hand side, followed by the free dimensions
+ * of the left-hand side
+ */
+template <std::size_t... axes, typename Lhs, typename Rhs>
+[[nodiscard]] auto contract_planes(ThreadPool* pool, const Lhs& lhs, const Rhs& rhs) {
+  using lhs_type = std::decay_t<Lhs>;
+  using rhs_type = std::decay_t<Rhs>;
+  using T = std::common_type_t<std::remove_const_t<typename lhs_type::value_type>,
+                               std::remove_const_t<typename rhs_type::value_type>>;
+  static constexpr std::size_t channels = lhs_type::channels();
+  static constexpr std::size_t lhs_rank = lhs_type::rank();
+  static constexpr std::size_t rhs_rank = rhs_type::rank();
+
+  static_assert(!is_dynamic_plane_v<lhs_type> && !is_dynamic_plane_v<rhs_type>,
+                "The dimensions of the contracted planes have to be known at compile time");
+  static_assert(arithmetic<T>, "The contracted planes have to store arithmetic values");
+  static_assert(channels == rhs_type::channels(), "The contracted planes have to have the same number of channels");
+  static_assert(sizeof...(axes) % 2u == 0u, "The contracted axes have to be specified in pairs");
+
+  static constexpr std::array<std::size_t, sizeof...(axes)> pairs{axes...};
+  static constexpr auto lhs_contracted = contracted_axes<0u>(pairs);
+  static constexpr auto rhs_contracted = contracted_axes<1u>(pairs);
+  static_assert(are_valid_contracted_axes<lhs_rank>(lhs_contracted) &&
+                    are_valid_contracted_axes<rhs_rank>(rhs_contracted),
+                "The contracted axes have to be unique, and lower than the rank of their plane");
+  static_assert(
+      [] {
+        constexpr auto lhs_dimensions = dimensions_array<lhs_type>();
+        constexpr auto rhs_dimensions = dimensions_array<rhs_type>();
+        for (std::size_t i = 0u; i < lhs_contracted.size(); ++i) {
+          if (lhs_dimensions[lhs_contracted[i]] != rhs_dimensions[rhs_contracted[i]]) return false;
+        }
+        return true;
+      }(),
+      "The contracted axes have to have the same extents");
+
+  static constexpr auto lhs_free = free_axes<lhs_rank>(lhs_contracted);
+  static constexpr auto rhs_free = free_axes<rhs_rank>(rhs_contracted);
+  static_assert(lhs_free.size() + rhs_free.size() > 0u,
+                "Contracting all axes produces a single value, use transform_reduce instead");
+
+  static constexpr auto result_dimensions = []<std::size_t... ls, std::size_t... rs>(std::index_sequence<ls...>,
+                                                                                     std::index_sequence<rs...>) {
+    return Dimensions<static_cast<std::size_t>(rhs_type::dimensions().template at<rhs_free[rs]>())...,
+                      static_cast<std::size_t>(lhs_type::dimensions().template at<lhs_free[ls]>())...>{};
+  }(std::make_index_sequence<lhs_free.size()>(), std::make_index_sequence<rhs_free.size()>());
+
+  auto result = create_plane<DenseBuffer<T>, result_dimensions, channels>();
+
+  const auto result_rows =
+      contraction_positions(result, axes_range<rhs_free.size(), lhs_free.size() + rhs_free.size()>());
+  const auto result_columns = contraction_positions(result, axes_range<0u, rhs_free.size()>());
+
+  const contraction_operand<Lhs> lhs_operand{lhs, contraction_positions(lhs, lhs_free),
+                                             contraction_positions(lhs, lhs_contracted)};
+  const contraction_operand<Rhs> rhs_operand{rhs, contraction_positions(rhs, rhs_contracted),
+                                             contraction_positions(rhs, rhs_free)};
+
+  T* result_data = result.buffer().data() + result.offset();
+  for (std::size_t c = 0u; c < channels; ++c) {
+    contract_channel(pool, lhs_operand, rhs_operand, c, result_data + c, result_rows, result_columns);
+  }
+
+  return result;
+}
+
+}  // namespace internal
+
+/*
+ * Contracts the planes of two tensors along pairs of their axes, using the specified execution policy
+ * Each element of the result is the sum of the products of the elements of both planes whose indexes along the
+ * contracted axes are equal. The free (not contracted) dimensions of the right-hand side become the innermost
+ * dimensions of the result, and the free dimensions of the left-hand side its outermost dimensions, each group in its
+ * original order. The contraction of two matrices (rank 2 planes, dimension 0 being the columns) along the columns of
+ * the left-hand side and the rows of the right-hand side is therefore the matrix product (see matmul)
+ * The planes are contracted like matrices with a packed GEMM: blocks of both planes are copied into panels sized for
+ * the caches and the simd registers, and the panels are multiplied by a register-blocked micro-kernel. The planes can
+ * have any strides (for example permuted views), since their elements are read only while they're packed. With the
+ * parallel policy, the blocks of the left-hand side are multiplied on a thread pool
+ * Parameters:
+ * @tparam axes: pairs of contracted axes, starting from 0 for the innermost dimension. The first axis of a pair belongs
+ * to the left-hand side, the second one to the right-hand side. Without axes, the outer product is computed
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param lhs: left-hand side tensor
+ * @param rhs: right-hand side tensor
+ * @return: new tensor, whose planes are the contractions of the corresponding planes of both tensors. The planes of the
+ * new tensor are stored in DenseBuffers
+ * Constraints:
+ * Both tensors have to have the same number of planes, and the corresponding planes have to have the same number of
+ * channels, arithmetic values, and the same extents along the contracted axes
+ */
+template <std::size_t... axes, execution_policy Policy, typename LhsTensor, typename RhsTensor>
+[[nodiscard]] auto tensordot(Policy&& policy, LhsTensor&& lhs, RhsTensor&& rhs) {
+  static constexpr std::size_t N = std::decay_t<decltype(lhs.planes())>::size();
+  static_assert(N == std::decay_t<decltype(rhs.planes())>::size(),
+                "The contracted tensors have to have the same number of planes");
+
+  ThreadPool* pool = nullptr;
+  if constexpr (is_parallel_policy_v<Policy>) pool = &policy.pool();
+
+  return [&]<std::size_t... is>(std::index_sequence<is...>) {
+    return lhs.like(Planes{
+        contract_planes<axes...>(pool, lhs.planes().template plane<is>(), rhs.planes().template plane<is>())...});
+  }(std::make_index_sequence<N>());
+}
+
+/*
+ * Contracts the planes of two tensors along pairs of their axes
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @tparam axes: pairs of contracted axes
+ * @param lhs: left-hand side tensor
+ * @param rhs: right-hand side tensor
+ * @return: new tensor, whose planes are the contractions of the corresponding planes of both tensors
+ */
+template <std::size_t... axes, typename LhsTensor, typename RhsTensor>
+  requires(!execution_policy<LhsTensor>)
+[[nodiscard]] auto tensordot(LhsTensor&& lhs, RhsTensor&& rhs) {
+  return tensordot<axes...>(seq, std::forward<LhsTensor>(lhs), std::forward<RhsTensor>(rhs));
+}
+
+/*
+ * Multiplies the planes of two tensors as matrices, using the specified execution policy
+ * The dimension 0 of a plane is the columns of the matrix, and the dimension 1 its rows, so multiplying a plane with
+ * dimensions [K, M] by a plane with dimensions [N, K] produces a plane with dimensions [N, M]. See tensordot for
+ * details
+ * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param lhs: left-hand side tensor
+ * @param rhs: right-hand side tensor
+ * @return: new tensor, whose planes are the products of the corresponding planes of both tensors
+ * Constraints:
+ * All planes have to have a rank of 2
+ */
+template <execution_policy Policy, typename LhsTensor, typename RhsTensor>
+[[nodiscard]] auto matmul(Policy&& policy, LhsTensor&& lhs, RhsTensor&& rhs) {
+  for_all_planes(
+      [](const auto&... planes) {
+        static_assert(((std::decay_t<decltype(planes)>::rank() == 2u) && ...),
+                      "Only planes of rank 2 can be multiplied");
+      },
+      lhs, rhs);
+  return tensordot<0u, 1u>(std::forward<Policy>(policy), std::forward<LhsTensor>(lhs), std::forward<RhsTensor>(rhs));
+}
+
+/*
+ * Multiplies the planes of two tensors as matrices
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @param lhs: left-hand side tensor
+ * @param rhs: right-hand side tensor
+ * @return: new tensor, whose planes are the products of the corresponding planes of both tensors
+ */
+template <typename LhsTensor, typename RhsTensor>
+  requires(!execution_policy<LhsTensor>)
+[[nodiscard]] auto matmul(LhsTensor&& lhs, RhsTensor&& rhs) {
+  return matmul(seq, std::forward<LhsTensor>(lhs), std::forward<RhsTensor>(rhs));
+}
+
+}  // namespace ntensor
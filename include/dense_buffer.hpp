@@ -25,7 +25,7 @@ template <arithmetic T, typename Allocator = nt_allocator<T>>
   requires allocator<Allocator, T>
 class DenseBuffer {
  private:
-  std::shared_ptr<Allocator> _allocator{};
+  Allocator _allocator{};
   std::shared_ptr<T[]> _memory{nullptr};
   std::size_t _size{};
 
@@ -48,13 +48,22 @@ class DenseBuffer {
    * Parameters:
    * @param size: number of elements for which the memory needs to be allocated
    */
-  explicit DenseBuffer(std::size_t size) : _size{size} {
+  explicit DenseBuffer(std::size_t size) : DenseBuffer(std::allocator_arg, Allocator{}, size) {}
+
+  /*
+   * Allocates memory for the specified number of elements using the given allocator
+   * A copy of the allocator is kept by the buffer and used for deallocating the memory
+   * Parameters:
+   * @param allocator: allocator used for allocating the memory
+   * @param size: number of elements for which the memory needs to be allocated
+   */
+  DenseBuffer(std::allocator_arg_t, const Allocator& allocator, std::size_t size)
+      : _allocator{allocator}, _size{size} {
 #ifdef ENABLE_NT_EXPECTS
     Expects(size > 0u && size < std::numeric_limits<std::size_t>::max() / sizeof(T));
 #endif
 
-    _allocator = std::make_shared<Allocator>();
-    _memory = std::allocate_shared_for_overwrite<T[]>(*_allocator, size);
+    _memory = std::allocate_shared_for_overwrite<T[]>(_allocator, size);
 
 #ifdef ENABLE_NT_EXPECTS
     Expects(_memory && !(reinterpret_cast<uintptr_t>(_memory.get()) % NT_ALIGNMENT));
@@ -82,7 +91,7 @@ class DenseBuffer {
    * Move constructor
    */
   DenseBuffer(DenseBuffer&& other) noexcept
-      : _allocator{std::move(other._allocator)}, _memory{std::move(other._memory)}, _size{other._size} {
+      : _allocator{other._allocator}, _memory{std::move(other._memory)}, _size{other._size} {
     other._size = 0u;
   }
 
@@ -91,7 +100,7 @@ class DenseBuffer {
    */
   DenseBuffer& operator=(DenseBuffer&& other) {
     if (this != &other) [[likely]] {
-      _allocator = std::move(other._allocator);
+      _allocator = other._allocator;
       _memory = std::move(other._memory);
       _size = other._size;
       other._size = 0u;
@@ -172,6 +181,13 @@ class DenseBuffer {
    * @return: number of elements found in the buffer
    */
   [[nodiscard]] inline std::size_t size() const noexcept { return _size; }
+
+  /*
+   * Returns a copy of the allocator used by the buffer
+   * Parameters:
+   * @return: allocator used by the buffer
+   */
+  [[nodiscard]] inline Allocator get_allocator() const noexcept { return _allocator; }
 };
 
 }  // namespace ntensor
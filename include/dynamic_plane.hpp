@@ -0,0 +1,630 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "assert.hpp"
+#include "concepts.hpp"
+#include "dimensions.hpp"
+#include "plane.hpp"
+#include "strides.hpp"
+
+namespace ntensor {
+
+/*
+ * Marks an extent whose length is only known at runtime
+ */
+inline constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+/*
+ * Extents of a DynamicPlane (in the style of std::extents). Each extent is either a length known at compile time, or
+ * dynamic_extent, in which case the length is stored in the plane
+ * Parameters:
+ * @tparam extents: sequence of extents, starting from the innermost dimension
+ * Constraints:
+ * The sequence has to contain at least one extent, and the static extents have to be natural numbers
+ */
+template <std::size_t... extents>
+  requires(sizeof...(extents) > 0u && ((extents > 0u) && ...))
+class Extents {
+ public:
+  /*
+   * Returns the number of extents
+   */
+  [[nodiscard]] static consteval std::size_t rank() noexcept { return sizeof...(extents); }
+
+  /*
+   * Returns the number of extents whose length is only known at runtime
+   */
+  [[nodiscard]] static consteval std::size_t rank_dynamic() noexcept {
+    return ((extents == dynamic_extent ? 1u : 0u) + ...);
+  }
+
+  /*
+   * Returns the length of an extent, or dynamic_extent if the length is only known at runtime
+   * Parameters:
+   * @tparam N: index of the extent
+   */
+  template <std::size_t N>
+    requires(N < sizeof...(extents))
+  [[nodiscard]] static consteval std::size_t static_extent() noexcept {
+    return std::array<std::size_t, sizeof...(extents)>{extents...}[N];
+  }
+};
+
+inline namespace internal {
+
+/*
+ * Implementation of the DynamicExtents alias
+ */
+template <std::size_t... is>
+[[nodiscard]] consteval auto make_dynamic_extents(std::index_sequence<is...>) noexcept {
+  return Extents<(static_cast<void>(is), dynamic_extent)...>{};
+}
+
+/*
+ * Removes the Nth extent from a sequence of extents
+ * Parameters:
+ * @tparam N: index of the removed extent
+ * @param extents: sequence of extents
+ */
+template <std::size_t N, std::size_t... extents>
+[[nodiscard]] consteval auto remove_nth_extent(Extents<extents...>) noexcept {
+  return []<std::size_t... is>(std::index_sequence<is...>) {
+    return Extents<Extents<extents...>::template static_extent<(is < N ? is : is + 1u)>()...>{};
+  }(std::make_index_sequence<sizeof...(extents) - 1u>());
+}
+
+}  // namespace internal
+
+/*
+ * Extents of the given rank, whose lengths are all known at runtime only
+ * Parameters:
+ * @tparam rank: number of extents
+ */
+template <std::size_t rank>
+using DynamicExtents = decltype(make_dynamic_extents(std::make_index_sequence<rank>()));
+
+/*
+ * Computes the unaligned strides of a multidimensional array whose dimensions are known at runtime
+ * Parameters:
+ * @param dimensions: array's dimensions
+ * @return: computed strides
+ */
+template <std::size_t rank>
+[[nodiscard]] constexpr std::array<long long, rank> compute_unaligned_strides(
+    const std::array<std::size_t, rank>& dimensions) noexcept {
+  std::array<long long, rank> strides{};
+  strides[0u] = 1;
+  for (std::size_t d = 1u; d < rank; ++d) {
+    strides[d] = static_cast<long long>(dimensions[d - 1u]) * strides[d - 1u];
+  }
+  return strides;
+}
+
+/*
+ * Computes the aligned strides of a multidimensional array whose dimensions are known at runtime
+ * The strides match the ones computed by compute_aligned_strides for the same dimensions known at compile time
+ * Parameters:
+ * @tparam T: value type for which the strides are being computed
+ * @param dimensions: array's dimensions
+ * @return: computed strides
+ */
+template <typename T, std::size_t rank>
+[[nodiscard]] constexpr std::array<long long, rank> compute_aligned_strides(
+    const std::array<std::size_t, rank>& dimensions) noexcept {
+  constexpr long long align_mask = NT_ALIGNMENT / static_cast<long long>(sizeof(T)) - 1;
+  static_assert(align_mask > 0);
+
+  std::size_t first_aligned_stride_pos = 1u;
+  while (first_aligned_stride_pos < rank && dimensions[first_aligned_stride_pos - 1u] == 1u) {
+    ++first_aligned_stride_pos;
+  }
+
+  std::array<long long, rank> strides{};
+  for (std::size_t d = 0u; d < rank; ++d) {
+    if (d < first_aligned_stride_pos) {
+      strides[d] = 1;
+    } else if (d == first_aligned_stride_pos) {
+      strides[d] = (static_cast<long long>(dimensions[d - 1u]) + align_mask) & ~align_mask;
+    } else {
+      strides[d] = static_cast<long long>(dimensions[d - 1u]) * strides[d - 1u];
+    }
+  }
+  return strides;
+}
+
+/*
+ * Plane whose dimensions and strides are stored at runtime
+ * Plane encodes its dimensions and strides in its type, so every distinct shape is a new instantiation of all the code
+ * that uses it. A DynamicPlane instead stores them as members, so a single instantiation handles all shapes of the same
+ * rank. The extents that are known at compile time can still be specified (as in std::mdspan), in which case their
+ * lengths are constants in the code iterating the plane
+ * DynamicPlane provides the same interface as Plane, except that dimensions() and strides() return arrays, and that
+ * the lengths and strides of single dimensions are accessed using extent<N>() and stride<N>()
+ * Parameters:
+ * @tparam Buffer: Type of the buffer that will represent the plane's data
+ * @tparam _Extents: plane's extents (see Extents and DynamicExtents)
+ * @tparam _channels: plane's channels (if there's more than 1 channel, the plane is interleaved)
+ * Constraints:
+ * The Buffer type has to satisfy the buffer concept
+ * Each plane has to have at least 1 channel
+ */
+template <buffer Buffer, typename _Extents, std::size_t _channels = 1u>
+  requires(_channels > 0u)
+class DynamicPlane {
+ private:
+  static constexpr std::size_t _rank = _Extents::rank();
+
+  Buffer _buffer;
+  std::array<std::size_t, _rank> _dimensions{};
+  std::array<long long, _rank> _strides{};
+  long long _offset{};
+
+ public:
+  using type = DynamicPlane<Buffer, _Extents, _channels>;
+  using buffer_type = Buffer;
+  using extents_type = _Extents;
+
+  using size_type = typename Buffer::size_type;
+  using difference_type = typename Buffer::difference_type;
+  using pointer = typename Buffer::pointer;
+  using const_pointer = typename Buffer::const_pointer;
+  using reference = typename Buffer::reference;
+  using const_reference = typename Buffer::const_reference;
+  using value_type = typename Buffer::value_type;
+
+  /*
+   * Default constructor
+   */
+  DynamicPlane() noexcept = default;
+
+  /*
+   * Creates a plane with a given buffer, dimensions, strides and an offset
+   * Parameters:
+   * @param buffer: buffer representing the plane's memory
+   * @param dimensions: plane's dimensions, starting from the innermost dimension
+   * @param strides: plane's strides
+   * @param offset: offset needed to access the first plane element in the buffer
+   * Constraints:
+   * The dimensions have to be natural numbers, and they have to match the extents known at compile time
+   * The smallest and the largest buffer index have to be inside the bounds of 0u and buffer size
+   */
+  DynamicPlane(Buffer buffer, const std::array<std::size_t, _rank>& dimensions,
+               const std::array<long long, _rank>& strides, long long offset = 0)
+      : _buffer{std::move(buffer)}, _dimensions{dimensions}, _strides{strides}, _offset{offset} {
+#ifdef ENABLE_NT_EXPECTS
+    [this]<std::size_t... is>(std::index_sequence<is...>) {
+      Expects(((_dimensions[is] > 0u) && ...));
+      Expects(((_Extents::template static_extent<is>() == dynamic_extent ||
+                _Extents::template static_extent<is>() == _dimensions[is]) &&
+               ...));
+    }(std::make_index_sequence<_rank>());
+#endif
+
+#ifdef ENABLE_NT_ENSURES
+    // Same checks as in the Plane constructor, computed from the runtime dimensions and strides
+    long long min_computed_index = 0, max_computed_index = 0;
+    for (std::size_t d = 0u; d < _rank; ++d) {
+      const long long last = static_cast<long long>(_dimensions[d] - 1u) * _strides[d];
+      last < 0 ? min_computed_index += last : max_computed_index += last;
+    }
+
+    const long long min_buffer_index = min_computed_index >= 0 ? min_computed_index + _offset
+                                                               : min_computed_index * _channels + _offset;
+    Ensures(min_buffer_index >= 0 && static_cast<std::size_t>(min_buffer_index) <= _buffer.size());
+
+    const long long max_buffer_index = max_computed_index * _channels + _offset;
+    Ensures(max_buffer_index >= 0 && static_cast<std::size_t>(max_buffer_index) <= _buffer.size());
+#endif
+  }
+
+  /*
+   * Compares two planes for equality
+   * Parameters:
+   * param lhs: first (left-hand side) plane
+   * param rhs: second (right-hand side) plane
+   * True if the planes are equal, false otherwise
+   */
+  [[nodiscard]] friend bool operator==(const DynamicPlane& lhs, const DynamicPlane& rhs) noexcept {
+    return lhs._buffer == rhs._buffer && lhs._offset == rhs._offset && lhs._dimensions == rhs._dimensions &&
+           lhs._strides == rhs._strides;
+  }
+
+  /*
+   * Creates a copy of this plane with the same underlying structure (same buffer), but with possibly different
+   * extents, dimensions, strides and offset
+   * Parameters:
+   * @tparam Extents: extents used to create the plane
+   * @param dimensions: dimensions used to create the plane
+   * @param strides: strides used to create the plane
+   * @param offset: offset added to/subtracted from the current offset. Affects only the newly created plane
+   * @return: copy of this plane with a possibly different representation
+   */
+  template <typename Extents = _Extents>
+  [[nodiscard]] auto like(const std::array<std::size_t, Extents::rank()>& dimensions,
+                          const std::array<long long, Extents::rank()>& strides, long long offset = 0) const {
+    return DynamicPlane<Buffer, Extents, _channels>{_buffer, dimensions, strides, _offset + offset};
+  }
+
+  /*
+   * Returns the plane's dimensions
+   * Parameters:
+   * @return: plane's dimensions, starting from the innermost dimension
+   */
+  [[nodiscard]] inline const std::array<std::size_t, _rank>& dimensions() const noexcept { return _dimensions; }
+
+  /*
+   * Returns the plane's strides
+   * Parameters:
+   * @return: plane's strides
+   */
+  [[nodiscard]] inline const std::array<long long, _rank>& strides() const noexcept { return _strides; }
+
+  /*
+   * Returns the length of a single dimension. If the length is known at compile time, it's returned as a constant
+   * Parameters:
+   * @tparam N: index of the dimension
+   */
+  template <std::size_t N>
+  [[nodiscard]] inline std::size_t extent() const noexcept {
+    if constexpr (_Extents::template static_extent<N>() != dynamic_extent) {
+      return _Extents::template static_extent<N>();
+    } else {
+      return _dimensions[N];
+    }
+  }
+
+  /*
+   * Returns the stride of a single dimension
+   * Parameters:
+   * @tparam N: index of the dimension
+   */
+  template <std::size_t N>
+  [[nodiscard]] inline long long stride() const noexcept {
+    return _strides[N];
+  }
+
+  /*
+   * Returns the plane's channels
+   * Parameters:
+   * @return: plane's channels
+   */
+  [[nodiscard]] static consteval auto channels() noexcept { return _channels; }
+
+  /*
+   * Returns the plane's buffer offset
+   * Parameters:
+   * @return: plane's buffer offset
+   */
+  [[nodiscard]] inline long long offset() const noexcept { return _offset; }
+
+  /*
+   * Returns the plane's rank
+   */
+  [[nodiscard]] static consteval std::size_t rank() noexcept { return _rank; }
+
+  /*
+   * Returns a reference to the plane's element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the plane's element at the specified location
+   */
+  reference operator[](std::size_t index)
+    requires requires {
+      { _buffer[0u] } -> std::same_as<typename Buffer::reference>;
+    }
+  {
+    return _buffer[index + _offset];
+  }
+
+  /*
+   * Returns a const reference to the plane's element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the plane's element at the specified location
+   */
+  const_reference operator[](std::size_t index) const
+    requires requires {
+      { _buffer[0u] } -> std::same_as<typename Buffer::const_reference>;
+    }
+  {
+    return _buffer[index + _offset];
+  }
+
+  /*
+   * Returns a reference to the plane's element at the specified location, with bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the plane's element at the specified location
+   */
+  reference at(std::size_t index)
+    requires requires {
+      { _buffer.at(0u) } -> std::same_as<typename Buffer::reference>;
+    }
+  {
+    return _buffer.at(index + _offset);
+  }
+
+  /*
+   * Returns a const reference to the plane's element at the specified location, with bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the plane's element at the specified location
+   */
+  const_reference at(std::size_t index) const
+    requires requires {
+      { _buffer.at(0u) } -> std::same_as<typename Buffer::const_reference>;
+    }
+  {
+    return _buffer.at(index + _offset);
+  }
+
+  /*
+   * Returns the effective memory size (buffer size that can be used by the plane)
+   * Parameters:
+   * @return: plane's effective size
+   */
+  [[nodiscard]] inline std::size_t effective_size() const noexcept { return _buffer.size() - std::abs(_offset); }
+
+  /*
+   * Returns the total allocated buffer size
+   * Parameters:
+   * @return: total allocated size
+   */
+  [[nodiscard]] inline std::size_t real_size() const noexcept { return _buffer.size(); }
+
+  /*
+   * Returns the plane's buffer
+   * Parameters:
+   * @return: reference to the buffer representing the plane's memory
+   */
+  [[nodiscard]] inline Buffer& buffer() noexcept { return _buffer; }
+
+  /*
+   * Returns the plane's buffer
+   * Parameters:
+   * @return: const reference to the buffer representing the plane's memory
+   */
+  [[nodiscard]] inline const Buffer& buffer() const noexcept { return _buffer; }
+};
+
+inline namespace internal {
+
+/*
+ * Checks whether a type is a DynamicPlane
+ */
+template <typename>
+struct is_dynamic_plane : std::false_type {};
+
+template <typename Buffer, typename Extents, std::size_t channels>
+struct is_dynamic_plane<DynamicPlane<Buffer, Extents, channels>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_dynamic_plane_v = is_dynamic_plane<std::remove_cvref_t<T>>::value;
+
+/*
+ * Returns the length of the Nth dimension of a Plane or a DynamicPlane
+ * For a Plane (and for the static extents of a DynamicPlane), the length is a constant
+ * Parameters:
+ * @tparam N: index of the dimension
+ * @param plane: plane whose dimension is returned
+ */
+template <std::size_t N, typename Plane>
+[[nodiscard]] inline std::size_t plane_extent(const Plane& plane) noexcept {
+  if constexpr (is_dynamic_plane_v<Plane>) {
+    return plane.template extent<N>();
+  } else {
+    return static_cast<std::size_t>(std::decay_t<Plane>::dimensions().template at<N>());
+  }
+}
+
+/*
+ * Returns the stride of the Nth dimension of a Plane or a DynamicPlane
+ * For a Plane, the stride is a constant
+ * Parameters:
+ * @tparam N: index of the dimension
+ * @param plane: plane whose stride is returned
+ */
+template <std::size_t N, typename Plane>
+[[nodiscard]] inline long long plane_stride(const Plane& plane) noexcept {
+  if constexpr (is_dynamic_plane_v<Plane>) {
+    return plane.template stride<N>();
+  } else {
+    return std::decay_t<Plane>::strides().template at<N>();
+  }
+}
+
+/*
+ * Returns the number of elements of a Plane or a DynamicPlane (without channels)
+ * Parameters:
+ * @param plane: plane whose elements are counted
+ */
+template <typename Plane>
+[[nodiscard]] inline std::size_t plane_elements(const Plane& plane) noexcept {
+  return [&plane]<std::size_t... is>(std::index_sequence<is...>) {
+    return (plane_extent<is>(plane) * ...);
+  }(std::make_index_sequence<std::decay_t<Plane>::rank()>());
+}
+
+/*
+ * Returns the dimensions of a Plane or a DynamicPlane as an array
+ * Parameters:
+ * @param plane: plane whose dimensions are returned
+ */
+template <typename Plane>
+[[nodiscard]] inline auto plane_dimensions(const Plane& plane) noexcept {
+  return [&plane]<std::size_t... is>(std::index_sequence<is...>) {
+    return std::array<std::size_t, sizeof...(is)>{plane_extent<is>(plane)...};
+  }(std::make_index_sequence<std::decay_t<Plane>::rank()>());
+}
+
+/*
+ * Returns the strides of a Plane or a DynamicPlane as an array
+ * Parameters:
+ * @param plane: plane whose strides are returned
+ */
+template <typename Plane>
+[[nodiscard]] inline auto plane_strides(const Plane& plane) noexcept {
+  return [&plane]<std::size_t... is>(std::index_sequence<is...>) {
+    return std::array<long long, sizeof...(is)>{plane_stride<is>(plane)...};
+  }(std::make_index_sequence<std::decay_t<Plane>::rank()>());
+}
+
+/*
+ * Removes a dimension from a DynamicPlane, keeping only the elements at the given position of that dimension
+ * Parameters:
+ * @tparam dimension_to_skip: dimension that has to be removed from the plane
+ * @param plane: sliced plane
+ * @param dimensional_offset: offset used instead of the removed dimension
+ * @return: plane with one dimension less
+ */
+template <std::size_t dimension_to_skip, typename Plane>
+[[nodiscard]] auto slice_dynamic_plane(const Plane& plane, std::size_t dimensional_offset) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  using sliced_extents = decltype(remove_nth_extent<dimension_to_skip>(typename plane_type::extents_type{}));
+
+#ifdef ENABLE_NT_EXPECTS
+  Expects(dimensional_offset < plane.template extent<dimension_to_skip>());
+#endif
+
+  std::array<std::size_t, rank - 1u> dimensions{};
+  std::array<long long, rank - 1u> strides{};
+  for (std::size_t d = 0u, i = 0u; d < rank; ++d) {
+    if (d == dimension_to_skip) continue;
+    dimensions[i] = plane.dimensions()[d];
+    strides[i++] = plane.strides()[d];
+  }
+
+  return plane.template like<sliced_extents>(
+      dimensions, strides,
+      static_cast<long long>(dimensional_offset) * plane.template stride<dimension_to_skip>() * plane.channels());
+}
+
+/*
+ * Creates a view of a single element of a DynamicPlane's outermost dimension
+ * This overload is preferred over the one used for planes whose dimensions are known at compile time
+ * Parameters:
+ * @param plane: sliced plane
+ * @param i: position in the outermost dimension
+ * @return: plane with one dimension less
+ */
+template <typename Buffer, typename Extents, std::size_t channels>
+  requires(Extents::rank() > 1u)
+[[nodiscard]] inline auto slice_outermost(const DynamicPlane<Buffer, Extents, channels>& plane, std::size_t i) {
+  return slice_dynamic_plane<Extents::rank() - 1u>(plane, i);
+}
+
+}  // namespace internal
+
+/*
+ * Helper method used for creating a DynamicPlane
+ * Parameters:
+ * @tparam BufferType: Type of the underlying buffer
+ * @tparam Extents: Extents of the newly created plane
+ * @tparam channels: Number of channels fo the newly created plane
+ * @tparam aligned_strides: Variable determining whether the plane should have aligned or unaligned strides
+ * @param dimensions: Dimensions of the newly created plane, starting from the innermost dimension
+ * @param offset: offset needed to access the first plane element in the buffer
+ */
+template <typename BufferType, typename Extents, std::size_t channels = 1u, bool aligned_strides = true>
+[[nodiscard]] auto create_dynamic_plane(const std::array<std::size_t, Extents::rank()>& dimensions,
+                                        long long offset = 0) {
+  const auto strides = [&dimensions] {
+    if constexpr (aligned_strides) {
+      return compute_aligned_strides<typename BufferType::value_type>(dimensions);
+    } else {
+      return compute_unaligned_strides(dimensions);
+    }
+  }();
+
+  long long max_size = 0;
+  for (std::size_t d = 0u; d < Extents::rank(); ++d) {
+    max_size = std::max(max_size, static_cast<long long>(dimensions[d]) * strides[d]);
+  }
+
+  BufferType buffer{static_cast<std::size_t>(max_size) * channels};
+  return DynamicPlane<BufferType, Extents, channels>{std::move(buffer), dimensions, strides, offset};
+}
+
+/*
+ * Creates a DynamicPlane that shares the buffer of a Plane, and has the same dimensions, strides and offset
+ * Parameters:
+ * @param plane: plane whose dimensions are known at compile time
+ * @return: DynamicPlane whose extents are all dynamic
+ */
+template <typename Plane>
+  requires(!is_dynamic_plane_v<Plane>)
+[[nodiscard]] auto to_dynamic_plane(const Plane& plane) {
+  using plane_type = std::decay_t<Plane>;
+  return DynamicPlane<typename plane_type::buffer_type, DynamicExtents<plane_type::rank()>, plane_type::channels()>{
+      plane.buffer(), plane_dimensions(plane), plane_strides(plane), plane.offset()};
+}
+
+/*
+ * Calls an invocable with a Plane whose dimensions and strides are known at compile time, if a DynamicPlane matches one
+ * of the given shapes. Otherwise, the invocable is called with the DynamicPlane itself
+ * A shape matches if the plane has the same dimensions, and either aligned or unaligned strides (as created by
+ * create_plane). The Plane shares the buffer and the offset of the DynamicPlane, so nothing is copied. Code executed on
+ * the Plane uses constant bounds and strides (and can be vectorized), so the shapes that are used most frequently can
+ * be precompiled, while all other shapes are still supported by a single instantiation of the invocable
+ * Parameters:
+ * @tparam shapes: precompiled shapes
+ * @param plane: DynamicPlane that's dispatched
+ * @param invocable: invocable called with either a Plane or the DynamicPlane
+ * @return: true if the plane matched one of the shapes, false otherwise
+ */
+template <Dimensions... shapes, typename _Plane, typename Invocable>
+  requires(is_dynamic_plane_v<_Plane>)
+bool dispatch_static(_Plane&& plane, Invocable&& invocable) {
+  using plane_type = std::decay_t<_Plane>;
+  using buffer_type = typename plane_type::buffer_type;
+  using value_type = std::remove_const_t<typename plane_type::value_type>;
+  static constexpr std::size_t channels = plane_type::channels();
+
+  auto try_shape = [&plane, &invocable]<auto shape>() {
+    if constexpr (shape.rank() != plane_type::rank()) {
+      return false;
+    } else {
+      static constexpr auto dimensions = [] {
+        return []<std::size_t... is>(std::index_sequence<is...>) {
+          return std::array<std::size_t, sizeof...(is)>{static_cast<std::size_t>(shape.template at<is>())...};
+        }(std::make_index_sequence<shape.rank()>());
+      }();
+
+      if (plane.dimensions() != dimensions) {
+        return false;
+      }
+
+      static constexpr auto aligned_strides = compute_aligned_strides<value_type>(shape);
+      static constexpr auto unaligned_strides = compute_unaligned_strides(shape);
+
+      if (plane.strides() == compute_aligned_strides<value_type>(dimensions)) {
+        invocable(Plane<buffer_type, shape, aligned_strides, channels>{plane.buffer(), plane.offset()});
+        return true;
+      }
+
+      if (plane.strides() == compute_unaligned_strides(dimensions)) {
+        invocable(Plane<buffer_type, shape, unaligned_strides, channels>{plane.buffer(), plane.offset()});
+        return true;
+      }
+
+      return false;
+    }
+  };
+
+  if ((try_shape.template operator()<shapes>() || ...)) {
+    return true;
+  }
+
+  invocable(std::forward<_Plane>(plane));
+  return false;
+}
+
+}  // namespace ntensor
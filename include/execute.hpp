@@ -1,5 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "dynamic_plane.hpp"
+#include "execution_policy.hpp"
+#include "simd.hpp"
 #include "strides.hpp"
 
 namespace ntensor {
@@ -26,8 +39,9 @@ inline namespace internal {
  * innermost dimension, which represents the columns So the final position of the element in the array is: [2][2][0],
  * where [0] is the outtermost dimension
  *
- * TODO:
- * Try to optimize this algorithm. It's used inside a loop.
+ * Note:
+ * The method requires a division and a modulo per dimension. When iterating consecutive elements, use the
+ * position_counter class instead, which computes the positions with additions only
  *
  * Parameters:
  * @tparam us: unaligned strides (offsets) of the multidimensional array
@@ -56,6 +70,252 @@ template <std::size_t channels, long long... us, long long... as>
   return position;
 }
 
+/*
+ * Multi-index counter (odometer) used for iterating the elements of a plane in their logical order
+ * Instead of computing the position of each element from its index (which requires a division and a modulo per
+ * dimension), the counter keeps the current multi-index and the current position, and updates them with additions only.
+ * When the index of a dimension reaches the length of the dimension, it's reset to 0 and the carry is propagated to the
+ * next dimension. The carry propagation is unrolled at compile time
+ * The dimensions and strides of a Plane are constants. The counter of a DynamicPlane stores a copy of them, so it has
+ * to be created from the plane
+ * Parameters:
+ * @tparam Plane: type of the iterated plane
+ */
+template <typename Plane>
+class position_counter {
+ private:
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  static constexpr long long channels = plane_type::channels();
+  static constexpr bool dynamic = is_dynamic_plane_v<plane_type>;
+
+  /*
+   * Dimensions and strides of a DynamicPlane
+   */
+  struct dynamic_layout {
+    std::array<std::size_t, rank> dimensions{};
+    std::array<long long, rank> strides{};
+  };
+
+  struct static_layout {};
+
+  std::array<std::size_t, rank> _indexes{};
+  long long _position{};
+  [[no_unique_address]] std::conditional_t<dynamic, dynamic_layout, static_layout> _layout{};
+
+  /*
+   * Returns the length of the Nth dimension
+   */
+  template <std::size_t N>
+  [[nodiscard]] inline std::size_t dimension() const noexcept {
+    if constexpr (!dynamic) {
+      return plane_type::dimensions().template at<N>();
+    } else if constexpr (plane_type::extents_type::template static_extent<N>() != dynamic_extent) {
+      return plane_type::extents_type::template static_extent<N>();
+    } else {
+      return _layout.dimensions[N];
+    }
+  }
+
+  /*
+   * Returns the stride of the Nth dimension, multiplied by the number of channels
+   */
+  template <std::size_t N>
+  [[nodiscard]] inline long long stride() const noexcept {
+    if constexpr (!dynamic) {
+      return plane_type::strides().template at<N>() * channels;
+    } else {
+      return _layout.strides[N] * channels;
+    }
+  }
+
+  /*
+   * Increments the index of the Nth dimension, and propagates the carry to the next dimension if needed
+   */
+  template <std::size_t N>
+  inline void increment() noexcept {
+    _position += stride<N>();
+
+    if constexpr (N + 1u < rank) {
+      if (++_indexes[N] == dimension<N>()) [[unlikely]] {
+        _indexes[N] = 0u;
+        _position -= static_cast<long long>(dimension<N>()) * stride<N>();
+        increment<N + 1u>();
+      }
+    } else {
+      ++_indexes[N];
+    }
+  }
+
+  /*
+   * Moves the counter from the first element to the element with the specified index
+   */
+  inline void seek(std::size_t index) noexcept {
+    [this, &index]<std::size_t... is>(std::index_sequence<is...>) {
+      ((_indexes[is] = index % dimension<is>(), index /= dimension<is>(),
+        _position += static_cast<long long>(_indexes[is]) * stride<is>()),
+       ...);
+    }(std::make_index_sequence<rank>());
+  }
+
+ public:
+  /*
+   * Creates a counter pointing to the element with the specified index
+   * This is the only place where divisions are used, so the counters should be created once per iterated range
+   * Parameters:
+   * @param index: index of the element, in the logical order of the plane's elements (without channels)
+   */
+  explicit position_counter(std::size_t index = 0u) noexcept
+    requires(!dynamic)
+  {
+    seek(index);
+  }
+
+  /*
+   * Creates a counter of the given plane, pointing to the element with the specified index
+   * Parameters:
+   * @param plane: iterated plane
+   * @param index: index of the element, in the logical order of the plane's elements (without channels)
+   */
+  explicit position_counter(const plane_type& plane, std::size_t index = 0u) noexcept {
+    if constexpr (dynamic) {
+      _layout.dimensions = plane.dimensions();
+      _layout.strides = plane.strides();
+    }
+    seek(index);
+  }
+
+  /*
+   * Returns the position of the current element's first channel
+   * Parameters:
+   * @return: position of the current element
+   */
+  [[nodiscard]] inline long long position() const noexcept { return _position; }
+
+  /*
+   * Returns the multi-index of the current element
+   * Parameters:
+   * @return: multi-index of the current element, starting from the innermost dimension
+   */
+  [[nodiscard]] inline const std::array<std::size_t, rank>& indexes() const noexcept { return _indexes; }
+
+  /*
+   * Moves the counter to the next element
+   */
+  inline void advance() noexcept { increment<0u>(); }
+};
+
+/*
+ * Returns the first plane of a sequence of planes
+ * Parameters:
+ * @param plane: first plane
+ * @param planes: remaining planes
+ */
+template <typename Plane, typename... Planes>
+[[nodiscard]] inline const Plane& first_plane(const Plane& plane, const Planes&...) noexcept {
+  return plane;
+}
+
+/*
+ * Maximum number of elements (channels included) of the planes whose iteration is fully unrolled
+ * For planes this small (3x3 or 4x4 transforms, single pixels), the loops and the batching of the generic iteration
+ * cost more than the invocable itself
+ */
+inline constexpr std::size_t unrolled_execute_max_elements = 64u;
+
+/*
+ * Checks whether the iteration of the planes can be fully unrolled: the dimensions and strides of all planes have to be
+ * known at compile time, and the planes have to have at most unrolled_execute_max_elements elements
+ * Parameters:
+ * @tparam Planes: types of the planes
+ */
+template <typename... Planes>
+[[nodiscard]] consteval bool is_unrollable() noexcept {
+  if constexpr ((is_dynamic_plane_v<Planes> || ...)) {
+    return false;
+  } else {
+    using first_plane_type = std::decay_t<fts_t<Planes...>>;
+    return product(first_plane_type::dimensions()) * first_plane_type::channels() <= unrolled_execute_max_elements;
+  }
+}
+
+/*
+ * Computes the position of an element in a plane, given the index of the element in the logical order of the plane's
+ * elements (channels included)
+ * Parameters:
+ * @tparam Plane: type of the plane
+ * @param index: index of the element
+ */
+template <typename Plane>
+[[nodiscard]] consteval long long unrolled_position(std::size_t index) noexcept {
+  using plane_type = std::decay_t<Plane>;
+  constexpr std::size_t channels = plane_type::channels();
+  constexpr auto dimensions = plane_type::dimensions();
+  constexpr auto strides = plane_type::strides();
+
+  const std::size_t channel = index % channels;
+  index /= channels;
+
+  long long position = 0;
+  [&position, &index, dimensions, strides]<std::size_t... is>(std::index_sequence<is...>) {
+    ((position += static_cast<long long>(index % dimensions.template at<is>()) * strides.template at<is>(),
+      index /= dimensions.template at<is>()),
+     ...);
+  }(std::make_index_sequence<plane_type::rank()>());
+
+  return position * static_cast<long long>(channels) + static_cast<long long>(channel);
+}
+
+/*
+ * Calls an invocable on every element of several small planes, without any loops
+ * The positions of all elements are computed at compile time, and the calls are expanded by a fold expression. The
+ * planes only have to have the same number of elements, so both planes with equal dimensions and planes with different
+ * dimensions are iterated in the logical order of their elements
+ * Parameters:
+ * @param invocable: Invocable called on each element of a plane/s
+ * @param planes: Variadic number of planes
+ * Constraints:
+ * is_unrollable has to be satisfied
+ */
+template <typename Invocable, typename... Planes>
+inline void unrolled_execute(Invocable&& invocable, Planes&&... planes) {
+  using first_plane_type = std::decay_t<fts_t<Planes...>>;
+  static constexpr std::size_t N = product(first_plane_type::dimensions()) * first_plane_type::channels();
+
+  const auto invoke = [&invocable, &planes...]<std::size_t index>() {
+    invocable(planes.at(unrolled_position<Planes>(index))...);
+  };
+  [&invoke]<std::size_t... is>(std::index_sequence<is...>) {
+    (invoke.template operator()<is>(), ...);
+  }(std::make_index_sequence<N>());
+}
+
+/*
+ * Iterates the elements in the range [first, last) of multiple planes simultaneously, whose dimensions don't match, but
+ * have the same product. The range is expressed in the number of elements of an unpadded plane (without channels)
+ * Parameters:
+ * @param invocable: Invocable called on each element of a plane/s
+ * @param first: index of the first iterated element
+ * @param last: index following the last iterated element
+ * @param planes: Variadic number of planes
+ */
+template <typename Invocable, typename... Planes>
+void iterative_execute_range(Invocable&& invocable, std::size_t first, std::size_t last, Planes&&... planes) {
+  using first_plane_type = std::decay_t<fts_t<Planes...>>;
+  static constexpr std::size_t channels = first_plane_type::channels();
+
+  [first, last, &invocable, &planes...]<std::size_t... is>(std::index_sequence<is...>) {
+    std::tuple counters{position_counter<Planes>{planes, first}...};
+
+    for (std::size_t idx = first; idx < last; ++idx) {
+      for (std::size_t c = 0u; c < channels; ++c) {
+        invocable(planes.at(std::get<is>(counters).position() + c)...);
+      }
+      (std::get<is>(counters).advance(), ...);
+    }
+  }(std::make_index_sequence<sizeof...(Planes)>());
+}
+
 /*
  * Specialization of the execute method that supports iterating multiple planes simultaneously, whose dimensions don't
  * match, but have the same product. For example, let's say that we have the first plane containing dimensions [2, 2,
@@ -66,23 +326,135 @@ template <std::size_t channels, long long... us, long long... as>
  */
 template <typename Invocable, typename... Planes>
 void iterative_execute(Invocable&& invocable, Planes&&... planes) {
-  using first_plane_type = std::decay_t<fts_t<Planes...>>;
-  static constexpr std::size_t N = product(first_plane_type::dimensions());
-  static constexpr std::size_t channels = first_plane_type::channels();
-  static constexpr std::tuple strides{std::decay_t<Planes>::strides()...};
-  static constexpr std::tuple unaligned_strides{compute_unaligned_strides(std::decay_t<Planes>::dimensions())...};
-
-  for (std::size_t idx = 0u; idx < N; ++idx) {
-    for (std::size_t c = 0u; c < channels; ++c) {
-      [c, idx, &invocable, &planes...]<std::size_t... is>(std::index_sequence<is...>) {
-        const std::array positions{compute_array_position_from_index<channels>(std::get<is>(unaligned_strides),
-                                                                               std::get<is>(strides), c, idx)...};
-        invocable(planes.at(positions[is])...);
-      }(std::make_index_sequence<sizeof...(Planes)>());
-    }
+  if constexpr (is_unrollable<Planes...>()) {
+    unrolled_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+  } else {
+    const std::size_t N = plane_elements(first_plane(planes...));
+    iterative_execute_range(std::forward<Invocable>(invocable), 0u, N, std::forward<Planes>(planes)...);
+  }
+}
+
+/*
+ * Creates a view of a single element of a plane's outermost dimension, using the plane's own dimensions and strides
+ * Planes iterated simultaneously only have to have equal dimensions, so each plane has to be sliced with its own
+ * strides
+ * Parameters:
+ * @param plane: sliced plane
+ * @param i: position in the outermost dimension
+ * @return: plane with one dimension less
+ */
+template <typename Plane>
+[[nodiscard]] inline auto slice_outermost(const Plane& plane, std::size_t i) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+
+  return plane.template like<remove_nth_element<rank - 1u>(plane_type::dimensions()),
+                             remove_nth_element<rank - 1u>(plane_type::strides())>(
+      i * plane_type::strides().template at<rank - 1u>() * plane_type::channels());
+}
+
+/*
+ * Checks whether the elements of a plane can't be written through it, either because the plane is const, or because
+ * its buffer only returns read-only references (for example, a MappedBuffer with the read_only mode)
+ */
+template <typename Plane>
+[[nodiscard]] consteval bool is_read_only_plane() noexcept {
+  return std::is_same_v<decltype(std::declval<Plane&>().at(0u)), typename std::decay_t<Plane>::const_reference>;
+}
+
+/*
+ * Checks whether the elements of a plane along its innermost dimension are loop invariants: the innermost stride of the
+ * plane is 0 (for example, if the plane is broadcast along that dimension), and the elements are read-only values, so
+ * they can't change while the innermost dimension is iterated
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval bool is_invariant_operand() noexcept {
+  using plane_type = std::decay_t<Plane>;
+
+  if constexpr (is_dynamic_plane_v<plane_type>) {
+    return false;
+  } else {
+    return plane_type::strides().template at<0u>() == 0 &&
+           std::is_const_v<std::remove_reference_t<decltype(std::declval<Plane&>().at(0u))>> &&
+           std::is_arithmetic_v<std::remove_const_t<typename plane_type::value_type>>;
   }
 }
 
+/*
+ * Copy of the elements of a plane whose innermost dimension is iterated, for a plane satisfying is_invariant_operand
+ * All positions of the innermost dimension map to the same elements, so only the channels have to be stored
+ * Parameters:
+ * @tparam T: type of the elements
+ * @tparam channels: number of channels of the plane
+ */
+template <typename T, std::size_t channels>
+struct invariant_operand {
+  std::array<T, channels> values;
+
+  /*
+   * Returns the element of the channel at the specified position
+   * Parameters:
+   * @param position: position of the element, which is the channel since the innermost stride is 0
+   */
+  [[nodiscard]] const T& at(std::size_t position) const noexcept { return values[position]; }
+};
+
+/*
+ * Loads the elements of a plane satisfying is_invariant_operand into an invariant_operand, so that they're read only
+ * once per innermost dimension. Other planes are returned as they are
+ * Without the copy, the elements would have to be reloaded for each call of the invocable, since the compiler can't
+ * prove that the writes to the other planes don't modify them
+ * Parameters:
+ * @param plane: plane whose innermost dimension is iterated
+ */
+template <typename Plane>
+[[nodiscard]] inline decltype(auto) hoist_invariant(Plane&& plane) {
+  using plane_type = std::decay_t<Plane>;
+
+  if constexpr (is_invariant_operand<Plane>()) {
+    return [&plane]<std::size_t... cs>(std::index_sequence<cs...>) {
+      return invariant_operand<std::remove_const_t<typename plane_type::value_type>, plane_type::channels()>{
+          {plane.at(cs)...}};
+    }(std::make_index_sequence<plane_type::channels()>());
+  } else {
+    return std::forward<Plane>(plane);
+  }
+}
+
+/*
+ * Iterates the elements in the range [first, last) of the innermost dimension of several planes simultaneously
+ * The planes have to be of rank 1 and have the same dimensions. The elements of read-only planes with an innermost
+ * stride of 0 are loaded only once (see hoist_invariant)
+ * Parameters:
+ * @param invocable: Invocable called on each element of a plane/s
+ * @param first: index of the first iterated element
+ * @param last: index following the last iterated element
+ * @param planes: Variadic number of planes
+ */
+template <typename Invocable, typename... _Planes>
+void innermost_execute(Invocable&& invocable, std::size_t first, std::size_t last, _Planes&&... planes) {
+  using planes_type = std::decay_t<fts_t<_Planes...>>;
+  static_assert(planes_type::rank() == 1u);
+  static constexpr std::size_t batch_size =
+      (NT_ALIGNMENT / sizeof(typename planes_type::value_type)) / planes_type::channels();
+  // The batch_size has to be at least 1, otherwise we won't iterate any elements
+  static_assert(batch_size > 0u);
+
+  [&invocable, first, last, &planes...](auto&&... operands) mutable {
+    while (last - first > batch_size) {
+      for (std::size_t d = first; d < first + batch_size; ++d)
+        for (std::size_t c = 0u; c < planes_type::channels(); ++c)
+          invocable(operands.at(d * plane_stride<0u>(planes) * planes_type::channels() + c)...);
+      first += batch_size;
+    }
+    for (std::size_t d = first; d < last; ++d)
+      for (std::size_t c = 0u; c < planes_type::channels(); ++c)
+        invocable(operands.at(d * plane_stride<0u>(planes) * planes_type::channels() + c)...);
+  }(hoist_invariant(planes)...);
+}
+
 /*
  * Specialization of the execute method that supports iterating several planes simultaenously
  * However, it has the restriction that all of the planes have to have the same dimensions
@@ -95,73 +467,535 @@ void recursive_execute(Invocable&& invocable, _Planes&&... planes) {
   using planes_type = std::decay_t<fts_t<_Planes...>>;
   static constexpr std::size_t rank = planes_type::rank();
 
+  const std::size_t extent = plane_extent<rank - 1u>(first_plane(planes...));
+
   if constexpr (rank > 1u) {
-    for (std::size_t i = 0u; i < planes_type::dimensions().template at<rank - 1U>(); ++i) {
-      recursive_execute(invocable,
-                        planes.template like<remove_nth_element<rank - 1u>(planes_type::dimensions()),
-                                             remove_nth_element<rank - 1u>(planes_type::strides())>(
-                            i * planes_type::strides().template at<rank - 1u>() * planes_type::channels())...);
+    for (std::size_t i = 0u; i < extent; ++i) {
+      recursive_execute(invocable, slice_outermost(planes, i)...);
     }
   } else if constexpr (rank == 1U) {
-    static constexpr std::size_t dimension = planes_type::dimensions().template at<0u>();
-    static constexpr std::size_t batch_size =
-        (NT_ALIGNMENT / sizeof(typename planes_type::value_type)) / planes_type::channels();
-    // The batch_size has to be at least 1, otherwise we won't iterate any elements
-    static_assert(batch_size > 0u);
-    if constexpr (dimension <= batch_size)
-      for (std::size_t d = 0u; d < dimension; ++d)
-        for (std::size_t c = 0u; c < planes_type::channels(); ++c)
-          invocable(planes.at(d * planes_type::strides().template at<0u>() * planes_type::channels() + c)...);
-    else {
-      std::size_t iter_size = dimension;
-      std::size_t curr_iter = 0u;
-
-      while (iter_size > batch_size) {
-        for (std::size_t d = curr_iter; d < curr_iter + batch_size; ++d)
-          for (std::size_t c = 0u; c < planes_type::channels(); ++c)
-            invocable(planes.at(d * planes_type::strides().template at<0u>() * planes_type::channels() + c)...);
-        iter_size -= batch_size;
-        curr_iter += batch_size;
+    innermost_execute(invocable, 0u, extent, planes...);
+  }
+}
+
+/*
+ * Checks whether the elements of the planes can be iterated using simd packs
+ * This is possible if the elements of the innermost dimension are stored contiguously (the innermost stride is equal
+ * to 1), if the planes' buffers expose their memory (like the DenseBuffer), and if the invocable is marked as accepting
+ * packs (see vectorized) and can be called with packs instead of elements. Read-only planes with a single channel can
+ * have an innermost stride of 0 as well (the first plane excluded), since their element is broadcast into a pack (see
+ * is_invariant_operand). The strides of a DynamicPlane aren't known at compile time, so DynamicPlanes are iterated
+ * element by element (see dispatch_static)
+ * The packs of all planes that aren't read-only are stored after each call, since it isn't known which of them the
+ * invocable modified. Storing the packs of planes that are only read costs more than the packs save, so if more than
+ * one plane can be written, the elements are iterated one by one (operands that are only read should be passed as
+ * const tensors)
+ * Parameters:
+ * @tparam Invocable: invocable called on the elements of the planes
+ * @tparam Planes: types of the planes
+ */
+template <typename Invocable, typename... Planes>
+[[nodiscard]] consteval bool is_vectorizable() noexcept {
+  // Unmarked invocables are never instantiated with packs
+  if constexpr (!is_vectorized_invocable_v<Invocable> || (is_dynamic_plane_v<Planes> || ...)) {
+    return false;
+  } else {
+    constexpr auto is_contiguous = []<typename Plane>(std::type_identity<Plane>) {
+      return std::decay_t<Plane>::strides().template at<0u>() == 1 ||
+             (is_invariant_operand<Plane>() && std::decay_t<Plane>::channels() == 1u);
+    };
+    constexpr bool contiguous = std::decay_t<fts_t<Planes...>>::strides().template at<0u>() == 1 &&
+                                (is_contiguous(std::type_identity<Planes>{}) && ...);
+    constexpr bool exposes_memory = (contiguous_buffer<typename std::decay_t<Planes>::buffer_type> && ...);
+    constexpr bool single_output = (static_cast<std::size_t>(!is_read_only_plane<Planes>()) + ...) <= 1u;
+
+    if constexpr (contiguous && exposes_memory && single_output) {
+      constexpr std::size_t width = std::min({simd_width_v<typename std::decay_t<Planes>::value_type>...});
+      return std::is_invocable_v<Invocable, simd_pack<typename std::decay_t<Planes>::value_type, width>&...>;
+    } else {
+      return false;
+    }
+  }
+}
+
+/*
+ * Stores a pack to memory. Packs loaded from read-only planes aren't stored
+ * Parameters:
+ * @param pack: pack that was passed to an invocable
+ * @param ptr: location from which the pack was loaded
+ */
+template <typename Pack, typename T>
+inline void store_if_mutable(const Pack& pack, T* ptr) noexcept {
+  if constexpr (!std::is_const_v<T>) {
+    pack.store(ptr);
+  }
+}
+
+/*
+ * Creates the pack passed to the invocable for a plane satisfying is_invariant_operand, whose element is the same for
+ * all positions of the innermost dimension. For other planes, nothing is created
+ * Parameters:
+ * @tparam width: number of values in a pack
+ * @tparam Plane: type of the plane
+ * @param ptr: location of the plane's element
+ */
+template <std::size_t width, typename Plane, typename T>
+[[nodiscard]] inline auto invariant_pack(const T* ptr) noexcept {
+  if constexpr (is_invariant_operand<Plane>()) {
+    return simd_pack<std::remove_const_t<T>, width>{*ptr};
+  } else {
+    return nullptr;
+  }
+}
+
+/*
+ * Loads the pack passed to the invocable from a plane. The pack of a plane satisfying is_invariant_operand is a copy of
+ * its invariant pack, since the invocable is allowed to modify the packs it receives
+ * Parameters:
+ * @tparam width: number of values in a pack
+ * @tparam Plane: type of the plane
+ * @param ptr: location of the first of the loaded elements
+ * @param invariant: result of invariant_pack for the plane
+ */
+template <std::size_t width, typename Plane, typename T, typename Invariant>
+[[nodiscard]] inline auto load_operand(T* ptr, const Invariant& invariant) noexcept {
+  if constexpr (is_invariant_operand<Plane>()) {
+    return invariant;
+  } else {
+    return simd_pack<std::remove_const_t<T>, width>::load(ptr);
+  }
+}
+
+/*
+ * Returns the plane as a const reference if the plane it was sliced from is const, so that the read-only planes stay
+ * read-only in the recursive calls (and their packs are never stored)
+ * Parameters:
+ * @tparam Source: type of the plane from which the plane was sliced
+ * @param plane: sliced plane
+ */
+template <typename Source, typename Plane>
+[[nodiscard]] inline decltype(auto) propagate_const(Plane&& plane) noexcept {
+  if constexpr (std::is_const_v<std::remove_reference_t<Source>>) {
+    return static_cast<const std::remove_reference_t<Plane>&>(plane);
+  } else {
+    return std::forward<Plane>(plane);
+  }
+}
+
+/*
+ * Calls an invocable with packs of consecutive elements of several planes, and stores the packs of the planes that
+ * aren't read-only
+ * Parameters:
+ * @tparam width: number of values in a pack
+ * @tparam _Planes: types of the planes
+ * @param invocable: Invocable called with the packs
+ * @param pointers: tuple of pointers to the first element of the innermost dimension of each plane
+ * @param invariant_packs: tuple of the results of invariant_pack for each plane
+ * @param i: position of the first element of the packs in the innermost dimension
+ */
+template <std::size_t width, typename... _Planes, typename Invocable, typename Pointers, typename Invariants>
+inline void invoke_packs(Invocable& invocable, const Pointers& pointers, const Invariants& invariant_packs,
+                         std::size_t i) {
+  [&]<std::size_t... is>(std::index_sequence<is...>) {
+    std::tuple packs{load_operand<width, _Planes>(std::get<is>(pointers) + i, std::get<is>(invariant_packs))...};
+    invocable(std::get<is>(packs)...);
+    (store_if_mutable(std::get<is>(packs), std::get<is>(pointers) + i), ...);
+  }(std::make_index_sequence<sizeof...(_Planes)>());
+}
+
+/*
+ * Iterates a dimension of several planes through pointers to their elements, passing simd packs of consecutive
+ * elements of the innermost dimension to the invocable (see vectorized_execute)
+ * The elements of each innermost dimension (including the channels) are processed in three steps: scalar elements are
+ * processed until the first plane's memory is aligned to the size of a pack, then full packs are processed, and finally
+ * the remaining elements are processed by packs of halving widths (each used at most once) and a single element
+ * Parameters:
+ * @tparam dimension: iterated dimension
+ * @tparam _Planes: types of the planes
+ * @param invocable: Invocable called with packs and with single elements of a plane/s
+ * @param pointers: tuple of pointers to the first element of the iterated dimension of each plane
+ */
+template <std::size_t dimension, typename... _Planes, typename Invocable, typename Pointers>
+void vectorized_execute_dimension(Invocable& invocable, const Pointers& pointers) {
+  using planes_type = std::decay_t<fts_t<_Planes...>>;
+
+  if constexpr (dimension > 0u) {
+    for (std::size_t i = 0u; i < planes_type::dimensions().template at<dimension>(); ++i) {
+      vectorized_execute_dimension<dimension - 1u, _Planes...>(
+          invocable, [&pointers, i]<std::size_t... is>(std::index_sequence<is...>) {
+            return std::tuple{std::get<is>(pointers) + static_cast<std::ptrdiff_t>(i) *
+                                                           std::decay_t<_Planes>::strides().template at<dimension>() *
+                                                           static_cast<std::ptrdiff_t>(planes_type::channels())...};
+          }(std::make_index_sequence<sizeof...(_Planes)>()));
+    }
+  } else {
+    static constexpr std::size_t width = std::min({simd_width_v<typename std::decay_t<_Planes>::value_type>...});
+    static constexpr std::size_t length = planes_type::dimensions().template at<0u>() * planes_type::channels();
+    static constexpr std::size_t pack_bytes = width * sizeof(typename planes_type::value_type);
+
+    // Number of scalar elements processed before the first plane's memory is aligned to the size of a pack
+    const auto address = reinterpret_cast<std::uintptr_t>(std::get<0u>(pointers));
+    const std::size_t head =
+        address % sizeof(typename planes_type::value_type)
+            ? 0u
+            : std::min((pack_bytes - address % pack_bytes) % pack_bytes / sizeof(typename planes_type::value_type),
+                       length);
+
+    // The innermost stride of each plane is either 1 or 0 (see is_vectorizable)
+    static constexpr std::array<std::size_t, sizeof...(_Planes)> strides{
+        static_cast<std::size_t>(std::decay_t<_Planes>::strides().template at<0u>())...};
+
+    [&]<std::size_t... is>(std::index_sequence<is...>) {
+      std::size_t i = 0u;
+
+      for (; i < head; ++i) {
+        invocable(std::get<is>(pointers)[i * strides[is]]...);
       }
-      for (std::size_t d = curr_iter; d < curr_iter + iter_size; ++d)
-        for (std::size_t c = 0u; c < planes_type::channels(); ++c)
-          invocable(planes.at(d * planes_type::strides().template at<0u>() * planes_type::channels() + c)...);
+
+      const std::tuple invariant_packs{invariant_pack<width, _Planes>(std::get<is>(pointers))...};
+      for (; i + width <= length; i += width) {
+        invoke_packs<width, _Planes...>(invocable, pointers, invariant_packs, i);
+      }
+
+      // Packs of halving widths, down to 2 values (the invocable is called with them only if it supports them)
+      [&]<std::size_t... steps>(std::index_sequence<steps...>) {
+        (
+            [&] {
+              static constexpr std::size_t tail_width = width >> (steps + 1u);
+              if constexpr (std::is_invocable_v<Invocable&, simd_pack<typename std::decay_t<_Planes>::value_type,
+                                                                      tail_width>&...>) {
+                if (i + tail_width <= length) {
+                  invoke_packs<tail_width, _Planes...>(
+                      invocable, pointers, std::tuple{invariant_pack<tail_width, _Planes>(std::get<is>(pointers))...},
+                      i);
+                  i += tail_width;
+                }
+              }
+            }(),
+            ...);
+      }(std::make_index_sequence<width == 1u ? 0u : std::countr_zero(width) - 1u>());
+
+      for (; i < length; ++i) {
+        invocable(std::get<is>(pointers)[i * strides[is]]...);
+      }
+    }(std::make_index_sequence<sizeof...(_Planes)>());
+  }
+}
+
+/*
+ * Iterates the elements of several planes simultaneously, passing simd packs of consecutive elements to the invocable
+ * The rows are addressed through pointers to the planes' memory, since slicing the planes would copy them (and the
+ * shared ownership of their buffers) for each row. After each call, the packs are written back to the planes, unless
+ * the planes are read-only. Planes with an innermost stride of 0 pass the same element (or pack) to each call
+ * Parameters:
+ * @param invocable: Invocable called with packs and with single elements of a plane/s
+ * @param planes: Variadic number of planes
+ * Constraints:
+ * The planes have to have the same dimensions, and is_vectorizable has to be satisfied
+ */
+template <typename Invocable, typename... _Planes>
+void vectorized_execute(Invocable&& invocable, _Planes&&... planes) {
+  using planes_type = std::decay_t<fts_t<_Planes...>>;
+  vectorized_execute_dimension<planes_type::rank() - 1u, _Planes...>(invocable, std::tuple{&planes[0u]...});
+}
+
+/*
+ * Iterates the elements of several planes with the same dimensions on the calling thread
+ * The iteration of small planes is fully unrolled. Otherwise, with the unsequenced policy, simd packs are used whenever
+ * the planes and the invocable support it
+ * Parameters:
+ * @tparam Policy: execution policy (sequenced or unsequenced)
+ * @param invocable: Invocable called on each element of a plane/s
+ * @param planes: Variadic number of planes
+ */
+template <typename Policy, typename Invocable, typename... Planes>
+void sequenced_recursive_execute(Invocable&& invocable, Planes&&... planes) {
+  // The checks are nested, so that the invocable is never instantiated with packs under the sequenced policy
+  if constexpr (is_unrollable<Planes...>()) {
+    unrolled_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+  } else if constexpr (is_unsequenced_policy_v<Policy>) {
+    if constexpr (is_vectorizable<Invocable, Planes...>()) {
+      vectorized_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+    } else {
+      recursive_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
     }
+  } else {
+    recursive_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+  }
+}
+
+/*
+ * Minimum number of elements processed by a single chunk of a parallel execution
+ * Smaller chunks cost more to schedule than to process
+ */
+inline constexpr std::size_t parallel_min_chunk_elements = 1u << 14u;
+
+/*
+ * Computes the number of loop iterations executed by a single chunk of a parallel execution
+ * The number of chunks is a small multiple of the number of threads, so that idle threads have work to steal. Whenever
+ * the stride allows it, chunks start on NT_ALIGNMENT boundaries, so that two threads never write to the same cache line
+ * Parameters:
+ * @tparam T: type of the iterated elements
+ * @param extent: total number of loop iterations
+ * @param stride: number of elements skipped in each loop iteration
+ * @param elements_per_iteration: number of elements processed in each loop iteration
+ * @param num_threads: number of threads executing the chunks
+ * @return: number of loop iterations in each chunk
+ */
+template <typename T>
+[[nodiscard]] constexpr std::size_t parallel_grain(std::size_t extent, long long stride,
+                                                   std::size_t elements_per_iteration,
+                                                   std::size_t num_threads) noexcept {
+  constexpr std::size_t chunks_per_thread = 4u;
+  const std::size_t num_chunks = std::max<std::size_t>(num_threads * chunks_per_thread, 1u);
+  const std::size_t min_iterations =
+      (parallel_min_chunk_elements + elements_per_iteration - 1u) / std::max<std::size_t>(elements_per_iteration, 1u);
+  std::size_t grain = std::max((extent + num_chunks - 1u) / num_chunks, min_iterations);
+
+  const std::size_t stride_bytes = static_cast<std::size_t>(stride < 0 ? -stride : stride) * sizeof(T);
+  if (stride_bytes) {
+    const std::size_t aligned_step = NT_ALIGNMENT / std::gcd(stride_bytes, static_cast<std::size_t>(NT_ALIGNMENT));
+    grain = (grain + aligned_step - 1u) / aligned_step * aligned_step;
   }
+
+  return std::max<std::size_t>(grain, 1u);
+}
+
+/*
+ * Parallel version of the recursive_execute method
+ * The loop over the outermost dimension is split into chunks, which are executed on a thread pool. Planes small enough
+ * for their iteration to be fully unrolled are iterated on the calling thread
+ * Only the buffers that expose their memory are known to be safe to write concurrently (writing an element that isn't
+ * stored in a SparseBuffer inserts it into a shared container), so planes with other buffers are iterated sequentially
+ * Parameters:
+ * @param pool: thread pool used for executing the chunks
+ * @param invocable: Invocable called on each element of a plane/s. It can be called concurrently from several threads
+ * @param planes: Variadic number of planes
+ */
+template <typename Invocable, typename... _Planes>
+void parallel_recursive_execute(ThreadPool& pool, Invocable&& invocable, _Planes&&... planes) {
+  using planes_type = std::decay_t<fts_t<_Planes...>>;
+  if constexpr (!(contiguous_buffer<typename std::decay_t<_Planes>::buffer_type> && ...)) {
+    sequenced_recursive_execute<sequenced_policy>(std::forward<Invocable>(invocable), std::forward<_Planes>(planes)...);
+    return;
+  } else if constexpr (is_unrollable<_Planes...>()) {
+    unrolled_execute(std::forward<Invocable>(invocable), std::forward<_Planes>(planes)...);
+    return;
+  }
+  static constexpr std::size_t rank = planes_type::rank();
+  const auto& plane = first_plane(planes...);
+  const std::size_t extent = plane_extent<rank - 1u>(plane);
+  const long long stride = plane_stride<rank - 1u>(plane);
+  const std::size_t elements_per_iteration = plane_elements(plane) / extent * planes_type::channels();
+
+  const std::size_t grain = parallel_grain<typename planes_type::value_type>(
+      extent, stride * static_cast<long long>(planes_type::channels()), elements_per_iteration, pool.size());
+
+  pool.parallel_for(0u, extent, grain, [&invocable, &planes...](std::size_t first, std::size_t last) {
+    if constexpr (rank > 1u) {
+      for (std::size_t i = first; i < last; ++i) {
+        recursive_execute(invocable, slice_outermost(planes, i)...);
+      }
+    } else {
+      innermost_execute(invocable, first, last, planes...);
+    }
+  });
+}
+
+/*
+ * Parallel version of the iterative_execute method
+ * Planes small enough for their iteration to be fully unrolled are iterated on the calling thread. Like with the
+ * parallel_recursive_execute method, planes whose buffers don't expose their memory are iterated sequentially
+ * Parameters:
+ * @param pool: thread pool used for executing the chunks
+ * @param invocable: Invocable called on each element of a plane/s. It can be called concurrently from several threads
+ * @param planes: Variadic number of planes
+ */
+template <typename Invocable, typename... Planes>
+void parallel_iterative_execute(ThreadPool& pool, Invocable&& invocable, Planes&&... planes) {
+  using first_plane_type = std::decay_t<fts_t<Planes...>>;
+  if constexpr (!(contiguous_buffer<typename std::decay_t<Planes>::buffer_type> && ...)) {
+    iterative_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+    return;
+  } else if constexpr (is_unrollable<Planes...>()) {
+    unrolled_execute(std::forward<Invocable>(invocable), std::forward<Planes>(planes)...);
+    return;
+  }
+  const std::size_t N = plane_elements(first_plane(planes...));
+
+  const std::size_t grain = parallel_grain<typename first_plane_type::value_type>(
+      N, static_cast<long long>(first_plane_type::channels()), first_plane_type::channels(), pool.size());
+
+  pool.parallel_for(0u, N, grain, [&invocable, &planes...](std::size_t first, std::size_t last) {
+    iterative_execute_range(invocable, first, last, planes...);
+  });
+}
+
+/*
+ * Returns the dimensions of a plane as an array, padded with outermost dimensions of length 1 up to the given rank
+ * Parameters:
+ * @tparam rank: rank of the returned dimensions
+ * @tparam Plane: type of the plane
+ */
+template <std::size_t rank, typename Plane>
+[[nodiscard]] consteval auto padded_dimensions() noexcept {
+  using plane_type = std::decay_t<Plane>;
+
+  return []<std::size_t... is>(std::index_sequence<is...>) {
+    std::array<std::size_t, rank> padded{};
+    padded.fill(1u);
+    ((padded[is] = static_cast<std::size_t>(plane_type::dimensions().template at<is>())), ...);
+    return padded;
+  }(std::make_index_sequence<plane_type::rank()>());
+}
+
+/*
+ * Computes the dimensions to which several planes are broadcast
+ * The dimensions are aligned starting from the innermost one, and planes of a lower rank are treated as if they had
+ * additional outermost dimensions of length 1. In each dimension, the lengths of all planes have to be either equal or
+ * 1, and the broadcast length is the largest of them (like the broadcasting of NumPy, whose trailing dimensions are the
+ * innermost dimensions)
+ * Parameters:
+ * @tparam Planes: types of the planes
+ * @return: broadcast dimensions as an array, or an empty optional if the planes can't be broadcast
+ */
+template <typename... Planes>
+[[nodiscard]] consteval auto broadcast_dimensions_array() noexcept {
+  constexpr std::size_t rank = std::max({std::decay_t<Planes>::rank()...});
+  constexpr std::array dimensions{padded_dimensions<rank, Planes>()...};
+
+  std::array<std::size_t, rank> broadcast{};
+  bool broadcastable = true;
+  for (std::size_t d = 0u; d < rank; ++d) {
+    broadcast[d] = 1u;
+    for (const auto& plane_dimensions : dimensions) broadcast[d] = std::max(broadcast[d], plane_dimensions[d]);
+    for (const auto& plane_dimensions : dimensions) {
+      broadcastable &= plane_dimensions[d] == 1u || plane_dimensions[d] == broadcast[d];
+    }
+  }
+  return broadcastable ? std::optional{broadcast} : std::nullopt;
+}
+
+/*
+ * Checks whether several planes can be broadcast to common dimensions (see broadcast_dimensions_array)
+ * Parameters:
+ * @tparam Planes: types of the planes
+ */
+template <typename... Planes>
+[[nodiscard]] consteval bool are_broadcastable() noexcept {
+  if constexpr ((is_dynamic_plane_v<Planes> || ...)) {
+    return false;
+  } else {
+    return broadcast_dimensions_array<Planes...>().has_value();
+  }
+}
+
+/*
+ * Checks whether all planes that have to be broadcast to the dimensions of the other planes are read-only
+ * A broadcast element is passed to several calls of the invocable (concurrently, with the parallel policy), so
+ * writing it would race, or keep only one of the written values
+ * Parameters:
+ * @tparam Planes: types of the planes, which have to be broadcastable (see are_broadcastable)
+ */
+template <typename... Planes>
+[[nodiscard]] consteval bool are_broadcast_planes_read_only() noexcept {
+  constexpr auto dimensions = *broadcast_dimensions_array<Planes...>();
+  return ((padded_dimensions<dimensions.size(), Planes>() == dimensions || is_read_only_plane<Planes>()) && ...);
+}
+
+/*
+ * Returns a view of a plane with the broadcast dimensions
+ * The dimensions in which the plane is broadcast (including the dimensions missing from the plane) get a stride of 0,
+ * so every position along them maps to the same element. No elements are copied
+ * Parameters:
+ * @tparam dimensions: broadcast dimensions, as returned by broadcast_dimensions_array
+ * @param plane: broadcast plane
+ */
+template <auto dimensions, typename Plane>
+[[nodiscard]] inline auto broadcast_view(const Plane& plane) {
+  using plane_type = std::decay_t<Plane>;
+
+  static constexpr auto strides = [] {
+    constexpr auto plane_dimensions = padded_dimensions<dimensions.size(), Plane>();
+    constexpr auto plane_strides = []<std::size_t... is>(std::index_sequence<is...>) {
+      return std::array<long long, sizeof...(is)>{plane_type::strides().template at<is>()...};
+    }(std::make_index_sequence<plane_type::rank()>());
+
+    std::array<long long, dimensions.size()> strides{};
+    for (std::size_t d = 0u; d < plane_strides.size(); ++d) {
+      strides[d] = plane_dimensions[d] == dimensions[d] ? plane_strides[d] : 0;
+    }
+    return strides;
+  }();
+
+  return [&plane]<std::size_t... is>(std::index_sequence<is...>) {
+    return plane.template like<Dimensions<dimensions[is]...>{}, Strides<strides[is]...>{}>();
+  }(std::make_index_sequence<dimensions.size()>());
 }
 
 }  // namespace internal
 
 /*
- * Calls an invocable on each element of a tensor
+ * Calls an invocable on each element of a tensor, using the specified execution policy
+ * With the parallel policy, the outermost dimension of each plane is split into chunks that are executed on a thread
+ * pool. The result is the same as with the sequential policy as long as the invocable has no side effects other than
+ * modifying the element it receives
+ * With the unsequenced policy, if the invocable is marked as accepting packs (see vectorized) and the innermost
+ * dimension of a plane is contiguous in a buffer that exposes its memory, the invocable is called with simd packs of
+ * consecutive elements (and with narrower packs and single elements for the tail of each row). Otherwise, the elements
+ * are iterated sequentially, so unmarked generic invocables don't have to support packs
  * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
  * @param invocable: Invocable called on each element of a tensor
  * @param tensor: Tensor on whose elements the invocable is called upon
  */
-template <typename Invocable, typename Tensor>
-void execute(Invocable&& invocable, Tensor&& tensor) {
+template <execution_policy Policy, typename Invocable, typename Tensor>
+void execute(Policy&& policy, Invocable&& invocable, Tensor&& tensor) {
   for_each_plane(
-      [&invocable](auto&& plane) {
+      [&policy, &invocable](auto&& plane) {
         static_assert(std::is_invocable_v<Invocable, decltype(plane.at(0u))>);
-        recursive_execute(invocable, std::forward<decltype(plane)>(plane));
+        if constexpr (is_parallel_policy_v<Policy>) {
+          parallel_recursive_execute(policy.pool(), invocable, std::forward<decltype(plane)>(plane));
+        } else {
+          sequenced_recursive_execute<Policy>(invocable, std::forward<decltype(plane)>(plane));
+        }
       },
       tensor);
 }
 
 /*
- * Calls an invocable on each element of any number of tensors
+ * Calls an invocable on each element of a tensor
+ * Parameters:
+ * @param invocable: Invocable called on each element of a tensor
+ * @param tensor: Tensor on whose elements the invocable is called upon
+ */
+template <typename Invocable, typename Tensor>
+void execute(Invocable&& invocable, Tensor&& tensor) {
+  execute(seq, std::forward<Invocable>(invocable), std::forward<Tensor>(tensor));
+}
+
+/*
+ * Calls an invocable on each element of any number of tensors, using the specified execution policy
  * There are two possible pathways within this method:
  * 1) The invocable receives N elements. In this case, we try to iterate all of the tensors simultaneously, and execute
  * the invocable across an element of each tensor 2) The invocable receives a single element. In this case, we iterate
- * each tensor separately, executing the invocable on each element as we go Parameters:
+ * each tensor separately, executing the invocable on each element as we go
+ * Planes iterated simultaneously whose numbers of elements differ are broadcast, if their dimensions allow it (see
+ * broadcast_dimensions_array). For example, a plane with the dimensions [C] can be added to each row of a plane with
+ * the dimensions [C, N]. The broadcast planes are viewed with strides of 0, so they aren't copied, and the elements of
+ * read-only planes that are invariant along the innermost dimension are loaded only once per row. Since a broadcast
+ * element is passed to several calls of the invocable, only read-only planes can be broadcast (for example, planes of
+ * const tensors)
+ * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
  * @param invocable: Invocable called on each element of a tensor/s
  * @param tensors: Variadic number of tensors
  * Constraints:
  * The method has to receive more than one tensors
  */
-template <typename Invocable, typename... Tensors>
+template <execution_policy Policy, typename Invocable, typename... Tensors>
   requires(sizeof...(Tensors) > 1u)
-void execute(Invocable&& invocable, Tensors&&... tensors) {
+void execute(Policy&& policy, Invocable&& invocable, Tensors&&... tensors) {
   // Check if the invocable receives an equal number of arguments as the number of tensors that are passed to this
   // function
   static constexpr auto is_simultaneous_invocation =
@@ -175,16 +1009,27 @@ void execute(Invocable&& invocable, Tensors&&... tensors) {
     // Tensors have to have the same number of planes
     static_assert(((N == std::decay_t<decltype(tensors.planes())>::size()) && ...));
 
-    // All planes that are executed simultaneously must have an equal number of channels, and the same product of
-    // dimensions (equal number of elements)
+    // All planes that are executed simultaneously must have an equal number of channels, and either the same product
+    // of dimensions (equal number of elements) or broadcastable dimensions. The dimensions of DynamicPlanes are only
+    // checked at runtime
     for_all_planes(
         [](auto&&... planes) {
           using first_plane_type = std::decay_t<fts_t<decltype(planes)...>>;
-          static constexpr std::size_t expected_dimensions_product = product(first_plane_type::dimensions());
           static constexpr std::size_t expected_num_channels = first_plane_type::channels();
-          static_assert(
-              ((expected_dimensions_product == product(std::decay_t<decltype(planes)>::dimensions())) && ...));
           static_assert(((expected_num_channels == std::decay_t<decltype(planes)>::channels()) && ...));
+
+          if constexpr ((is_dynamic_plane_v<decltype(planes)> || ...)) {
+#ifdef ENABLE_NT_EXPECTS
+            const std::size_t expected_elements = plane_elements(first_plane(planes...));
+            Expects(((expected_elements == plane_elements(planes)) && ...));
+#endif
+          } else {
+            static constexpr std::size_t expected_dimensions_product = product(first_plane_type::dimensions());
+            static_assert(
+                ((expected_dimensions_product == product(std::decay_t<decltype(planes)>::dimensions())) && ...) ||
+                    are_broadcastable<decltype(planes)...>(),
+                "The planes have to have the same number of elements, or broadcastable dimensions");
+          }
         },
         tensors...);
 
@@ -197,27 +1042,122 @@ void execute(Invocable&& invocable, Tensors&&... tensors) {
      * This is used to determine which specialization of the execute method will be called
      */
     for_all_planes(
-        [&invocable](auto&&... planes) {
+        [&policy, &invocable](auto&&... planes) {
           using first_plane_type = std::decay_t<fts_t<decltype(planes)...>>;
-          using first_plane_dimensions = std::decay_t<decltype(first_plane_type::dimensions())>;
-          static constexpr bool dimensions_match =
-              ((std::is_same_v<first_plane_dimensions,
-                               std::decay_t<decltype(std::decay_t<decltype(planes)>::dimensions())>>)&&...);
 
-          if (dimensions_match) {
-            recursive_execute(std::forward<Invocable>(invocable), std::forward<decltype(planes)>(planes)...);
+          auto recursive = [&policy, &invocable](auto&&... planes) {
+            if constexpr (is_parallel_policy_v<Policy>) {
+              parallel_recursive_execute(policy.pool(), std::forward<Invocable>(invocable),
+                                         std::forward<decltype(planes)>(planes)...);
+            } else {
+              sequenced_recursive_execute<Policy>(std::forward<Invocable>(invocable),
+                                                  std::forward<decltype(planes)>(planes)...);
+            }
+          };
+
+          // TODO:
+          // If I can perform reshape in place, I don't need iterative_execute. I can call recursive_execute instead
+          auto iterative = [&policy, &invocable](auto&&... planes) {
+            if constexpr (is_parallel_policy_v<Policy>) {
+              parallel_iterative_execute(policy.pool(), std::forward<Invocable>(invocable),
+                                         std::forward<decltype(planes)>(planes)...);
+            } else {
+              iterative_execute(std::forward<Invocable>(invocable), std::forward<decltype(planes)>(planes)...);
+            }
+          };
+
+          if constexpr ((is_dynamic_plane_v<decltype(planes)> || ...)) {
+            // The dimensions of DynamicPlanes (which may be mixed with Planes) are compared at runtime
+            if constexpr (((first_plane_type::rank() == std::decay_t<decltype(planes)>::rank()) && ...)) {
+              const auto dimensions = plane_dimensions(first_plane(planes...));
+              if (((dimensions == plane_dimensions(planes)) && ...)) {
+                recursive(std::forward<decltype(planes)>(planes)...);
+                return;
+              }
+            }
+            iterative(std::forward<decltype(planes)>(planes)...);
           } else {
-            // TODO:
-            // If I can perform reshape in place, I don't need iterative_execute. I can call recursive_execute instead
-            iterative_execute(std::forward<Invocable>(invocable), std::forward<decltype(planes)>(planes)...);
+            using first_plane_dimensions = std::decay_t<decltype(first_plane_type::dimensions())>;
+            static constexpr bool dimensions_match =
+                ((std::is_same_v<first_plane_dimensions,
+                                 std::decay_t<decltype(std::decay_t<decltype(planes)>::dimensions())>>)&&...);
+            static constexpr std::size_t expected_dimensions_product = product(first_plane_type::dimensions());
+            static constexpr bool products_match =
+                ((expected_dimensions_product == product(std::decay_t<decltype(planes)>::dimensions())) && ...);
+
+            if constexpr (dimensions_match) {
+              recursive(std::forward<decltype(planes)>(planes)...);
+            } else if constexpr (products_match) {
+              iterative(std::forward<decltype(planes)>(planes)...);
+            } else {
+              // The broadcast views keep the read-only planes read-only
+              static_assert(are_broadcast_planes_read_only<decltype(planes)...>(),
+                            "The broadcast planes have to be read-only (for example, planes of const tensors)");
+              static constexpr auto dimensions = *broadcast_dimensions_array<decltype(planes)...>();
+              recursive(propagate_const<decltype(planes)>(broadcast_view<dimensions>(planes))...);
+            }
           }
         },
         tensors...);
   }
   // Execute the invocable for each tensor separately
   else {
-    (execute(std::forward<Invocable>(invocable), tensors), ...);
+    (execute(policy, std::forward<Invocable>(invocable), tensors), ...);
   };
 }
 
+/*
+ * Calls an invocable on each element of any number of tensors
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @param invocable: Invocable called on each element of a tensor/s
+ * @param tensors: Variadic number of tensors
+ * Constraints:
+ * The method has to receive more than one tensors
+ */
+template <typename Invocable, typename... Tensors>
+  requires(sizeof...(Tensors) > 1u && !execution_policy<Invocable>)
+void execute(Invocable&& invocable, Tensors&&... tensors) {
+  execute(seq, std::forward<Invocable>(invocable), std::forward<Tensors>(tensors)...);
+}
+
+/*
+ * Helper method used for creating a plane whose elements are initialized to zero, using the specified execution policy
+ * The operating system places each page of newly allocated memory on the NUMA node of the thread that writes it first.
+ * With the parallel policy, the elements are written in the same chunks (of the outermost dimension) that the parallel
+ * execute method uses, so the pages of each chunk end up close to the threads that process it, instead of all pages
+ * ending up on the node of the thread creating the plane. This matters for buffers whose memory wasn't written before,
+ * for example those of the NumaAllocator with the first_touch placement, and large allocations of the
+ * AlignedMallocAllocator
+ * Parameters:
+ * @tparam BufferType: Type of the underlying buffer
+ * @tparam dimensions: Dimensions of the newly created plane
+ * @tparam channels: Number of channels fo the newly created plane
+ * @tparam aligned_strides: Variable determining whether the plane should have aligned or unaligned strides
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param buffer_args: arguments passed to the buffer's constructor before the number of elements (for example
+ * std::allocator_arg and an allocator)
+ */
+template <typename BufferType, Dimensions dimensions, std::size_t channels = 1u, bool aligned_strides = true,
+          execution_policy Policy, typename... BufferArgs>
+[[nodiscard]] auto create_plane(Policy&& policy, BufferArgs&&... buffer_args) {
+  auto plane = [&buffer_args...] {
+    if constexpr (sizeof...(BufferArgs) == 0u) {
+      return create_plane<BufferType, dimensions, channels, aligned_strides>();
+    } else {
+      return create_plane<BufferType, dimensions, channels, aligned_strides>(
+          std::forward<BufferArgs>(buffer_args)...);
+    }
+  }();
+
+  // With the unsequenced policy, the value is broadcast to simd packs
+  static constexpr auto zero = vectorized([](auto& v) { v = typename BufferType::value_type{}; });
+  if constexpr (is_parallel_policy_v<Policy>) {
+    parallel_recursive_execute(policy.pool(), zero, plane);
+  } else {
+    sequenced_recursive_execute<Policy>(zero, plane);
+  }
+  return plane;
+}
+
 }  // namespace ntensor
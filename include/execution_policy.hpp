@@ -0,0 +1,72 @@
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "thread_pool.hpp"
+
+namespace ntensor {
+
+/*
+ * Execution policy specifying that an algorithm is executed sequentially on the calling thread
+ */
+struct sequenced_policy {};
+
+/*
+ * Execution policy specifying that an algorithm can be split into chunks which are executed on a thread pool
+ * If no thread pool is specified, the default thread pool is used
+ */
+struct parallel_policy {
+  ThreadPool* _pool{nullptr};
+
+  /*
+   * Creates a parallel policy that executes algorithms on the given thread pool
+   * Parameters:
+   * @param pool: thread pool on which the algorithms are executed
+   * @return: new parallel policy
+   */
+  [[nodiscard]] constexpr parallel_policy on(ThreadPool& pool) const noexcept { return parallel_policy{&pool}; }
+
+  /*
+   * Returns the thread pool used by this policy
+   * Parameters:
+   * @return: reference to the thread pool
+   */
+  [[nodiscard]] ThreadPool& pool() const { return _pool ? *_pool : default_thread_pool(); }
+};
+
+/*
+ * Execution policy specifying that an algorithm is executed on the calling thread, and that it can process several
+ * consecutive elements at once using vector instructions
+ */
+struct unsequenced_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr unsequenced_policy unseq{};
+
+/*
+ * Concept satisfied by the execution policies defined in this library
+ */
+template <typename T>
+concept execution_policy =
+    std::same_as<std::remove_cvref_t<T>, sequenced_policy> || std::same_as<std::remove_cvref_t<T>, parallel_policy> ||
+    std::same_as<std::remove_cvref_t<T>, unsequenced_policy>;
+
+/*
+ * Checks whether the given execution policy allows parallel execution
+ * Parameters:
+ * @tparam Policy: execution policy
+ */
+template <typename Policy>
+inline constexpr bool is_parallel_policy_v = std::same_as<std::remove_cvref_t<Policy>, parallel_policy>;
+
+/*
+ * Checks whether the given execution policy allows vectorized execution
+ * Parameters:
+ * @tparam Policy: execution policy
+ */
+template <typename Policy>
+inline constexpr bool is_unsequenced_policy_v = std::same_as<std::remove_cvref_t<Policy>, unsequenced_policy>;
+
+}  // namespace ntensor
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+#include "execute.hpp"
+#include "tensor.hpp"
+
+namespace ntensor {
+
+inline namespace internal {
+
+/*
+ * Checks whether a type is a Tensor
+ */
+template <typename>
+struct is_tensor : std::false_type {};
+
+template <typename Planes, template <typename> typename... Policies>
+struct is_tensor<Tensor<Planes, Policies...>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_tensor_v = is_tensor<std::remove_cvref_t<T>>::value;
+
+template <typename Op, typename... Operands>
+class Expression;
+
+/*
+ * Checks whether a type is an Expression
+ */
+template <typename>
+struct is_expression : std::false_type {};
+
+template <typename Op, typename... Operands>
+struct is_expression<Expression<Op, Operands...>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_expression_v = is_expression<std::remove_cvref_t<T>>::value;
+
+/*
+ * Concept satisfied by the types that can be used as operands of an expression: tensors, expressions and scalars
+ */
+template <typename T>
+concept expression_operand = is_tensor_v<T> || is_expression_v<T> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+/*
+ * Concept satisfied by the operands that make an expression out of an operation: tensors and expressions
+ */
+template <typename T>
+concept expression_leaf = is_tensor_v<T> || is_expression_v<T>;
+
+/*
+ * Checks whether an operation of an expression accepts simd packs: the arithmetic operators, and the operations marked
+ * by the vectorized method
+ */
+template <typename Op>
+inline constexpr bool is_vectorized_operation_v =
+    is_vectorized_invocable_v<Op> || std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::minus<>> ||
+    std::is_same_v<Op, std::multiplies<>> || std::is_same_v<Op, std::divides<>> || std::is_same_v<Op, std::negate<>>;
+
+/*
+ * Operand of an expression holding a tensor
+ * When the expression is evaluated, the operand is replaced by an element of the tensor
+ * Parameters:
+ * @tparam Tensor: type of the tensor
+ */
+template <typename Tensor>
+class TensorOperand {
+ private:
+  Tensor _tensor;
+
+ public:
+  static constexpr std::size_t num_leaves = 1u;
+  static constexpr bool vectorized = true;
+
+  /*
+   * Creates an operand holding a copy of the tensor. The copy shares the memory of the original tensor
+   * Parameters:
+   * @param tensor: tensor held by the operand
+   */
+  explicit TensorOperand(const Tensor& tensor) : _tensor{tensor} {}
+
+  /*
+   * Returns a tuple containing a reference to the held tensor
+   */
+  [[nodiscard]] inline auto leaves() const noexcept { return std::tuple<const Tensor&>{_tensor}; }
+
+  /*
+   * Returns the element of the held tensor
+   * Parameters:
+   * @tparam offset: position of the tensor's element inside the values tuple
+   * @param values: elements of all tensors of the expression
+   * @return: element of the held tensor
+   */
+  template <std::size_t offset, typename Values>
+  [[nodiscard]] inline auto evaluate(const Values& values) const noexcept -> decltype(std::get<offset>(values)) {
+    return std::get<offset>(values);
+  }
+};
+
+/*
+ * Operand of an expression holding a scalar
+ * Parameters:
+ * @tparam T: type of the scalar
+ */
+template <typename T>
+class ScalarOperand {
+ private:
+  T _value;
+
+ public:
+  static constexpr std::size_t num_leaves = 0u;
+  static constexpr bool vectorized = true;
+
+  /*
+   * Creates an operand holding a scalar
+   * Parameters:
+   * @param value: held scalar
+   */
+  explicit ScalarOperand(const T& value) : _value{value} {}
+
+  /*
+   * Returns an empty tuple, since scalars aren't tensors
+   */
+  [[nodiscard]] inline auto leaves() const noexcept { return std::tuple<>{}; }
+
+  /*
+   * Returns the held scalar
+   * Parameters:
+   * @tparam offset: unused
+   * @param values: unused
+   * @return: held scalar
+   */
+  template <std::size_t offset, typename Values>
+  [[nodiscard]] inline const T& evaluate([[maybe_unused]] const Values& values) const noexcept {
+    return _value;
+  }
+};
+
+/*
+ * Node of a lazily evaluated elementwise expression
+ * The expression doesn't compute anything when it's created. Instead, it keeps the operation and its operands, and
+ * computes the value of a single element when the evaluate method is called with the elements of all tensors the
+ * expression depends on. The tensors (leaves) of the whole expression tree are numbered from left to right, and each
+ * node knows how many leaves its operands contain, so the positions of the elements are resolved at compile time
+ * Parameters:
+ * @tparam Op: elementwise operation
+ * @tparam Operands: operands of the operation (TensorOperand, ScalarOperand or Expression)
+ */
+template <typename Op, typename... Operands>
+class Expression {
+ private:
+  Op _op;
+  std::tuple<Operands...> _operands;
+
+  /*
+   * Positions of the first leaf of each operand
+   */
+  static constexpr std::array<std::size_t, sizeof...(Operands)> _leaf_offsets = [] {
+    std::array<std::size_t, sizeof...(Operands)> offsets{};
+    std::size_t offset = 0u;
+    std::size_t idx = 0u;
+    ((offsets[idx++] = offset, offset += Operands::num_leaves), ...);
+    return offsets;
+  }();
+
+  /*
+   * Implementation of the evaluate method
+   */
+  template <std::size_t offset, std::size_t... is, typename Values>
+  [[nodiscard]] inline auto evaluate(std::index_sequence<is...>, const Values& values) const
+      -> decltype(_op(std::get<is>(_operands).template evaluate<offset + _leaf_offsets[is]>(values)...)) {
+    return _op(std::get<is>(_operands).template evaluate<offset + _leaf_offsets[is]>(values)...);
+  }
+
+ public:
+  static constexpr std::size_t num_leaves = (0u + ... + Operands::num_leaves);
+  // Whether all operations of the expression accept simd packs
+  static constexpr bool vectorized = is_vectorized_operation_v<Op> && (Operands::vectorized && ...);
+
+  /*
+   * Creates an expression node
+   * Parameters:
+   * @param op: elementwise operation
+   * @param operands: operands of the operation
+   */
+  explicit Expression(Op op, Operands... operands) : _op{std::move(op)}, _operands{std::move(operands)...} {}
+
+  /*
+   * Returns a tuple containing references to all tensors the expression depends on, from left to right
+   */
+  [[nodiscard]] inline auto leaves() const noexcept {
+    return std::apply([](const auto&... operands) { return std::tuple_cat(operands.leaves()...); }, _operands);
+  }
+
+  /*
+   * Computes the value of the expression for a single element (or a pack of elements)
+   * Parameters:
+   * @tparam offset: position of the expression's first leaf inside the values tuple
+   * @param values: elements of all tensors of the expression
+   * @return: value of the expression
+   */
+  template <std::size_t offset, typename Values>
+  [[nodiscard]] inline auto evaluate(const Values& values) const
+      -> decltype(evaluate<offset>(std::index_sequence_for<Operands...>(), values)) {
+    return evaluate<offset>(std::index_sequence_for<Operands...>(), values);
+  }
+};
+
+/*
+ * Wraps a tensor, an expression or a scalar into an operand of an expression
+ * Parameters:
+ * @param operand: tensor, expression or scalar
+ * @return: operand of an expression
+ */
+template <expression_operand T>
+[[nodiscard]] inline auto make_operand(const T& operand) {
+  if constexpr (is_tensor_v<T>) {
+    return TensorOperand<T>{operand};
+  } else if constexpr (is_expression_v<T>) {
+    return operand;
+  } else {
+    return ScalarOperand<T>{operand};
+  }
+}
+
+}  // namespace internal
+
+/*
+ * Creates an expression applying an elementwise operation to tensors, expressions and scalars
+ * Parameters:
+ * @param op: operation called with an element of each operand. With the unsequenced policy, the arithmetic operators
+ * and the operations marked by the vectorized method are called with simd packs of elements
+ * @param operands: operands of the operation
+ * @return: lazily evaluated expression
+ * Constraints:
+ * At least one of the operands has to be a tensor or an expression
+ */
+template <typename Op, expression_operand... Operands>
+  requires((expression_leaf<Operands> || ...))
+[[nodiscard]] inline auto map(Op op, const Operands&... operands) {
+  return Expression{std::move(op), make_operand(operands)...};
+}
+
+/*
+ * Elementwise arithmetic operators creating lazily evaluated expressions
+ * At least one of the operands has to be a tensor or an expression
+ */
+template <expression_operand Lhs, expression_operand Rhs>
+  requires(expression_leaf<Lhs> || expression_leaf<Rhs>)
+[[nodiscard]] inline auto operator+(const Lhs& lhs, const Rhs& rhs) {
+  return map(std::plus<>{}, lhs, rhs);
+}
+
+template <expression_operand Lhs, expression_operand Rhs>
+  requires(expression_leaf<Lhs> || expression_leaf<Rhs>)
+[[nodiscard]] inline auto operator-(const Lhs& lhs, const Rhs& rhs) {
+  return map(std::minus<>{}, lhs, rhs);
+}
+
+template <expression_operand Lhs, expression_operand Rhs>
+  requires(expression_leaf<Lhs> || expression_leaf<Rhs>)
+[[nodiscard]] inline auto operator*(const Lhs& lhs, const Rhs& rhs) {
+  return map(std::multiplies<>{}, lhs, rhs);
+}
+
+template <expression_operand Lhs, expression_operand Rhs>
+  requires(expression_leaf<Lhs> || expression_leaf<Rhs>)
+[[nodiscard]] inline auto operator/(const Lhs& lhs, const Rhs& rhs) {
+  return map(std::divides<>{}, lhs, rhs);
+}
+
+template <expression_leaf Operand>
+[[nodiscard]] inline auto operator-(const Operand& operand) {
+  return map(std::negate<>{}, operand);
+}
+
+/*
+ * Evaluates an expression and stores the result into a destination tensor, using the specified execution policy
+ * The destination and all tensors of the expression are iterated simultaneously in a single pass, so the memory of each
+ * tensor is read (or written) only once, regardless of the number of operations in the expression
+ * The destination can be one of the tensors of the expression, since each element depends only on the elements at the
+ * same position
+ * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param destination: tensor into which the result is stored
+ * @param expression: evaluated expression
+ * Constraints:
+ * The destination and the tensors of the expression have to have the same number of planes, and the planes have to
+ * satisfy the requirements of the multi-tensor execute method
+ */
+template <execution_policy Policy, typename Tensor, typename Op, typename... Operands>
+void assign(Policy&& policy, Tensor&& destination, const Expression<Op, Operands...>& expression) {
+  auto evaluate = [&expression](auto& element, const auto&... values)
+    requires requires { element = expression.template evaluate<0u>(std::forward_as_tuple(values...)); }
+  { element = expression.template evaluate<0u>(std::forward_as_tuple(values...)); };
+
+  auto execute_expression = [&policy, &destination, &expression](const auto& invocable) {
+    std::apply(
+        [&policy, &invocable, &destination](const auto&... leaves) {
+          execute(std::forward<Policy>(policy), invocable, destination, leaves...);
+        },
+        expression.leaves());
+  };
+
+  // Expressions are evaluated on simd packs only if all of their operations accept them
+  if constexpr (Expression<Op, Operands...>::vectorized) {
+    execute_expression(vectorized(evaluate));
+  } else {
+    execute_expression(evaluate);
+  }
+}
+
+/*
+ * Evaluates an expression and stores the result into a destination tensor
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @param destination: tensor into which the result is stored
+ * @param expression: evaluated expression
+ */
+template <typename Tensor, typename Op, typename... Operands>
+void assign(Tensor&& destination, const Expression<Op, Operands...>& expression) {
+  assign(seq, std::forward<Tensor>(destination), expression);
+}
+
+}  // namespace ntensor
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "assert.hpp"
+#include "concepts.hpp"
+
+namespace ntensor {
+
+/*
+ * Ways in which a file can be mapped into memory
+ * read_only: the mapped memory can only be read
+ * copy_on_write: the mapped memory can be written, but the changes are private to the process and never reach the file
+ * shared: the changes are written back to the file. If the file doesn't exist, or it's too small, it's created/extended
+ */
+enum class mapping_mode { read_only, copy_on_write, shared };
+
+/*
+ * Hints telling the operating system how the mapped memory is going to be accessed
+ * normal: no special treatment
+ * sequential: the pages are accessed in order, so they can be read ahead aggressively and freed soon after they're used
+ * random: the pages are accessed in random order, so reading ahead is wasteful
+ * will_need: the pages are going to be accessed soon, so they can be loaded ahead of time
+ */
+enum class access_pattern { normal, sequential, random, will_need };
+
+/*
+ * Memory mapping of a whole file
+ * The mapping is released when the object is destroyed. It can't be copied, so buffers share it through a shared_ptr
+ */
+class FileMapping {
+ private:
+  std::byte* _memory{nullptr};
+  std::size_t _size{};
+  mapping_mode _mode{};
+
+ public:
+  /*
+   * Maps the file into memory
+   * Parameters:
+   * @param path: path of the mapped file
+   * @param mode: mapping mode
+   * @param min_size: minimum size of the file in bytes. With the shared mode, smaller files are extended (and missing
+   * files are created), while with the other modes they're rejected
+   * Exceptions:
+   * std::system_error if the file can't be opened, extended or mapped
+   */
+  explicit FileMapping(const std::filesystem::path& path, mapping_mode mode = mapping_mode::read_only,
+                       std::size_t min_size = 0u)
+      : _mode{mode} {
+    const bool shared = mode == mapping_mode::shared;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), shared ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, shared ? OPEN_ALWAYS : OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "CreateFileW");
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+      const auto error = static_cast<int>(GetLastError());
+      CloseHandle(file);
+      throw std::system_error(error, std::system_category(), "GetFileSizeEx");
+    }
+    _size = static_cast<std::size_t>(size.QuadPart);
+
+    if (_size < min_size) {
+      if (!shared) {
+        CloseHandle(file);
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "file is too small");
+      }
+      // The mapping extends the file to its maximum size
+      _size = min_size;
+    }
+
+    if (_size) {
+      const DWORD protection = mode == mapping_mode::read_only       ? PAGE_READONLY
+                               : mode == mapping_mode::copy_on_write ? PAGE_WRITECOPY
+                                                                     : PAGE_READWRITE;
+      const DWORD access = mode == mapping_mode::read_only       ? FILE_MAP_READ
+                           : mode == mapping_mode::copy_on_write ? FILE_MAP_COPY
+                                                                 : FILE_MAP_WRITE;
+
+      HANDLE mapping = CreateFileMappingW(file, nullptr, protection, static_cast<DWORD>(_size >> 32u),
+                                          static_cast<DWORD>(_size & 0xffffffffu), nullptr);
+      if (!mapping) {
+        const auto error = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        throw std::system_error(error, std::system_category(), "CreateFileMappingW");
+      }
+
+      _memory = static_cast<std::byte*>(MapViewOfFile(mapping, access, 0, 0, 0));
+      const auto error = static_cast<int>(GetLastError());
+      CloseHandle(mapping);
+
+      if (!_memory) {
+        CloseHandle(file);
+        throw std::system_error(error, std::system_category(), "MapViewOfFile");
+      }
+    }
+
+    CloseHandle(file);
+#else
+    const int fd = shared ? ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)
+                          : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open");
+    }
+
+    auto fail = [fd](const char* what, int error) {
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), what);
+    };
+
+    struct stat status {};
+    if (::fstat(fd, &status)) {
+      fail("fstat", errno);
+    }
+    _size = static_cast<std::size_t>(status.st_size);
+
+    if (_size < min_size) {
+      if (!shared) {
+        fail("file is too small", EINVAL);
+      }
+      if (::ftruncate(fd, static_cast<off_t>(min_size))) {
+        fail("ftruncate", errno);
+      }
+      _size = min_size;
+    }
+
+    if (_size) {
+      const int protection = mode == mapping_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      void* memory = ::mmap(nullptr, _size, protection, shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+      if (memory == MAP_FAILED) {
+        fail("mmap", errno);
+      }
+      _memory = static_cast<std::byte*>(memory);
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    ::close(fd);
+#endif
+  }
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  /*
+   * Releases the mapping. With the shared mode, the changes are written back to the file by the operating system
+   */
+  ~FileMapping() {
+    if (_memory) {
+#ifdef _WIN32
+      UnmapViewOfFile(_memory);
+#else
+      ::munmap(_memory, _size);
+#endif
+    }
+  }
+
+  /*
+   * Returns a pointer to the first byte of the mapped file
+   * The memory can be written only if the file wasn't mapped with the read_only mode
+   */
+  [[nodiscard]] inline std::byte* data() const noexcept { return _memory; }
+
+  /*
+   * Returns the size of the mapped file in bytes
+   */
+  [[nodiscard]] inline std::size_t size() const noexcept { return _size; }
+
+  /*
+   * Returns the mode with which the file was mapped
+   */
+  [[nodiscard]] inline mapping_mode mode() const noexcept { return _mode; }
+
+  /*
+   * Tells the operating system how a part of the mapping is going to be accessed
+   * The hint is only a suggestion, so failures are ignored. On platforms without madvise, only will_need has an effect
+   * Parameters:
+   * @param pattern: expected access pattern
+   * @param offset: position of the first byte of the advised part
+   * @param size: size of the advised part in bytes
+   */
+  void advise(access_pattern pattern, std::size_t offset = 0u,
+              std::size_t size = std::numeric_limits<std::size_t>::max()) const noexcept {
+    if (offset >= _size) {
+      return;
+    }
+    size = std::min(size, _size - offset);
+
+#ifdef _WIN32
+    if (pattern == access_pattern::will_need) {
+      WIN32_MEMORY_RANGE_ENTRY range{_memory + offset, size};
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    // madvise requires a page aligned address
+    static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t first = offset / page_size * page_size;
+
+    const int advice = pattern == access_pattern::sequential ? MADV_SEQUENTIAL
+                       : pattern == access_pattern::random   ? MADV_RANDOM
+                       : pattern == access_pattern::will_need ? MADV_WILLNEED
+                                                              : MADV_NORMAL;
+    ::madvise(_memory + first, size + offset - first, advice);
+#endif
+  }
+
+  /*
+   * Writes the changes of a shared mapping back to the file, and waits until they're written
+   * Exceptions:
+   * std::system_error if the changes can't be written
+   */
+  void flush() const {
+    if (!_memory || _mode != mapping_mode::shared) {
+      return;
+    }
+
+#ifdef _WIN32
+    if (!FlushViewOfFile(_memory, 0)) {
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "FlushViewOfFile");
+    }
+#else
+    if (::msync(_memory, _size, MS_SYNC)) {
+      throw std::system_error(errno, std::generic_category(), "msync");
+    }
+#endif
+  }
+};
+
+/*
+ * Buffer whose elements are stored in a memory mapped file
+ * The elements aren't copied into memory; the operating system loads the pages of the file when they're accessed for
+ * the first time, and it can evict them under memory pressure, so the page cache acts as the cache of data sets that
+ * don't fit into memory. The first element is aligned to NT_ALIGNMENT, just like the memory of the DenseBuffer
+ * With the read_only mode, both reference aliases are const references, so planes using this buffer can only be passed
+ * to invocables taking the elements by value or by const reference
+ * Parameters:
+ * @tparam T: type of the elements stored in the file
+ * @tparam mode: mapping mode of the file
+ * Constraints:
+ * T has to satisfy the arithmetic concept, and it has to be trivially copyable
+ */
+template <arithmetic T, mapping_mode mode = mapping_mode::read_only>
+  requires std::is_trivially_copyable_v<T>
+class MappedBuffer {
+ private:
+  using element_type = std::conditional_t<mode == mapping_mode::read_only, const T, T>;
+
+  std::shared_ptr<const FileMapping> _mapping{};
+  element_type* _memory{nullptr};
+  std::size_t _size{};
+
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = element_type*;
+  using const_pointer = const T*;
+  using reference = element_type&;
+  using const_reference = const T&;
+  using value_type = T;
+
+  /*
+   * Default constructor
+   */
+  MappedBuffer() noexcept = default;
+
+  /*
+   * Creates a buffer viewing a part of a mapped file
+   * Parameters:
+   * @param mapping: mapped file
+   * @param byte_offset: position of the first element inside the file, in bytes
+   * @param size: number of elements
+   * Constraints:
+   * The elements have to be inside the file, the byte offset has to be a multiple of NT_ALIGNMENT, and the file has to
+   * be mapped with a mode allowing the buffer's access
+   */
+  MappedBuffer(std::shared_ptr<const FileMapping> mapping, std::size_t byte_offset, std::size_t size)
+      : _mapping{std::move(mapping)}, _size{size} {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(_mapping && byte_offset <= _mapping->size() && size <= (_mapping->size() - byte_offset) / sizeof(T));
+    Expects(!(byte_offset % NT_ALIGNMENT));
+    Expects(mode == mapping_mode::read_only || _mapping->mode() == mode);
+#endif
+    _memory = reinterpret_cast<element_type*>(_mapping->data() + byte_offset);
+
+#ifdef ENABLE_NT_EXPECTS
+    Expects(!(reinterpret_cast<std::uintptr_t>(_memory) % NT_ALIGNMENT));
+#endif
+  }
+
+  /*
+   * Maps a whole file, and views it as a sequence of elements
+   * Parameters:
+   * @param path: path of the mapped file
+   */
+  explicit MappedBuffer(const std::filesystem::path& path)
+      : MappedBuffer{std::make_shared<const FileMapping>(path, mode), 0u, 0u} {
+    _size = _mapping->size() / sizeof(T);
+  }
+
+  /*
+   * Maps a file holding (at least) the given number of elements
+   * With the shared mode, the file is created or extended if needed. This constructor is used by create_plane, so
+   * planes can be created directly on top of a file
+   * Parameters:
+   * @param path: path of the mapped file
+   * @param size: number of elements
+   */
+  MappedBuffer(const std::filesystem::path& path, std::size_t size)
+      : MappedBuffer{std::make_shared<const FileMapping>(path, mode, size * sizeof(T)), 0u, size} {}
+
+  /*
+   * Compares two mapped buffers for equality
+   * Parameters:
+   * param lhs: first (left-hand side) mapped buffer
+   * param rhs: second (right-hand side) mapped buffer
+   * True if the buffers view the same elements, false otherwise
+   */
+  [[nodiscard]] friend bool operator==(const MappedBuffer& lhs, const MappedBuffer& rhs) noexcept {
+    return lhs._memory == rhs._memory && lhs._size == rhs._size;
+  }
+
+  /*
+   * Returns a pointer to the first element
+   */
+  [[nodiscard]] inline pointer data() noexcept { return std::assume_aligned<NT_ALIGNMENT>(_memory); }
+
+  /*
+   * Returns a const pointer to the first element
+   */
+  [[nodiscard]] inline const_pointer data() const noexcept { return std::assume_aligned<NT_ALIGNMENT>(_memory); }
+
+  /*
+   * Returns a reference to the element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the element at the specified location
+   */
+  [[nodiscard]] inline reference operator[](std::size_t index) { return _memory[index]; }
+
+  /*
+   * Returns a const reference to the element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the element at the specified location
+   */
+  [[nodiscard]] inline const_reference operator[](std::size_t index) const { return _memory[index]; }
+
+  /*
+   * Returns a reference to the element at the specified location, with optional bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the element at the specified location
+   */
+  [[nodiscard]] inline reference at(std::size_t index) {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(index < _size);
+#endif
+    return _memory[index];
+  }
+
+  /*
+   * Returns a const reference to the element at the specified location, with optional bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the element at the specified location
+   */
+  [[nodiscard]] inline const_reference at(std::size_t index) const {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(index < _size);
+#endif
+    return _memory[index];
+  }
+
+  /*
+   * Returns the number of elements found in the buffer
+   * Parameters:
+   * @return: number of elements found in the buffer
+   */
+  [[nodiscard]] inline std::size_t size() const noexcept { return _size; }
+
+  /*
+   * Tells the operating system how the buffer's elements are going to be accessed
+   * Parameters:
+   * @param pattern: expected access pattern
+   */
+  void advise(access_pattern pattern) const noexcept {
+    if (_mapping) {
+      _mapping->advise(pattern, reinterpret_cast<const std::byte*>(_memory) - _mapping->data(), _size * sizeof(T));
+    }
+  }
+
+  /*
+   * Writes the changes of a shared mapping back to the file
+   */
+  void flush() const {
+    if (_mapping) {
+      _mapping->flush();
+    }
+  }
+};
+
+}  // namespace ntensor
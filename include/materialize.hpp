@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+#include "execute.hpp"
+#include "plane.hpp"
+
+namespace ntensor {
+
+inline namespace internal {
+
+/*
+ * Checks whether a plane has the strides that create_plane gives to a plane with the same dimensions (aligned or
+ * unaligned), meaning that its elements are stored from the innermost to the outermost dimension
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval bool has_canonical_strides() noexcept {
+  using plane_type = std::decay_t<Plane>;
+  using strides_type = std::decay_t<decltype(plane_type::strides())>;
+  using value_type = std::remove_const_t<typename plane_type::value_type>;
+  constexpr auto dimensions = plane_type::dimensions();
+
+  return std::is_same_v<strides_type, std::decay_t<decltype(compute_unaligned_strides(dimensions))>> ||
+         std::is_same_v<strides_type, std::decay_t<decltype(compute_aligned_strides<value_type>(dimensions))>>;
+}
+
+/*
+ * Finds the dimension of a plane whose elements are the closest to each other in the plane's buffer (the dimension with
+ * the smallest absolute stride). Dimensions of length 1 and dimensions with a stride of 0 are ignored, since iterating
+ * them doesn't move through the buffer
+ * Parameters:
+ * @tparam Plane: type of the plane
+ * @return: index of the dimension, or 0 if all dimensions are ignored
+ */
+template <typename Plane>
+[[nodiscard]] consteval std::size_t innermost_stored_dimension() noexcept {
+  using plane_type = std::decay_t<Plane>;
+  constexpr auto dimensions = plane_type::dimensions();
+  constexpr auto strides = plane_type::strides();
+
+  return [dimensions, strides]<std::size_t... is>(std::index_sequence<is...>) {
+    constexpr std::array dimensions_array{dimensions.template at<is>()...};
+    constexpr std::array strides_array{strides.template at<is>()...};
+
+    std::size_t innermost = 0u;
+    long long smallest_stride = 0;
+    for (std::size_t d = 0u; d < dimensions_array.size(); ++d) {
+      const long long stride = strides_array[d] < 0 ? -strides_array[d] : strides_array[d];
+      if (dimensions_array[d] == 1u || stride == 0) continue;
+      if (!smallest_stride || stride < smallest_stride) {
+        innermost = d;
+        smallest_stride = stride;
+      }
+    }
+    return innermost;
+  }(std::make_index_sequence<plane_type::rank()>());
+}
+
+/*
+ * Returns a view of the plane whose first dimension is the dimension 0, and whose second dimension is the given
+ * dimension. The remaining dimensions follow in their original order
+ * Parameters:
+ * @tparam second: dimension moved to the second position
+ * @param plane: plane that's viewed
+ */
+template <std::size_t second, typename Plane>
+[[nodiscard]] auto move_to_second_dimension(Plane& plane) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+
+  static constexpr auto order = [] {
+    std::array<std::size_t, rank> order{};
+    order[0u] = 0u;
+    order[1u] = second;
+    for (std::size_t d = 1u, i = 2u; d < rank; ++d) {
+      if (d != second) order[i++] = d;
+    }
+    return order;
+  }();
+
+  return [&plane]<std::size_t... is>(std::index_sequence<is...>) {
+    return plane.template like<permute<order[is]...>(plane_type::dimensions()),
+                               permute<order[is]...>(plane_type::strides())>();
+  }(std::make_index_sequence<rank>());
+}
+
+/*
+ * Side of the square blocks of elements copied by the blocked_transpose_copy method. A block of 32-bit values spans two
+ * cache lines per row, and a block of both planes fits into the L1 cache
+ */
+inline constexpr std::size_t transpose_block_size = 32u;
+
+/*
+ * Side of the square tiles of blocks copied by the blocked_transpose_copy method. The cache lines of a tile that are
+ * only partially used by a block (for example when the rows aren't aligned) stay in the L2 cache until the neighbouring
+ * block uses the rest of them
+ */
+inline constexpr std::size_t transpose_tile_size = 128u;
+
+/*
+ * Copies a block of elements of two planes of rank 2
+ * The function is inlined into the blocked_transpose_copy method, where the strides are constants, and the number of
+ * rows and columns of full blocks is a constant as well. The compiler is therefore free to unroll and vectorize the
+ * copy of the full blocks
+ * Parameters:
+ * @tparam channels: number of channels of the planes
+ * @param destination: first element of the destination block
+ * @param destination_strides: strides of the destination's rows and columns
+ * @param source: first element of the source block
+ * @param source_strides: strides of the source's rows and columns
+ * @param rows: number of rows of the block
+ * @param columns: number of columns of the block
+ */
+template <std::size_t channels, typename T, typename U>
+inline void copy_block(T* destination, std::array<long long, 2u> destination_strides, const U* source,
+                       std::array<long long, 2u> source_strides, std::size_t rows, std::size_t columns) noexcept {
+  for (std::size_t j = 0u; j < columns; ++j) {
+    for (std::size_t i = 0u; i < rows; ++i) {
+      const auto row = static_cast<long long>(i);
+      const auto column = static_cast<long long>(j);
+      const long long destination_position =
+          (row * destination_strides[0u] + column * destination_strides[1u]) * static_cast<long long>(channels);
+      const long long source_position =
+          (row * source_strides[0u] + column * source_strides[1u]) * static_cast<long long>(channels);
+      for (std::size_t c = 0u; c < channels; ++c) {
+        destination[destination_position + c] = source[source_position + c];
+      }
+    }
+  }
+}
+
+/*
+ * Copies the elements of a plane of rank 2 whose first dimension is contiguous in the destination, and whose second
+ * dimension is the innermost stored dimension of the source
+ * Walking either plane in its own order would access the other plane with a large stride, touching a new cache line
+ * for every element. Instead, the planes are copied in square blocks, so that the cache lines loaded from the source
+ * and written to the destination are used completely while they're still in the cache. The blocks are visited in
+ * larger tiles, since the rows of both planes are usually a power of two apart, so the rows of a single block compete
+ * for the same few cache sets
+ * Parameters:
+ * @param destination: plane to which the elements are copied
+ * @param source: plane from which the elements are copied
+ */
+template <typename Destination, typename Source>
+void blocked_transpose_copy(Destination& destination, const Source& source) {
+  using destination_type = std::decay_t<Destination>;
+  using source_type = std::decay_t<Source>;
+
+  static constexpr std::size_t rows = destination_type::dimensions().template at<0u>();
+  static constexpr std::size_t columns = destination_type::dimensions().template at<1u>();
+  static constexpr std::size_t channels = destination_type::channels();
+  static constexpr std::array<long long, 2u> destination_strides{destination_type::strides().template at<0u>(),
+                                                                 destination_type::strides().template at<1u>()};
+  static constexpr std::array<long long, 2u> source_strides{source_type::strides().template at<0u>(),
+                                                            source_type::strides().template at<1u>()};
+  static constexpr std::size_t block = transpose_block_size;
+  static constexpr std::size_t tile = transpose_tile_size;
+
+  auto* destination_data = destination.buffer().data() + destination.offset();
+  const auto* source_data = source.buffer().data() + source.offset();
+
+  auto copy = [&](std::size_t i, std::size_t j, std::size_t block_rows, std::size_t block_columns) {
+    const auto position = [i, j](const std::array<long long, 2u>& strides) {
+      return (static_cast<long long>(i) * strides[0u] + static_cast<long long>(j) * strides[1u]) *
+             static_cast<long long>(channels);
+    };
+    copy_block<channels>(destination_data + position(destination_strides), destination_strides,
+                         source_data + position(source_strides), source_strides, block_rows, block_columns);
+  };
+
+  for (std::size_t tj = 0u; tj < columns; tj += tile) {
+    for (std::size_t ti = 0u; ti < rows; ti += tile) {
+      for (std::size_t j = tj; j < std::min(tj + tile, columns); j += block) {
+        for (std::size_t i = ti; i < std::min(ti + tile, rows); i += block) {
+          if (i + block <= rows && j + block <= columns) [[likely]] {
+            copy(i, j, block, block);
+          } else {
+            copy(i, j, std::min(block, rows - i), std::min(block, columns - j));
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Implementation of the materialize_copy method. The first two dimensions of the planes are copied by
+ * blocked_transpose_copy, the remaining dimensions are iterated from the outermost one
+ */
+template <typename Destination, typename Source>
+void materialize_copy_impl(Destination&& destination, Source&& source) {
+  static constexpr std::size_t rank = std::decay_t<Destination>::rank();
+
+  if constexpr (rank > 2u) {
+    for (std::size_t i = 0u; i < std::decay_t<Destination>::dimensions().template at<rank - 1u>(); ++i) {
+      materialize_copy_impl(slice_outermost(destination, i), slice_outermost(source, i));
+    }
+  } else {
+    blocked_transpose_copy(destination, source);
+  }
+}
+
+/*
+ * Copies the elements of a plane into a plane with the same dimensions and canonical strides
+ * If the innermost stored dimension of the source is the innermost dimension of the destination, both planes are
+ * walked in the order of their memory, and the elements are copied using the execute method. Otherwise (for example if
+ * the source is a permuted plane), the copy is a transpose of those two dimensions, which is performed in blocks
+ * Parameters:
+ * @param destination: plane to which the elements are copied
+ * @param source: plane from which the elements are copied
+ */
+template <typename Destination, typename Source>
+void materialize_copy(Destination& destination, const Source& source) {
+  static constexpr std::size_t innermost = innermost_stored_dimension<Source>();
+  static constexpr bool exposes_memory = contiguous_buffer<typename std::decay_t<Destination>::buffer_type> &&
+                                         contiguous_buffer<typename std::decay_t<Source>::buffer_type>;
+
+  if constexpr (innermost == 0u || !exposes_memory) {
+    recursive_execute([](auto&& lhs, const auto& rhs) { lhs = rhs; }, destination, source);
+  } else {
+    materialize_copy_impl(move_to_second_dimension<innermost>(destination),
+                          move_to_second_dimension<innermost>(source));
+  }
+}
+
+}  // namespace internal
+
+/*
+ * Copies the elements of a plane into a newly created plane with the same dimensions and channels, and with aligned
+ * strides (as if the plane was created using create_plane)
+ * Operations like permute only reorder the strides of a plane, so a permuted plane accesses its buffer with large
+ * strides along its innermost dimension. Materializing such a plane stores its elements in their new order, which makes
+ * the following operations on it (or writing it to a stream) access the memory sequentially. The strides are inspected
+ * at compile time: planes whose innermost stored dimension isn't their innermost dimension are copied by transposing
+ * blocks of elements, instead of walking one of the planes across the whole buffer for every element
+ * Parameters:
+ * @tparam plane_idx: index of the plane that's materialized
+ * @param tensor: tensor whose plane is materialized
+ * @return: new tensor whose specified plane is replaced with the materialized plane
+ */
+template <std::size_t plane_idx = 0u, typename _Tensor>
+[[nodiscard]] auto materialize(_Tensor&& tensor) {
+  const auto& plane = tensor.planes().template plane<plane_idx>();
+  using plane_type = std::decay_t<decltype(plane)>;
+
+  auto materialized_plane =
+      create_plane<typename plane_type::buffer_type, plane_type::dimensions(), plane_type::channels()>();
+  materialize_copy(materialized_plane, plane);
+
+  const auto updated_planes = tensor.planes().template replace<plane_idx>(materialized_plane);
+  return tensor.like(updated_planes);
+}
+
+/*
+ * Returns a tensor whose specified plane stores its elements from the innermost to the outermost dimension
+ * If the plane already has aligned or unaligned strides, the same tensor is returned without copying any elements.
+ * Otherwise, the plane is materialized (see materialize)
+ * Parameters:
+ * @tparam plane_idx: index of the plane
+ * @param tensor: tensor whose plane has to be contiguous
+ */
+template <std::size_t plane_idx = 0u, typename _Tensor>
+[[nodiscard]] auto contiguous(_Tensor&& tensor) {
+  using plane_type = std::decay_t<decltype(tensor.planes().template plane<plane_idx>())>;
+
+  if constexpr (has_canonical_strides<plane_type>())
+    return tensor;
+  else
+    return materialize<plane_idx>(std::forward<_Tensor>(tensor));
+}
+
+}  // namespace ntensor
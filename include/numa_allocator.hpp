@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <fstream>
+#include <new>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "aligned_allocator.hpp"
+#include "dense_buffer.hpp"
+
+namespace ntensor {
+
+/*
+ * Placement of the pages of the memory allocated by the NumaAllocator
+ */
+enum class numa_placement {
+  // Each page is placed on the node of the thread that writes it first (the default policy of the operating system)
+  first_touch,
+  // The pages are spread round-robin over all nodes, so a pass over the memory uses the bandwidth of all of them
+  interleave,
+  // All pages are placed on a single node
+  bind
+};
+
+// NUMA-specific helper methods
+inline namespace internal {
+
+#ifdef __linux__
+// Memory policies of the mbind system call (see numaif.h), which is called directly to avoid a dependency on libnuma
+inline constexpr int numa_mpol_bind = 2;
+inline constexpr int numa_mpol_interleave = 3;
+#endif
+
+// Maximum number of nodes handled by the NumaAllocator
+inline constexpr std::size_t numa_max_nodes = 64u;
+
+/*
+ * Returns the mask of the online nodes, read from /sys/devices/system/node/online (for example "0-1,3")
+ * If the file can't be read, only the node 0 is reported
+ */
+[[nodiscard]] inline unsigned long long read_online_numa_nodes() {
+  std::ifstream file{"/sys/devices/system/node/online"};
+  std::string ranges;
+  if (!(file >> ranges)) return 1u;
+
+  unsigned long long mask = 0u;
+  std::size_t pos = 0u;
+  while (pos < ranges.size()) {
+    std::size_t end = 0u;
+    const std::size_t first = std::stoul(ranges.substr(pos), &end);
+    pos += end;
+
+    std::size_t last = first;
+    if (pos < ranges.size() && ranges[pos] == '-') {
+      last = std::stoul(ranges.substr(pos + 1u), &end);
+      pos += end + 1u;
+    }
+
+    for (std::size_t node = first; node <= std::min(last, numa_max_nodes - 1u); ++node) {
+      mask |= 1ull << node;
+    }
+    if (pos < ranges.size() && ranges[pos] == ',') ++pos;
+  }
+
+  return mask ? mask : 1u;
+}
+
+/*
+ * Returns the mask of the online nodes. The nodes are read once per process
+ */
+[[nodiscard]] inline unsigned long long online_numa_nodes() {
+  static const unsigned long long mask = [] {
+    try {
+      return read_online_numa_nodes();
+    } catch (...) {
+      return 1ull;
+    }
+  }();
+  return mask;
+}
+
+}  // namespace internal
+
+/*
+ * Returns the number of online NUMA nodes. Systems without NUMA support have a single node
+ */
+[[nodiscard]] inline std::size_t numa_node_count() {
+  return static_cast<std::size_t>(std::popcount(online_numa_nodes()));
+}
+
+/*
+ * Allocator placing the pages of large allocations on NUMA nodes
+ * By default, the memory of a buffer is placed on the node of the thread that constructs it, or on the nodes of the
+ * threads that write it first, so a large plane initialized by a single thread ends up on a single node, and parallel
+ * passes over it are limited by the bandwidth of that node. The NumaAllocator interleaves the pages over all nodes, or
+ * binds them to a single node, or leaves them to be placed by the first write (see create_plane with an execution
+ * policy, which writes the elements in parallel, in the same chunks as the parallel execute method)
+ * Allocations of at least a page are mapped directly from the operating system, so they start on a page boundary, and
+ * their placement is set before any page is written. Smaller allocations, and allocations on platforms other than
+ * Linux, are served by the AlignedMallocAllocator. The placement is a hint: if the operating system rejects it (for
+ * example, if the node doesn't exist), the pages are placed by the first write
+ * Parameters:
+ * @tparam T: memory type that needs to be allocated
+ */
+template <typename T>
+class NumaAllocator {
+ private:
+  numa_placement _placement{numa_placement::interleave};
+  std::size_t _node{0u};
+
+#ifdef __linux__
+  /*
+   * Returns the size of a page in bytes
+   */
+  [[nodiscard]] static std::size_t page_size() noexcept {
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  /*
+   * Checks whether an allocation of the specified number of bytes is mapped directly from the operating system
+   */
+  [[nodiscard]] static bool is_mapped(std::size_t bytes) noexcept {
+    return bytes >= page_size() && page_size() % NT_ALIGNMENT == 0u;
+  }
+
+  /*
+   * Rounds a number of bytes up to a multiple of the page size
+   */
+  [[nodiscard]] static std::size_t mapping_size(std::size_t bytes) noexcept {
+    return (bytes + page_size() - 1u) / page_size() * page_size();
+  }
+#endif
+
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = NumaAllocator<U>;
+  };
+
+  /*
+   * Creates an allocator interleaving the pages over all nodes
+   */
+  NumaAllocator() noexcept = default;
+
+  /*
+   * Creates an allocator with the given placement
+   * Parameters:
+   * @param placement: placement of the pages
+   * @param node: node on which the pages are placed with the bind placement. It's ignored by the other placements
+   */
+  explicit NumaAllocator(numa_placement placement, std::size_t node = 0u) noexcept
+      : _placement{placement}, _node{node} {}
+
+  /*
+   * Construct the allocator using a allocator with a different type. Both allocators use the same placement
+   */
+  template <typename U>
+  NumaAllocator(const NumaAllocator<U>& other) noexcept : _placement{other.placement()}, _node{other.node()} {}
+
+  /*
+   * Allocates n * sizeof(T) bytes of uninitialized storage, aligned to NT_ALIGNMENT
+   * Parameters:
+   * @param n: the number of objects to allocate storage for
+   * Exceptions:
+   * std::bad_alloc if the memory can't be allocated
+   */
+  [[nodiscard]] value_type* allocate(std::size_t n) {
+#ifdef __linux__
+    const std::size_t bytes = n * sizeof(value_type);
+    if (is_mapped(bytes)) {
+      const std::size_t size = mapping_size(bytes);
+      void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (memory == MAP_FAILED) {
+        throw std::bad_alloc{};
+      }
+
+      if (_placement != numa_placement::first_touch) {
+        const unsigned long mask = _placement == numa_placement::interleave
+                                       ? static_cast<unsigned long>(online_numa_nodes())
+                                       : 1ul << std::min(_node, numa_max_nodes - 1u);
+        const int mode = _placement == numa_placement::interleave ? numa_mpol_interleave : numa_mpol_bind;
+
+        // The kernel expects the number of bits of the mask plus one
+        ::syscall(SYS_mbind, memory, size, mode, &mask, numa_max_nodes + 1u, 0u);
+      }
+
+      return static_cast<value_type*>(memory);
+    }
+#endif
+    return AlignedMallocAllocator<T>{}.allocate(n);
+  }
+
+  /*
+   * Deallocates the storage referenced by the pointer p
+   * Parameters:
+   * @param p: pointer pointing to the allocated memory
+   * @param n: the number of objects that the storage was allocated for
+   */
+  void deallocate(value_type* p, std::size_t n) noexcept {
+    if (!p) return;
+#ifdef __linux__
+    const std::size_t bytes = n * sizeof(value_type);
+    if (is_mapped(bytes)) {
+      ::munmap(p, mapping_size(bytes));
+      return;
+    }
+#endif
+    AlignedMallocAllocator<T>{}.deallocate(p, n);
+  }
+
+  /*
+   * Returns the placement of the pages
+   */
+  [[nodiscard]] numa_placement placement() const noexcept { return _placement; }
+
+  /*
+   * Returns the node on which the pages are placed with the bind placement
+   */
+  [[nodiscard]] std::size_t node() const noexcept { return _node; }
+
+  /*
+   * Compares two allocators. Any allocator can deallocate the memory of another one, so two allocators are always
+   * equal
+   */
+  template <typename U>
+  [[nodiscard]] friend bool operator==(const NumaAllocator&, const NumaAllocator<U>&) noexcept {
+    return true;
+  }
+};
+
+/*
+ * Dense buffer whose pages are placed on NUMA nodes by the NumaAllocator
+ */
+template <arithmetic T>
+using NumaBuffer = DenseBuffer<T, NumaAllocator<T>>;
+
+}  // namespace ntensor
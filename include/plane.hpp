@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include <iostream>
 
 #include "dimensions.hpp"
@@ -278,6 +279,20 @@ class Plane {
    * @return: total allocated size
    */
   [[nodiscard]] inline std::size_t real_size() const noexcept { return _buffer.size(); }
+
+  /*
+   * Returns the plane's buffer
+   * Parameters:
+   * @return: reference to the buffer representing the plane's memory
+   */
+  [[nodiscard]] inline Buffer& buffer() noexcept { return _buffer; }
+
+  /*
+   * Returns the plane's buffer
+   * Parameters:
+   * @return: const reference to the buffer representing the plane's memory
+   */
+  [[nodiscard]] inline const Buffer& buffer() const noexcept { return _buffer; }
 };
 
 /*
@@ -305,4 +320,32 @@ template <typename BufferType, Dimensions dimensions, std::size_t channels = 1u,
   }
 }
 
+/*
+ * Helper method used for creating a plane whose buffer needs additional constructor arguments, for example a plane
+ * stored in a memory mapped file
+ * The buffer is constructed with the given arguments followed by the number of elements the plane needs
+ * Parameters:
+ * @tparam BufferType: Type of the underlying buffer
+ * @tparam dimensions: Dimensions of the newly created plane
+ * @tparam channels: Number of channels fo the newly created plane
+ * @tparam aligned_strides: Variable determining whether the plane should have aligned or unaligned strides
+ * @param buffer_args: arguments passed to the buffer's constructor before the number of elements
+ */
+template <typename BufferType, Dimensions dimensions, std::size_t channels = 1u, bool aligned_strides = true,
+          typename... BufferArgs>
+  requires(sizeof...(BufferArgs) > 0u && std::constructible_from<BufferType, BufferArgs..., std::size_t>)
+[[nodiscard]] auto create_plane(BufferArgs&&... buffer_args) {
+  static constexpr auto strides = [] {
+    if constexpr (aligned_strides) {
+      return compute_aligned_strides<typename BufferType::value_type>(dimensions);
+    } else {
+      return compute_unaligned_strides(dimensions);
+    }
+  }();
+  constexpr auto max_size = max_product(dimensions, strides);
+  static_assert(max_size > 0);
+  BufferType buffer{std::forward<BufferArgs>(buffer_args)..., static_cast<std::size_t>(max_size * channels)};
+  return Plane<BufferType, dimensions, strides, channels>{std::move(buffer)};
+}
+
 }  // namespace ntensor
@@ -0,0 +1,537 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "dense_buffer.hpp"
+#include "execute.hpp"
+#include "plane.hpp"
+#include "tensor.hpp"
+
+namespace ntensor {
+
+inline namespace internal {
+
+/*
+ * Number of independent accumulators used while reducing a row of elements
+ * Several accumulators break the dependency chain between consecutive operations, which allows the processor to
+ * execute them in parallel
+ */
+inline constexpr std::size_t reduction_accumulators = 4u;
+
+/*
+ * Returns the element at the specified position of a plane
+ * The subscript operator is used when the plane's buffer supports it, since it doesn't perform bounds checking
+ * Parameters:
+ * @param plane: plane from which the element is retrieved
+ * @param position: position of the element inside the plane's buffer, relative to the plane's offset
+ * @return: element at the specified position
+ */
+template <typename Plane>
+[[nodiscard]] inline decltype(auto) reduced_element(Plane&& plane, std::size_t position) {
+  if constexpr (requires { plane[position]; }) {
+    return plane[position];
+  } else {
+    return plane.at(position);
+  }
+}
+
+/*
+ * Combines the values of an array using a tree of operations
+ * Parameters:
+ * @param values: array of values
+ * @param op: binary operation used for combining the values
+ * @return: combined value
+ */
+template <typename T, std::size_t N, typename ReduceOp>
+[[nodiscard]] inline T tree_reduce(const std::array<T, N>& values, ReduceOp& op) {
+  if constexpr (N == 1u) {
+    return values[0u];
+  } else {
+    return [&values, &op]<std::size_t... is>(std::index_sequence<is...>) {
+      static constexpr std::size_t half = N / 2u;
+      return op(tree_reduce(std::array<T, half>{values[is]...}, op),
+                tree_reduce(std::array<T, N - half>{values[half + is]...}, op));
+    }(std::make_index_sequence<N / 2u>());
+  }
+}
+
+/*
+ * Checks whether a row of a plane can be reduced using simd packs
+ * Parameters:
+ * @tparam vectorize: true if simd packs are allowed to be used, false otherwise
+ * @tparam T: type of the reduced value
+ * @tparam Plane: type of the plane
+ * @tparam ReduceOp: binary operation used for the reduction
+ * @tparam TransformOp: unary operation applied to each element before the reduction
+ */
+template <bool vectorize, typename T, typename Plane, typename ReduceOp, typename TransformOp>
+[[nodiscard]] consteval bool is_reduction_vectorizable() noexcept {
+  using plane_type = std::decay_t<Plane>;
+
+  // The operations are instantiated with packs only if vectorization is allowed, since generic operations might not
+  // support them
+  if constexpr (!vectorize) {
+    return false;
+  } else if constexpr (plane_type::strides().template at<0u>() == 1 &&
+                       contiguous_buffer<typename plane_type::buffer_type> &&
+                       std::same_as<std::remove_cv_t<typename plane_type::value_type>, T>) {
+    using pack_type = simd_pack<T, simd_width_v<T>>;
+    return std::is_invocable_r_v<pack_type, TransformOp&, const pack_type&> &&
+           std::is_invocable_r_v<pack_type, ReduceOp&, const pack_type&, const pack_type&>;
+  } else {
+    return false;
+  }
+}
+
+/*
+ * Reduces the elements in the range [first, last) of the innermost dimension of a plane
+ * The elements are distributed over several accumulators, which are combined at the end. If the reduction is
+ * vectorized, each accumulator is a simd pack instead of a single value
+ * Parameters:
+ * @tparam T: type of the reduced value
+ * @tparam vectorize: true if simd packs are allowed to be used, false otherwise
+ * @param plane: plane of rank 1
+ * @param first: index of the first reduced element
+ * @param last: index following the last reduced element
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @return: reduced value
+ * Constraints:
+ * The range has to contain at least one element
+ */
+template <typename T, bool vectorize, typename Plane, typename ReduceOp, typename TransformOp>
+[[nodiscard]] T reduce_innermost(Plane&& plane, std::size_t first, std::size_t last, ReduceOp& op,
+                                 TransformOp& transform) {
+  using plane_type = std::decay_t<Plane>;
+  static_assert(plane_type::rank() == 1u);
+  static constexpr std::size_t channels = plane_type::channels();
+  static constexpr long long stride = plane_type::strides().template at<0u>();
+
+  std::size_t k = first * channels;
+  const std::size_t end = last * channels;
+
+  if constexpr (is_reduction_vectorizable<vectorize, T, Plane, ReduceOp, TransformOp>()) {
+    using pack_type = simd_pack<T, simd_width_v<T>>;
+    static constexpr std::size_t width = pack_type::size();
+    const auto* data = &plane[0u];
+
+    std::optional<T> result;
+    auto accumulate = [&result, &op](const T& value) { result = result ? static_cast<T>(op(*result, value)) : value; };
+
+    // Process single elements until the memory is aligned to the size of a pack
+    const auto address = reinterpret_cast<std::uintptr_t>(data + k);
+    std::size_t head = address % sizeof(T) ? 0u : (sizeof(pack_type) - address % sizeof(pack_type)) % sizeof(pack_type);
+    head = std::min(head / sizeof(T), end - k);
+    for (const std::size_t head_end = k + head; k < head_end; ++k) {
+      accumulate(static_cast<T>(transform(data[k])));
+    }
+
+    if (end - k >= width) {
+      pack_type accumulator = transform(pack_type::load(data + k));
+      for (k += width; k + width <= end; k += width) {
+        accumulator = op(accumulator, transform(pack_type::load(data + k)));
+      }
+
+      for (std::size_t lane = 0u; lane < width; ++lane) {
+        accumulate(accumulator[lane]);
+      }
+    }
+
+    for (; k < end; ++k) {
+      accumulate(static_cast<T>(transform(data[k])));
+    }
+
+    return *result;
+  } else {
+    auto value = [&plane, &transform](std::size_t idx) -> T {
+      if constexpr (channels == 1u) {
+        return static_cast<T>(transform(reduced_element(plane, idx * stride)));
+      } else if constexpr (stride == 1) {
+        return static_cast<T>(transform(reduced_element(plane, idx)));
+      } else {
+        return static_cast<T>(transform(reduced_element(plane, idx / channels * stride * channels + idx % channels)));
+      }
+    };
+
+    if (end - k < reduction_accumulators) {
+      T result = value(k++);
+      for (std::size_t i = 1u; i < reduction_accumulators && k < end; ++i, ++k) {
+        result = op(result, value(k));
+      }
+      return result;
+    }
+
+    auto accumulators = [&value, k]<std::size_t... is>(std::index_sequence<is...>) {
+      return std::array<T, reduction_accumulators>{value(k + is)...};
+    }(std::make_index_sequence<reduction_accumulators>());
+
+    for (k += reduction_accumulators; k + reduction_accumulators <= end; k += reduction_accumulators) {
+      [&accumulators, &value, &op, k]<std::size_t... is>(std::index_sequence<is...>) {
+        ((accumulators[is] = op(accumulators[is], value(k + is))), ...);
+      }(std::make_index_sequence<reduction_accumulators>());
+    }
+
+    // Fewer elements than accumulators are left
+    for (std::size_t i = 1u; i < reduction_accumulators && k < end; ++i, ++k) {
+      accumulators[0u] = op(accumulators[0u], value(k));
+    }
+
+    return tree_reduce(accumulators, op);
+  }
+}
+
+/*
+ * Reduces the elements of a plane whose index in the outermost dimension is in the range [first, last)
+ * Parameters:
+ * @tparam T: type of the reduced value
+ * @tparam vectorize: true if simd packs are allowed to be used, false otherwise
+ * @param plane: reduced plane
+ * @param first: first index of the outermost dimension
+ * @param last: index following the last index of the outermost dimension
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @return: reduced value
+ * Constraints:
+ * The range has to contain at least one index
+ */
+template <typename T, bool vectorize, typename Plane, typename ReduceOp, typename TransformOp>
+[[nodiscard]] T reduce_plane(Plane&& plane, std::size_t first, std::size_t last, ReduceOp& op,
+                             TransformOp& transform) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+
+  if constexpr (rank > 1u) {
+    static constexpr auto reduced_dimensions = remove_nth_element<rank - 1u>(plane_type::dimensions());
+    static constexpr auto reduced_strides = remove_nth_element<rank - 1u>(plane_type::strides());
+    static constexpr std::size_t extent = reduced_dimensions.template at<rank - 2u>();
+    static constexpr long long stride = plane_type::strides().template at<rank - 1u>() * plane_type::channels();
+
+    T result = reduce_plane<T, vectorize>(
+        plane.template like<reduced_dimensions, reduced_strides>(static_cast<long long>(first) * stride), 0u, extent,
+        op, transform);
+    for (std::size_t i = first + 1u; i < last; ++i) {
+      result = op(result,
+                  reduce_plane<T, vectorize>(plane.template like<reduced_dimensions, reduced_strides>(
+                                                 static_cast<long long>(i) * stride),
+                                             0u, extent, op, transform));
+    }
+    return result;
+  } else {
+    return reduce_innermost<T, vectorize>(plane, first, last, op, transform);
+  }
+}
+
+/*
+ * Reduces all elements of a plane using the specified execution policy
+ * With the parallel policy, the outermost dimension is split into chunks which are reduced on a thread pool. The
+ * partial results are combined in the order of the chunks
+ * Parameters:
+ * @tparam T: type of the reduced value
+ * @param policy: execution policy
+ * @param plane: reduced plane
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @return: reduced value
+ */
+template <typename T, typename Policy, typename Plane, typename ReduceOp, typename TransformOp>
+[[nodiscard]] T reduce_whole_plane(Policy&& policy, Plane&& plane, ReduceOp& op, TransformOp& transform) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  static constexpr std::size_t extent = plane_type::dimensions().template at<rank - 1u>();
+
+  if constexpr (is_parallel_policy_v<Policy>) {
+    static constexpr long long stride = plane_type::strides().template at<rank - 1u>();
+    static constexpr std::size_t elements_per_iteration =
+        product(plane_type::dimensions()) / extent * plane_type::channels();
+
+    ThreadPool& pool = policy.pool();
+    const std::size_t grain = parallel_grain<typename plane_type::value_type>(
+        extent, stride * static_cast<long long>(plane_type::channels()), elements_per_iteration, pool.size());
+    std::vector<std::optional<T>> partial_results((extent + grain - 1u) / grain);
+
+    pool.parallel_for(0u, extent, grain, [&](std::size_t first, std::size_t last) {
+      partial_results[first / grain] = reduce_plane<T, false>(plane, first, last, op, transform);
+    });
+
+    T result = *partial_results[0u];
+    for (std::size_t i = 1u; i < partial_results.size(); ++i) {
+      result = op(result, *partial_results[i]);
+    }
+    return result;
+  } else {
+    return reduce_plane<T, is_unsequenced_policy_v<Policy>>(plane, 0u, extent, op, transform);
+  }
+}
+
+/*
+ * Removes the elements on the specified positions from a value sequence
+ * Parameters:
+ * @tparam axis: position of the first removed element
+ * @tparam axes: positions of the other removed elements, in descending order
+ * @param sequence: object holding the value sequence
+ * @return: object holding the reduced value sequence
+ */
+template <std::size_t axis, std::size_t... axes, typename Sequence>
+[[nodiscard]] consteval auto remove_elements(Sequence) noexcept {
+  // The elements are removed starting from the highest position, so that the lower positions remain valid
+  constexpr auto reduced_sequence = remove_nth_element<axis>(Sequence{});
+
+  if constexpr (sizeof...(axes) == 0u) {
+    return reduced_sequence;
+  } else {
+    return remove_elements<axes...>(reduced_sequence);
+  }
+}
+
+/*
+ * Removes the dimensions (or strides) on the specified positions
+ * Parameters:
+ * @tparam axes: positions of the removed elements, in any order
+ * @param sequence: object holding the dimensions or strides
+ * @return: object holding the reduced dimensions or strides
+ */
+template <std::size_t... axes, typename Sequence>
+[[nodiscard]] consteval auto remove_axes(Sequence sequence) noexcept {
+  return [sequence]<std::size_t... is>(std::index_sequence<is...>) {
+    constexpr auto sorted_axes = sort<axes...>(std::greater<>{});
+    return remove_elements<sorted_axes[is]...>(sequence);
+  }(std::make_index_sequence<sizeof...(axes)>());
+}
+
+/*
+ * Creates strides for viewing a reduced plane with the dimensions of the original plane
+ * The reduced axes get a stride of 0, so all elements along a reduced axis map to the same element of the reduced plane
+ * Parameters:
+ * @tparam rank: rank of the original plane
+ * @tparam axes: reduced axes
+ * @tparam strides: strides of the reduced plane
+ * @return: strides of the view
+ */
+template <std::size_t rank, std::size_t... axes, long long... strides>
+[[nodiscard]] consteval auto broadcast_strides(Strides<strides...>) noexcept {
+  constexpr auto broadcast_strides_array = [] {
+    constexpr std::array<long long, sizeof...(strides)> reduced_strides{strides...};
+    std::array<long long, rank> result{};
+    std::size_t idx = 0u;
+    for (std::size_t i = 0u; i < rank; ++i) {
+      result[i] = ((i == axes) || ...) ? 0 : reduced_strides[idx++];
+    }
+    return result;
+  }();
+
+  return [broadcast_strides_array]<std::size_t... is>(std::index_sequence<is...>) {
+    return Strides<broadcast_strides_array[is]...>{};
+  }(std::make_index_sequence<rank>());
+}
+
+/*
+ * Reduces the elements of a plane into a destination plane of the same shape, in which the reduced axes have a stride
+ * of 0. Each element of the source plane is combined with the destination element it maps to
+ * Parameters:
+ * @tparam vectorize: true if simd packs are allowed to be used for reductions along the innermost dimension
+ * @param destination: destination plane (a view with broadcast strides)
+ * @param source: reduced plane
+ * @param first: first index of the outermost dimension
+ * @param last: index following the last index of the outermost dimension
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ */
+template <bool vectorize, typename Destination, typename Source, typename ReduceOp, typename TransformOp>
+void reduce_into(Destination&& destination, Source&& source, std::size_t first, std::size_t last, ReduceOp& op,
+                 TransformOp& transform) {
+  using destination_type = std::decay_t<Destination>;
+  using source_type = std::decay_t<Source>;
+  using T = typename destination_type::value_type;
+  static constexpr std::size_t rank = source_type::rank();
+  static constexpr std::size_t channels = source_type::channels();
+  static constexpr long long destination_stride = destination_type::strides().template at<rank - 1u>();
+  static constexpr long long source_stride = source_type::strides().template at<rank - 1u>();
+
+  if constexpr (rank > 1u) {
+    static constexpr auto reduced_dimensions = remove_nth_element<rank - 1u>(source_type::dimensions());
+    static constexpr std::size_t extent = reduced_dimensions.template at<rank - 2u>();
+
+    for (std::size_t i = first; i < last; ++i) {
+      reduce_into<vectorize>(
+          destination.template like<reduced_dimensions, remove_nth_element<rank - 1u>(destination_type::strides())>(
+              static_cast<long long>(i) * destination_stride * channels),
+          source.template like<reduced_dimensions, remove_nth_element<rank - 1u>(source_type::strides())>(
+              static_cast<long long>(i) * source_stride * channels),
+          0u, extent, op, transform);
+    }
+  } else if constexpr (destination_stride == 0 && channels == 1u) {
+    // The innermost dimension is reduced into a single element, so it can be reduced using several accumulators
+    destination[0u] = op(destination[0u], reduce_innermost<T, vectorize>(source, first, last, op, transform));
+  } else {
+    for (std::size_t d = first; d < last; ++d) {
+      for (std::size_t c = 0u; c < channels; ++c) {
+        auto& element = destination[d * destination_stride * channels + c];
+        element = op(element, static_cast<T>(transform(reduced_element(source, d * source_stride * channels + c))));
+      }
+    }
+  }
+}
+
+/*
+ * Reduces a plane along the specified axes
+ * Parameters:
+ * @tparam axes: reduced axes
+ * @param policy: execution policy
+ * @param plane: reduced plane
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @param init: initial value of each element of the reduced plane
+ * @return: new plane, without the reduced axes
+ */
+template <std::size_t... axes, typename Policy, typename Plane, typename ReduceOp, typename TransformOp, typename T>
+[[nodiscard]] auto reduce_plane_axes(Policy&& policy, Plane&& plane, ReduceOp& op, TransformOp& transform,
+                                     const T& init) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  static constexpr std::size_t channels = plane_type::channels();
+
+  static_assert(((axes < rank) && ...), "The reduced axes have to be lower than the rank of the plane");
+  static_assert(
+      [] {
+        constexpr auto sorted_axes = sort<axes...>(std::less<>{});
+        return std::adjacent_find(sorted_axes.begin(), sorted_axes.end()) == sorted_axes.end();
+      }(),
+      "The reduced axes have to be unique");
+  static_assert(sizeof...(axes) < rank, "Reducing all axes produces a single value, use reduce without axes instead");
+
+  static constexpr auto reduced_dimensions = remove_axes<axes...>(plane_type::dimensions());
+  auto reduced_plane = create_plane<DenseBuffer<T>, reduced_dimensions, channels>();
+  static constexpr auto view_strides =
+      broadcast_strides<rank, axes...>(std::decay_t<decltype(reduced_plane)>::strides());
+  auto view = reduced_plane.template like<plane_type::dimensions(), view_strides>();
+
+  recursive_execute([&init](T& element) { element = init; }, reduced_plane);
+
+  static constexpr std::size_t extent = plane_type::dimensions().template at<rank - 1u>();
+  static constexpr bool is_outermost_axis_reduced = ((axes == rank - 1u) || ...);
+
+  // Chunks of the outermost dimension write into disjoint elements only if the outermost axis isn't reduced
+  if constexpr (is_parallel_policy_v<Policy> && !is_outermost_axis_reduced) {
+    static constexpr long long stride = plane_type::strides().template at<rank - 1u>();
+    static constexpr std::size_t elements_per_iteration = product(plane_type::dimensions()) / extent * channels;
+
+    ThreadPool& pool = policy.pool();
+    const std::size_t grain = parallel_grain<T>(extent, stride * static_cast<long long>(channels),
+                                                elements_per_iteration, pool.size());
+    pool.parallel_for(0u, extent, grain, [&](std::size_t first, std::size_t last) {
+      reduce_into<false>(view, plane, first, last, op, transform);
+    });
+  } else {
+    reduce_into<is_unsequenced_policy_v<Policy>>(view, plane, 0u, extent, op, transform);
+  }
+
+  return reduced_plane;
+}
+
+/*
+ * Implementation of the reduce and transform_reduce methods
+ */
+template <std::size_t... axes, typename Policy, typename Tensor, typename ReduceOp, typename TransformOp, typename T>
+[[nodiscard]] auto transform_reduce_impl(Policy&& policy, Tensor&& tensor, ReduceOp& op, TransformOp& transform,
+                                         T init) {
+  if constexpr (sizeof...(axes) == 0u) {
+    for_each_plane(
+        [&policy, &op, &transform, &init](auto&& plane) {
+          init = op(init, reduce_whole_plane<T>(policy, plane, op, transform));
+        },
+        tensor);
+    return init;
+  } else {
+    static constexpr std::size_t N = std::decay_t<decltype(tensor.planes())>::size();
+    return [&]<std::size_t... is>(std::index_sequence<is...>) {
+      return tensor.like(Planes{reduce_plane_axes<axes...>(policy, tensor.planes().template plane<is>(), op,
+                                                           transform, init)...});
+    }(std::make_index_sequence<N>());
+  }
+}
+
+}  // namespace internal
+
+/*
+ * Applies a transformation to each element of a tensor, and reduces the transformed elements using the specified
+ * execution policy
+ * If no axes are specified, all elements of all planes are reduced into a single value. Otherwise, each plane is
+ * reduced along the specified axes, and a new tensor is returned whose planes don't contain the reduced axes. The
+ * planes of the new tensor are stored in DenseBuffers, and their elements are initialized with the initial value
+ * Each row is reduced using several independent accumulators (or simd packs with the unsequenced policy). With the
+ * parallel policy, the outermost dimension is split into chunks which are reduced on a thread pool. When reducing along
+ * axes, the parallel policy is used only if the outermost axis isn't reduced
+ * Parameters:
+ * @tparam axes: reduced axes, starting from 0 for the innermost dimension
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param tensor: reduced tensor
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @param init: initial value of the reduction
+ * @return: reduced value, or a new tensor if axes are specified
+ * Constraints:
+ * The op has to be associative and commutative, since the elements aren't reduced in order
+ * With the unsequenced policy, op and transform have to accept simd packs if they're generic
+ */
+template <std::size_t... axes, execution_policy Policy, typename Tensor, typename ReduceOp, typename TransformOp,
+          typename T>
+[[nodiscard]] auto transform_reduce(Policy&& policy, Tensor&& tensor, ReduceOp op, TransformOp transform, T init) {
+  return transform_reduce_impl<axes...>(policy, tensor, op, transform, std::move(init));
+}
+
+/*
+ * Applies a transformation to each element of a tensor, and reduces the transformed elements
+ * See the overload taking an execution policy for details
+ * Parameters:
+ * @tparam axes: reduced axes, starting from 0 for the innermost dimension
+ * @param tensor: reduced tensor
+ * @param op: binary operation used for the reduction
+ * @param transform: unary operation applied to each element before the reduction
+ * @param init: initial value of the reduction
+ * @return: reduced value, or a new tensor if axes are specified
+ */
+template <std::size_t... axes, typename Tensor, typename ReduceOp, typename TransformOp, typename T>
+  requires(!execution_policy<Tensor>)
+[[nodiscard]] auto transform_reduce(Tensor&& tensor, ReduceOp op, TransformOp transform, T init) {
+  return transform_reduce<axes...>(seq, std::forward<Tensor>(tensor), std::move(op), std::move(transform),
+                                   std::move(init));
+}
+
+/*
+ * Reduces the elements of a tensor using the specified execution policy
+ * See the transform_reduce method for details
+ * Parameters:
+ * @tparam axes: reduced axes, starting from 0 for the innermost dimension
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param tensor: reduced tensor
+ * @param op: binary operation used for the reduction
+ * @param init: initial value of the reduction
+ * @return: reduced value, or a new tensor if axes are specified
+ */
+template <std::size_t... axes, execution_policy Policy, typename Tensor, typename ReduceOp, typename T>
+[[nodiscard]] auto reduce(Policy&& policy, Tensor&& tensor, ReduceOp op, T init) {
+  return transform_reduce<axes...>(std::forward<Policy>(policy), std::forward<Tensor>(tensor), std::move(op),
+                                   std::identity{}, std::move(init));
+}
+
+/*
+ * Reduces the elements of a tensor
+ * See the transform_reduce method for details
+ * Parameters:
+ * @tparam axes: reduced axes, starting from 0 for the innermost dimension
+ * @param tensor: reduced tensor
+ * @param op: binary operation used for the reduction
+ * @param init: initial value of the reduction
+ * @return: reduced value, or a new tensor if axes are specified
+ */
+template <std::size_t... axes, typename Tensor, typename ReduceOp, typename T>
+  requires(!execution_policy<Tensor>)
+[[nodiscard]] auto reduce(Tensor&& tensor, ReduceOp op, T init) {
+  return transform_reduce<axes...>(seq, std::forward<Tensor>(tensor), std::move(op), std::identity{}, std::move(init));
+}
+
+}  // namespace ntensor
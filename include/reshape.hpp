@@ -1,11 +1,81 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "assert.hpp"
+#include "dynamic_plane.hpp"
 #include "execute.hpp"
+#include "plane.hpp"
 
 namespace ntensor {
 
+/*
+ * Ways in which reshape treats planes that can't be reshaped by only changing their strides (for example planes with a
+ * padding between their first and second dimension, or planes with negative strides)
+ * materialize: the elements are copied into a newly created plane
+ * view: the reshaped plane accesses the elements of the original plane through a ReshapedBuffer, so nothing is copied
+ * or allocated
+ */
+enum class reshape_mode { materialize, view };
+
 inline namespace internal {
 
+/*
+ * Dimensions and strides of a plane, where the dimensions of length 1 are removed, and the neighbouring dimensions
+ * whose elements follow each other in the buffer are merged into a single dimension
+ * Parameters:
+ * @tparam max_rank: rank of the plane
+ */
+template <std::size_t max_rank>
+struct merged_layout {
+  std::array<std::size_t, max_rank> dimensions{};
+  std::array<long long, max_rank> strides{};
+  std::size_t rank{};
+};
+
+/*
+ * Computes the merged layout of a plane (see merged_layout)
+ * Parameters:
+ * @tparam Plane: type of the plane
+ */
+template <typename Plane>
+[[nodiscard]] consteval auto merge_dimensions() noexcept {
+  using plane_type = std::decay_t<Plane>;
+  constexpr auto dimensions = plane_type::dimensions();
+  constexpr auto strides = plane_type::strides();
+
+  return [dimensions, strides]<std::size_t... is>(std::index_sequence<is...>) {
+    constexpr std::array dimensions_array{dimensions.template at<is>()...};
+    constexpr std::array strides_array{strides.template at<is>()...};
+
+    merged_layout<sizeof...(is)> layout;
+    for (std::size_t d = 0u; d < dimensions_array.size(); ++d) {
+      if (dimensions_array[d] == 1u) continue;
+
+      const std::size_t last = layout.rank - 1u;
+      if (layout.rank &&
+          strides_array[d] == layout.strides[last] * static_cast<long long>(layout.dimensions[last])) {
+        layout.dimensions[last] *= dimensions_array[d];
+      } else {
+        layout.dimensions[layout.rank] = dimensions_array[d];
+        layout.strides[layout.rank] = strides_array[d];
+        ++layout.rank;
+      }
+    }
+
+    // A plane whose dimensions all have a length of 1 consists of a single element
+    if (!layout.rank) {
+      layout.dimensions[0u] = 1u;
+      layout.rank = 1u;
+    }
+
+    return layout;
+  }(std::make_index_sequence<plane_type::rank()>());
+}
+
 /*
  * Implementation of the can_reshape_in_place method
  */
@@ -61,15 +131,139 @@ template <std::size_t initial_dimension, std::size_t... reshaped_dimensions>
 
 }  // namespace internal
 
+/*
+ * Buffer that presents the elements of a plane in their logical order, from the innermost to the outermost dimension
+ * Element i of the buffer is the element whose index is i when the plane is iterated, so a plane with unaligned
+ * strides created on top of this buffer is a reshaped view of the original plane. The index is mapped to the position
+ * in the original plane using the plane's strides, after merging its dimensions whose elements follow each other in
+ * memory. A plane with a padding between its first and second dimension therefore needs a single division by a
+ * constant per access
+ * The buffer stores a copy of the plane, and the plane's buffer shares its memory with the original plane's buffer, so
+ * writing to the buffer modifies the original plane
+ * Parameters:
+ * @tparam Plane: type of the viewed plane
+ */
+template <typename Plane>
+class ReshapedBuffer {
+ private:
+  static constexpr auto _layout = merge_dimensions<Plane>();
+  static constexpr std::size_t _channels = Plane::channels();
+
+  Plane _plane;
+
+  /*
+   * Computes the position of an element in the viewed plane
+   * The division of the negative positions (caused by negative strides) wraps around, and is reverted once the plane
+   * adds its offset to the position
+   */
+  [[nodiscard]] static std::size_t position(std::size_t index) noexcept {
+    std::size_t element = index / _channels;
+    long long position = 0;
+
+    [&position, &element]<std::size_t... is>(std::index_sequence<is...>) {
+      ((position += static_cast<long long>(is + 1u < _layout.rank ? element % _layout.dimensions[is] : element) *
+                    _layout.strides[is],
+        element /= _layout.dimensions[is]),
+       ...);
+    }(std::make_index_sequence<_layout.rank>());
+
+    return static_cast<std::size_t>(position * static_cast<long long>(_channels)) + index % _channels;
+  }
+
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename Plane::pointer;
+  using const_pointer = typename Plane::const_pointer;
+  using reference = typename Plane::reference;
+  using const_reference = typename Plane::const_reference;
+  using value_type = typename Plane::value_type;
+
+  /*
+   * Default constructor
+   */
+  ReshapedBuffer() noexcept = default;
+
+  /*
+   * Creates a buffer viewing the elements of the given plane
+   * Parameters:
+   * @param plane: viewed plane
+   */
+  explicit ReshapedBuffer(const Plane& plane) : _plane{plane} {}
+
+  /*
+   * Compares two buffers
+   * Two buffers are equal if they view the same plane
+   */
+  [[nodiscard]] friend bool operator==(const ReshapedBuffer& lhs, const ReshapedBuffer& rhs) noexcept {
+    return lhs._plane == rhs._plane;
+  }
+
+  /*
+   * Returns a reference to the element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the element at the specified location
+   */
+  [[nodiscard]] inline reference operator[](std::size_t index) { return _plane[position(index)]; }
+
+  /*
+   * Returns a const reference to the element at the specified location, without bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the element at the specified location
+   */
+  [[nodiscard]] inline const_reference operator[](std::size_t index) const { return _plane[position(index)]; }
+
+  /*
+   * Returns a reference to the element at the specified location, with optional bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: reference to the element at the specified location
+   */
+  [[nodiscard]] inline reference at(std::size_t index) {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(index < size());
+#endif
+    return _plane.at(position(index));
+  }
+
+  /*
+   * Returns a const reference to the element at the specified location, with optional bounds checking
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const reference to the element at the specified location
+   */
+  [[nodiscard]] inline const_reference at(std::size_t index) const {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(index < size());
+#endif
+    return _plane.at(position(index));
+  }
+
+  /*
+   * Returns the number of elements in the buffer (the number of elements of the viewed plane, including its channels)
+   */
+  [[nodiscard]] inline std::size_t size() const noexcept { return product(Plane::dimensions()) * _channels; }
+
+  /*
+   * Returns the viewed plane
+   */
+  [[nodiscard]] inline const Plane& plane() const noexcept { return _plane; }
+};
+
 /*
  * Changes the shape of a plane without changing its underlying data
  * Parameters:
  * @tparam reshaped_dimensions: New dimensions of the plane. The product of these has to be equal to the product of the
  * old dimensions
  * @tparam plane_idx: Index of the plane whose shape we're modifying
+ * @tparam mode: What to do if the plane can't be reshaped by only changing its strides: copy its elements into a new
+ * plane, or view them through a ReshapedBuffer (see reshape_mode)
  * @param tensor: Tensor on whom the operation will be performed
  */
-template <Dimensions reshaped_dimensions, std::size_t plane_idx = 0u, typename _Tensor>
+template <Dimensions reshaped_dimensions, std::size_t plane_idx = 0u, reshape_mode mode = reshape_mode::materialize,
+          typename _Tensor>
 [[nodiscard]] auto reshape(_Tensor&& tensor) {
   auto plane = tensor.planes().template plane<plane_idx>();
   static constexpr auto dimensions = std::decay_t<decltype(plane)>::dimensions();
@@ -175,6 +369,15 @@ template <Dimensions reshaped_dimensions, std::size_t plane_idx = 0u, typename _
         const auto updated_planes = tensor.planes().template replace<plane_idx>(reshaped_plane);
         return tensor.like(updated_planes);
       }
+      // The view never copies: the reshaped plane maps its indexes to the positions in the original plane
+      else if constexpr (mode == reshape_mode::view) {
+        using plane_type = std::decay_t<decltype(plane)>;
+        static constexpr auto reshaped_strides = compute_unaligned_strides(reshaped_dimensions);
+        Plane<ReshapedBuffer<plane_type>, reshaped_dimensions, reshaped_strides, plane_type::channels()> reshaped_plane{
+            ReshapedBuffer<plane_type>{plane}};
+        const auto updated_planes = tensor.planes().template replace<plane_idx>(reshaped_plane);
+        return tensor.like(updated_planes);
+      }
       // Worst case scenario: we can't avoid allocating a new tensor
       else {
         auto reshaped_plane = create_plane<typename std::decay_t<decltype(plane)>::buffer_type, reshaped_dimensions,
@@ -188,4 +391,56 @@ template <Dimensions reshaped_dimensions, std::size_t plane_idx = 0u, typename _
   }
 }
 
+/*
+ * Changes the shape of a plane to dimensions known at runtime
+ * The reshaped plane is a DynamicPlane with unaligned strides. If the elements of the plane are stored contiguously, in
+ * the order of its dimensions, the reshaped plane shares the plane's buffer. Otherwise, the elements are copied into a
+ * newly created plane
+ * Parameters:
+ * @tparam plane_idx: Index of the plane whose shape we're modifying
+ * @param tensor: Tensor on whom the operation will be performed
+ * @param reshaped_dimensions: New dimensions of the plane, starting from the innermost dimension. The product of these
+ * has to be equal to the product of the old dimensions
+ */
+template <std::size_t plane_idx = 0u, typename _Tensor, std::size_t rank>
+[[nodiscard]] auto reshape(_Tensor&& tensor, const std::array<std::size_t, rank>& reshaped_dimensions) {
+  const auto& plane = tensor.planes().template plane<plane_idx>();
+  using plane_type = std::decay_t<decltype(plane)>;
+  using buffer_type = typename plane_type::buffer_type;
+  using reshaped_plane_type = DynamicPlane<buffer_type, DynamicExtents<rank>, plane_type::channels()>;
+
+  const auto dimensions = plane_dimensions(plane);
+  const auto strides = plane_strides(plane);
+
+#ifdef ENABLE_NT_EXPECTS
+  std::size_t reshaped_elements = 1u;
+  for (const std::size_t d : reshaped_dimensions) {
+    reshaped_elements *= d;
+  }
+  Expects(reshaped_elements == plane_elements(plane));
+#endif
+
+  // Dimensions of length 1 don't affect whether the elements are stored contiguously
+  bool contiguous = true;
+  long long expected_stride = 1;
+  for (std::size_t d = 0u; d < dimensions.size() && contiguous; ++d) {
+    if (dimensions[d] == 1u) continue;
+    contiguous = strides[d] == expected_stride;
+    expected_stride *= static_cast<long long>(dimensions[d]);
+  }
+
+  if (contiguous) {
+    const reshaped_plane_type reshaped_plane{plane.buffer(), reshaped_dimensions,
+                                             compute_unaligned_strides(reshaped_dimensions), plane.offset()};
+    const auto updated_planes = tensor.planes().template replace<plane_idx>(reshaped_plane);
+    return tensor.like(updated_planes);
+  }
+
+  auto reshaped_plane =
+      create_dynamic_plane<buffer_type, DynamicExtents<rank>, plane_type::channels(), false>(reshaped_dimensions);
+  iterative_execute([](auto& lhs, const auto& rhs) { lhs = rhs; }, reshaped_plane, plane);
+  const auto updated_planes = tensor.planes().template replace<plane_idx>(reshaped_plane);
+  return tensor.like(updated_planes);
+}
+
 }  // namespace ntensor
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dynamic_plane.hpp"
 #include "range.hpp"
 #include "utilities.hpp"
 
@@ -64,18 +65,17 @@ struct ShapeTransmutation {
 #ifdef ENABLE_NT_EXPECTS
       Expects(plane.channels() > channel);
 #endif
-      static constexpr auto dimensions = std::decay_t<decltype(plane)>::dimensions();
       static constexpr std::size_t nOffsets = sizeof...(offsets);
+      static constexpr std::size_t rank = std::decay_t<decltype(plane)>::rank();
       // Assert that the function doesn't receive more offsets than there are dimensions in the specified plane
-      static_assert(nOffsets <= dimensions.rank());
-      static constexpr auto strides = std::decay_t<decltype(plane)>::strides();
-      static constexpr std::size_t rank = dimensions.rank();
+      static_assert(nOffsets <= rank);
       const auto offsetsArr = std::array{offsets...};
+      // The dimensions and strides are constants for a Plane, and stored in the plane for a DynamicPlane
 #ifdef ENABLE_NT_EXPECTS
-      Expects((offsetsArr[nOffsets - is - 1u] < dimensions.template at<rank - is - 1u>()) && ...);
+      Expects((offsetsArr[nOffsets - is - 1u] < plane_extent<rank - is - 1u>(plane)) && ...);
 #endif
       const std::size_t offset =
-          ((((offsetsArr[nOffsets - is - 1U] * strides.template at<rank - is - 1U>())) + ...)) * plane.channels() +
+          ((((offsetsArr[nOffsets - is - 1U] * plane_stride<rank - is - 1U>(plane))) + ...)) * plane.channels() +
           channel;
       // Element access is validated in the plane.at() method
       return plane.at(offset);
@@ -95,20 +95,27 @@ struct ShapeTransmutation {
     const auto& planes = static_cast<const _Tensor*>(this)->_planes;
     // planes.plane() validates the plane_idx
     const auto& plane = planes.template plane<plane_idx>();
-    static constexpr auto dimensions = std::decay_t<decltype(plane)>::dimensions();
     // Assert that dimensions have more than 1 element, otherwise we'll end up with a Tensor with 0 dimensions
-    static_assert(dimensions.rank() > 1u);
-    // dimensions.at() validates the dimension_to_skip
+    static_assert(std::decay_t<decltype(plane)>::rank() > 1u);
+
+    if constexpr (is_dynamic_plane_v<decltype(plane)>) {
+      const auto updated_planes =
+          planes.template replace<plane_idx>(slice_dynamic_plane<dimension_to_skip>(plane, dimensional_offset));
+      return static_cast<const _Tensor*>(this)->like(updated_planes);
+    } else {
+      static constexpr auto dimensions = std::decay_t<decltype(plane)>::dimensions();
+      // dimensions.at() validates the dimension_to_skip
 #ifdef ENABLE_NT_EXPECTS
-    Expects(dimensional_offset < dimensions.template at<dimension_to_skip>());
+      Expects(dimensional_offset < dimensions.template at<dimension_to_skip>());
 #endif
-    static constexpr auto strides = std::decay_t<decltype(plane)>::strides();
-    const long long offset = dimensional_offset * strides.template at<dimension_to_skip>() * plane.channels();
-    static constexpr auto sliced_dimensions = remove_nth_element<dimension_to_skip>(dimensions);
-    static constexpr auto sliced_strides = remove_nth_element<dimension_to_skip>(strides);
-    const auto sliced_plane = plane.template like<sliced_dimensions, sliced_strides>(offset);
-    const auto updated_planes = planes.template replace<plane_idx>(sliced_plane);
-    return static_cast<const _Tensor*>(this)->like(updated_planes);
+      static constexpr auto strides = std::decay_t<decltype(plane)>::strides();
+      const long long offset = dimensional_offset * strides.template at<dimension_to_skip>() * plane.channels();
+      static constexpr auto sliced_dimensions = remove_nth_element<dimension_to_skip>(dimensions);
+      static constexpr auto sliced_strides = remove_nth_element<dimension_to_skip>(strides);
+      const auto sliced_plane = plane.template like<sliced_dimensions, sliced_strides>(offset);
+      const auto updated_planes = planes.template replace<plane_idx>(sliced_plane);
+      return static_cast<const _Tensor*>(this)->like(updated_planes);
+    }
   }
 
   /*
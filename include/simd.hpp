@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+
+#ifndef NT_SIMD_WIDTH
+#define NT_SIMD_WIDTH 64
+#endif
+
+namespace ntensor {
+
+/*
+ * Fixed-width pack of values used by the vectorized execution
+ * All operations are written as loops over a compile-time number of elements, which compilers turn into vector
+ * instructions of the target architecture. Scalars are implicitly converted to packs by broadcasting them, so the same
+ * generic invocable can be called both with packs and with scalar elements
+ * Parameters:
+ * @tparam T: type of the values in the pack
+ * @tparam N: number of values in the pack
+ * Constraints:
+ * T has to satisfy the arithmetic concept
+ * N has to be a power of two
+ */
+template <arithmetic T, std::size_t N>
+  requires(std::has_single_bit(N))
+class simd_pack {
+ private:
+  alignas(N * sizeof(T)) std::array<T, N> _values;
+
+ public:
+  using value_type = T;
+
+  /*
+   * Default constructor. The values are left uninitialized
+   */
+  simd_pack() noexcept = default;
+
+  /*
+   * Creates a pack in which each value is equal to the given value
+   * Parameters:
+   * @param value: value that's broadcast to all elements of the pack
+   */
+  simd_pack(const T& value) noexcept { _values.fill(value); }
+
+  /*
+   * Returns the number of values in the pack
+   */
+  [[nodiscard]] static consteval std::size_t size() noexcept { return N; }
+
+  /*
+   * Loads a pack from memory. The memory doesn't have to be aligned
+   * Parameters:
+   * @param ptr: pointer to the first of N consecutive values
+   * @return: loaded pack
+   */
+  [[nodiscard]] static simd_pack load(const T* ptr) noexcept {
+    simd_pack pack;
+    for (std::size_t i = 0u; i < N; ++i) pack._values[i] = ptr[i];
+    return pack;
+  }
+
+  /*
+   * Stores the pack to memory. The memory doesn't have to be aligned
+   * Parameters:
+   * @param ptr: pointer to the first of N consecutive values
+   */
+  void store(T* ptr) const noexcept {
+    for (std::size_t i = 0u; i < N; ++i) ptr[i] = _values[i];
+  }
+
+  /*
+   * Returns a reference to the value at the specified lane
+   */
+  [[nodiscard]] T& operator[](std::size_t lane) noexcept { return _values[lane]; }
+
+  /*
+   * Returns a const reference to the value at the specified lane
+   */
+  [[nodiscard]] const T& operator[](std::size_t lane) const noexcept { return _values[lane]; }
+
+  /*
+   * Compares two packs bitwise
+   * Parameters:
+   * @param lhs: first (left-hand side) pack
+   * @param rhs: second (right-hand side) pack
+   * @return: true if all bits of the two packs are equal, false otherwise
+   */
+  [[nodiscard]] friend bool bitwise_equal(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    return !std::memcmp(lhs._values.data(), rhs._values.data(), N * sizeof(T));
+  }
+
+  /*
+   * Compares two packs for equality
+   * True if the values of all lanes are equal, false otherwise
+   */
+  [[nodiscard]] friend bool operator==(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    bool equal = true;
+    for (std::size_t i = 0u; i < N; ++i) equal &= lhs._values[i] == rhs._values[i];
+    return equal;
+  }
+
+  /*
+   * Unary plus operator
+   */
+  [[nodiscard]] simd_pack operator+() const noexcept { return *this; }
+
+  /*
+   * Unary minus operator
+   */
+  [[nodiscard]] simd_pack operator-() const noexcept {
+    simd_pack result;
+    for (std::size_t i = 0u; i < N; ++i) result._values[i] = -_values[i];
+    return result;
+  }
+
+  /*
+   * Addition assignment operator
+   */
+  simd_pack& operator+=(const simd_pack& other) noexcept {
+    for (std::size_t i = 0u; i < N; ++i) _values[i] += other._values[i];
+    return *this;
+  }
+
+  /*
+   * Subtraction assignment operator
+   */
+  simd_pack& operator-=(const simd_pack& other) noexcept {
+    for (std::size_t i = 0u; i < N; ++i) _values[i] -= other._values[i];
+    return *this;
+  }
+
+  /*
+   * Multiplication assignment operator
+   */
+  simd_pack& operator*=(const simd_pack& other) noexcept {
+    for (std::size_t i = 0u; i < N; ++i) _values[i] *= other._values[i];
+    return *this;
+  }
+
+  /*
+   * Division assignment operator
+   */
+  simd_pack& operator/=(const simd_pack& other) noexcept {
+    for (std::size_t i = 0u; i < N; ++i) _values[i] /= other._values[i];
+    return *this;
+  }
+
+  /*
+   * Addition operator
+   */
+  [[nodiscard]] friend simd_pack operator+(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result = lhs;
+    return result += rhs;
+  }
+
+  /*
+   * Subtraction operator
+   */
+  [[nodiscard]] friend simd_pack operator-(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result = lhs;
+    return result -= rhs;
+  }
+
+  /*
+   * Multiplication operator
+   */
+  [[nodiscard]] friend simd_pack operator*(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result = lhs;
+    return result *= rhs;
+  }
+
+  /*
+   * Division operator
+   */
+  [[nodiscard]] friend simd_pack operator/(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result = lhs;
+    return result /= rhs;
+  }
+
+  /*
+   * Lane-wise minimum of two packs
+   */
+  [[nodiscard]] friend simd_pack min(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result;
+    for (std::size_t i = 0u; i < N; ++i) result._values[i] = std::min(lhs._values[i], rhs._values[i]);
+    return result;
+  }
+
+  /*
+   * Lane-wise maximum of two packs
+   */
+  [[nodiscard]] friend simd_pack max(const simd_pack& lhs, const simd_pack& rhs) noexcept {
+    simd_pack result;
+    for (std::size_t i = 0u; i < N; ++i) result._values[i] = std::max(lhs._values[i], rhs._values[i]);
+    return result;
+  }
+};
+
+/*
+ * Number of values of type T that fit into a single vector register of NT_SIMD_WIDTH bytes
+ * Parameters:
+ * @tparam T: type of the values
+ */
+template <typename T>
+inline constexpr std::size_t simd_width_v = std::max<std::size_t>(NT_SIMD_WIDTH / sizeof(T), 1u);
+
+/*
+ * Invocable marked as accepting simd packs
+ * With the unsequenced policy, the execute methods call only marked invocables with packs. Unmarked invocables are
+ * called with single elements, since the body of a generic invocable can't be checked for packs without compiling it
+ * (comparisons, branches and calls of math functions don't accept packs)
+ * Parameters:
+ * @tparam Invocable: type of the marked invocable
+ */
+template <typename Invocable>
+class vectorized_invocable {
+ private:
+  Invocable _invocable;
+
+ public:
+  /*
+   * Creates the marked invocable
+   * Parameters:
+   * @param invocable: marked invocable
+   */
+  constexpr explicit vectorized_invocable(Invocable invocable) : _invocable{std::move(invocable)} {}
+
+  /*
+   * Calls the marked invocable with the given elements (or packs of elements)
+   */
+  template <typename... Args>
+    requires std::is_invocable_v<Invocable&, Args...>
+  constexpr decltype(auto) operator()(Args&&... args) {
+    return std::invoke(_invocable, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+    requires std::is_invocable_v<const Invocable&, Args...>
+  constexpr decltype(auto) operator()(Args&&... args) const {
+    return std::invoke(_invocable, std::forward<Args>(args)...);
+  }
+};
+
+/*
+ * Marks an invocable as accepting simd packs, so that the execute methods call it with packs under the unsequenced
+ * policy (see vectorized_invocable)
+ * Parameters:
+ * @param invocable: invocable that accepts packs as well as single elements. It's copied (or moved) into the result
+ * @return: marked invocable
+ */
+template <typename Invocable>
+[[nodiscard]] constexpr auto vectorized(Invocable&& invocable) {
+  return vectorized_invocable<std::decay_t<Invocable>>{std::forward<Invocable>(invocable)};
+}
+
+inline namespace internal {
+
+/*
+ * Checks whether an invocable is marked as accepting simd packs
+ */
+template <typename>
+struct is_vectorized_invocable : std::false_type {};
+
+template <typename Invocable>
+struct is_vectorized_invocable<vectorized_invocable<Invocable>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_vectorized_invocable_v = is_vectorized_invocable<std::remove_cvref_t<T>>::value;
+
+}  // namespace internal
+
+}  // namespace ntensor
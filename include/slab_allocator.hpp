@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "arena_allocator.hpp"
+#include "concepts.hpp"
+#include "dense_buffer.hpp"
+
+namespace ntensor {
+
+inline namespace internal {
+
+/*
+ * Free block of a slab, linked into a free list
+ */
+struct slab_block {
+  slab_block* next;
+};
+
+/*
+ * Free list of blocks of a single size
+ */
+struct slab_free_list {
+  std::size_t size{};
+  slab_block* head{nullptr};
+  std::size_t count{};
+
+  /*
+   * Pushes a block onto the list
+   */
+  inline void push(void* memory) noexcept {
+    head = ::new (memory) slab_block{head};
+    ++count;
+  }
+
+  /*
+   * Pops a block from the list. The list can't be empty
+   */
+  [[nodiscard]] inline void* pop() noexcept {
+    slab_block* block = head;
+    head = block->next;
+    --count;
+    return block;
+  }
+
+  /*
+   * Detaches the first n blocks of the list, and returns them as a separate list
+   */
+  [[nodiscard]] slab_free_list split(std::size_t n) noexcept {
+    slab_free_list detached{size, head, n};
+    slab_block* last = head;
+    for (std::size_t i = 1u; i < n; ++i) {
+      last = last->next;
+    }
+    head = last->next;
+    last->next = nullptr;
+    count -= n;
+    return detached;
+  }
+
+  /*
+   * Moves all blocks of another list to the front of this list
+   */
+  void splice(slab_free_list& other) noexcept {
+    if (!other.head) return;
+    slab_block* last = other.head;
+    while (last->next) {
+      last = last->next;
+    }
+    last->next = head;
+    head = other.head;
+    count += other.count;
+    other.head = nullptr;
+    other.count = 0u;
+  }
+};
+
+/*
+ * Size of the slabs. Blocks larger than the slab size are allocated one block per slab
+ */
+inline constexpr std::size_t slab_size = 1u << 16u;
+
+/*
+ * Number of blocks moved between the depot and the thread caches at once
+ */
+[[nodiscard]] constexpr std::size_t slab_batch_size(std::size_t block_size) noexcept {
+  return std::max<std::size_t>(slab_size / block_size, 1u);
+}
+
+/*
+ * Process-wide owner of all slabs
+ * Blocks are carved out of the slabs and handed to the thread caches in batches. Thread caches return the blocks they
+ * can't keep (and all of their blocks when the thread exits), so blocks deallocated by a thread other than the one that
+ * allocated them are never lost
+ * The slabs are never released, since buffers with static storage duration might be deallocated after the destruction
+ * of any static object. The memory held by the depot is therefore the high-water mark of the pooled buffers
+ */
+class SlabDepot {
+ private:
+  std::mutex _mutex;
+  std::vector<slab_free_list> _free_lists;
+  std::size_t _capacity{};
+
+  SlabDepot() = default;
+
+  /*
+   * Returns the free list of blocks of the given size, creating it if necessary
+   */
+  [[nodiscard]] slab_free_list& free_list(std::size_t block_size) {
+    auto it = std::find_if(_free_lists.begin(), _free_lists.end(),
+                           [block_size](const slab_free_list& list) { return list.size == block_size; });
+    if (it != _free_lists.end()) return *it;
+    return _free_lists.emplace_back(slab_free_list{block_size});
+  }
+
+ public:
+  SlabDepot(const SlabDepot&) = delete;
+  SlabDepot& operator=(const SlabDepot&) = delete;
+
+  /*
+   * Returns the depot. The depot is never destroyed
+   */
+  [[nodiscard]] static SlabDepot& instance() {
+    static SlabDepot* depot = new SlabDepot{};
+    return *depot;
+  }
+
+  /*
+   * Returns a batch of free blocks of the given size, allocating a new slab if there are no free blocks
+   */
+  [[nodiscard]] slab_free_list acquire(std::size_t block_size) {
+    const std::size_t batch = slab_batch_size(block_size);
+    std::lock_guard lock{_mutex};
+
+    slab_free_list& list = free_list(block_size);
+    if (list.count) {
+      return list.split(std::min(batch, list.count));
+    }
+
+    auto* slab = AlignedMallocAllocator<std::byte>{}.allocate(batch * block_size);
+    _capacity += batch * block_size;
+
+    slab_free_list acquired{block_size};
+    for (std::size_t i = batch; i-- > 0u;) {
+      acquired.push(slab + i * block_size);
+    }
+    return acquired;
+  }
+
+  /*
+   * Takes back a list of free blocks
+   */
+  void release(slab_free_list& blocks) {
+    if (!blocks.head) return;
+    std::lock_guard lock{_mutex};
+    free_list(blocks.size).splice(blocks);
+  }
+
+  /*
+   * Returns the total size of the allocated slabs in bytes
+   */
+  [[nodiscard]] std::size_t capacity() {
+    std::lock_guard lock{_mutex};
+    return _capacity;
+  }
+};
+
+/*
+ * Thread-local cache of free blocks, one free list per block size
+ * The cache is trivially destructible, so that it remains usable while the thread-local and static objects destroyed
+ * after it release their buffers. Its blocks are handed back to the depot by the slab_cache_guard
+ */
+struct slab_cache {
+  static constexpr std::size_t max_size_classes = 32u;
+
+  std::array<slab_free_list, max_size_classes> free_lists{};
+  std::size_t num_size_classes{};
+  bool released{false};
+
+  /*
+   * Returns the free list of blocks of the given size, or nullptr if there's no such list
+   */
+  [[nodiscard]] slab_free_list* find(std::size_t block_size) noexcept {
+    for (std::size_t i = 0u; i < num_size_classes; ++i) {
+      if (free_lists[i].size == block_size) return &free_lists[i];
+    }
+    return nullptr;
+  }
+
+  /*
+   * Adds a free list of blocks of the given size, or returns nullptr if all of the lists are already in use
+   */
+  [[nodiscard]] slab_free_list* insert(std::size_t block_size) noexcept {
+    if (released || num_size_classes == max_size_classes) return nullptr;
+    free_lists[num_size_classes].size = block_size;
+    return &free_lists[num_size_classes++];
+  }
+
+  /*
+   * Hands all blocks back to the depot
+   */
+  void release() {
+    for (std::size_t i = 0u; i < num_size_classes; ++i) {
+      SlabDepot::instance().release(free_lists[i]);
+    }
+    num_size_classes = 0u;
+    released = true;
+  }
+};
+
+inline thread_local slab_cache thread_slab_cache;
+
+/*
+ * Hands the blocks of the thread cache back to the depot when the thread exits
+ */
+struct slab_cache_guard {
+  ~slab_cache_guard() { thread_slab_cache.release(); }
+};
+
+inline thread_local slab_cache_guard thread_slab_cache_guard;
+
+/*
+ * Returns the free list of the calling thread holding blocks of the given size, or nullptr if the thread can't cache
+ * any more block sizes
+ */
+[[nodiscard]] inline slab_free_list* thread_free_list(std::size_t block_size) noexcept {
+  if (slab_free_list* list = thread_slab_cache.find(block_size)) [[likely]] {
+    return list;
+  }
+
+  // Make sure that the blocks are handed back to the depot when the thread exits
+  static_cast<void>(&thread_slab_cache_guard);
+  return thread_slab_cache.insert(block_size);
+}
+
+}  // namespace internal
+
+/*
+ * Hybrid slab allocator
+ * Planes of a given type always allocate the same number of elements, so a program repeatedly creating the same plane
+ * types repeatedly allocates the same few block sizes. The slab allocator keeps a thread-local free list for each block
+ * size: deallocated blocks are pushed onto the free list of the deallocating thread, and handed out by the next
+ * allocation of the same size, so a loop creating the same planes every iteration doesn't allocate any memory after the
+ * first iteration. Blocks are carved out of larger slabs, and exchanged in batches with a process-wide depot when a
+ * thread runs out of them or caches too many of them. The memory is never returned to the system
+ * The allocator is stateless, so buffers don't get larger by using it (see PooledBuffer)
+ * Parameters:
+ * @tparam T: memory type that needs to be allocated
+ */
+template <typename T>
+class SlabAllocator {
+ public:
+  using value_type = T;
+
+  /*
+   * Default constructor
+   */
+  SlabAllocator() noexcept = default;
+
+  /*
+   * Construct the allocator using a allocator with a different type
+   * Since the allocator is stateless, the constructor has no visible effect
+   */
+  template <typename U>
+  SlabAllocator(const SlabAllocator<U>&) noexcept {}
+
+  /*
+   * Allocates n * sizeof(T) bytes of uninitialized storage, aligned to NT_ALIGNMENT
+   * Parameters:
+   * @param n: the number of objects to allocate storage for
+   */
+  [[nodiscard]] value_type* allocate(std::size_t n) {
+    const std::size_t block_size = align_allocation_size(n * sizeof(value_type));
+    slab_free_list* list = thread_free_list(block_size);
+
+    if (!list) [[unlikely]] {
+      slab_free_list blocks = SlabDepot::instance().acquire(block_size);
+      void* memory = blocks.pop();
+      SlabDepot::instance().release(blocks);
+      return static_cast<value_type*>(memory);
+    }
+
+    if (!list->head) [[unlikely]] {
+      *list = SlabDepot::instance().acquire(block_size);
+    }
+    return static_cast<value_type*>(list->pop());
+  }
+
+  /*
+   * Returns the storage referenced by the pointer p to the pool
+   * Parameters:
+   * @param p: pointer pointing to the allocated memory
+   * @param n: the number of objects that the storage was allocated for
+   */
+  void deallocate(value_type* p, std::size_t n) noexcept {
+    if (!p) return;
+    const std::size_t block_size = align_allocation_size(n * sizeof(value_type));
+    slab_free_list* list = thread_free_list(block_size);
+
+    if (!list) [[unlikely]] {
+      slab_free_list blocks{block_size};
+      blocks.push(p);
+      SlabDepot::instance().release(blocks);
+      return;
+    }
+
+    list->push(p);
+
+    // Keep at most two batches per thread, so threads that only deallocate don't hoard the blocks
+    const std::size_t batch = slab_batch_size(block_size);
+    if (list->count >= 2u * batch) [[unlikely]] {
+      slab_free_list surplus = list->split(batch);
+      SlabDepot::instance().release(surplus);
+    }
+  }
+};
+
+/*
+ * Compares two allocators. Since the allocators are stateless, two allocators are always equal
+ */
+template <class T, class U>
+constexpr bool operator==(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept {
+  return true;
+}
+
+/*
+ * Compares two allocators. Since the allocators are stateless, two allocators are always equal
+ */
+template <class T, class U>
+constexpr bool operator!=(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept {
+  return false;
+}
+
+/*
+ * Returns the total size of the slabs allocated by all slab allocators in bytes
+ */
+[[nodiscard]] inline std::size_t slab_pool_capacity() { return SlabDepot::instance().capacity(); }
+
+/*
+ * Dense buffer whose memory is recycled by the slab allocator
+ */
+template <arithmetic T>
+using PooledBuffer = DenseBuffer<T, SlabAllocator<T>>;
+
+}  // namespace ntensor
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <span>
+#include <type_traits>
 #include <limits>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "aligned_allocator.hpp"
 #include "concepts.hpp"
+#include "sparse_containers.hpp"
 
 namespace ntensor {
 
 /*
+ * Sparse buffer storing only the elements that were assigned a non-zero value
+ * Parameters:
+ * @tparam T: underlying memory type of the buffer
+ * @tparam Container: container storing the non-zero elements. Either an associative container mapping indices to
+ * elements (like the default std::unordered_map), or one of the containers found in sparse_containers.hpp
+ * (CooContainer, CsrContainer, BlockSparseContainer)
  * Constraints:
  * T has to satisfy the arithmetic concept
  * WARNING:
@@ -34,11 +46,26 @@ class SparseBuffer {
    private:
     inline static ValueType zero{};
     ValueType* _ptr{&zero};
-    std::function<void(ValueType*&, const ValueType&)> _callback;
+    SparseBuffer* _buffer{nullptr};
+    std::size_t _index{};
+
+    /*
+     * Stores a value for an element that isn't stored yet. Zeros aren't stored
+     */
+    inline void store(const ValueType& value) {
+      if (value == ValueType{}) [[unlikely]] {
+        return;
+      }
+#ifdef ENABLE_NT_EXPECTS
+      Expects(_buffer);
+#endif
+      _ptr = &sparse_insert(*_buffer->_memory, _index, value);
+    }
 
    public:
     /*
      * Default constructor
+     * The SparseValue points to a zero element that isn't a part of any buffer, so it can only be read
      */
     SparseValue() noexcept = default;
 
@@ -47,15 +74,16 @@ class SparseBuffer {
      * Parameters:
      * @param value: element residing inside the SparseBuffer
      */
-    explicit SparseValue(ValueType& value) : _ptr{&value} {}
+    explicit SparseValue(ValueType& value) noexcept : _ptr{&value} {}
 
     /*
-     * Constructs a new SparseValue that points to an empty element
+     * Constructs a new SparseValue that points to an element that isn't stored inside the SparseBuffer
+     * The element is stored into the buffer by the first write that assigns it a non-zero value
      * Parameters:
-     * @param callback: invocable used for setting a value for the requested element and storing it into the
-     * SparseBuffer
+     * @param buffer: buffer into which the element is stored
+     * @param index: location of the element inside the buffer
      */
-    explicit SparseValue(std::invocable<ValueType*&, ValueType> auto callback) : _callback{callback} {}
+    SparseValue(SparseBuffer& buffer, std::size_t index) noexcept : _buffer{&buffer}, _index{index} {}
 
     /*
      * Implicit conversion operator converting SparseValue to const T&
@@ -66,10 +94,20 @@ class SparseBuffer {
      * Simple assignment operator
      */
     inline void operator=(const ValueType& value) {
-      if (*_ptr) [[unlikely]]
+      if (_ptr != &zero) [[unlikely]]
         *_ptr = value;
       else [[likely]]
-        _callback(_ptr, value);
+        store(value);
+    }
+
+    /*
+     * Assigns the value of another element
+     * Like other references, a SparseValue keeps pointing to the same element, so copying the SparseValue itself would
+     * lose the write (for example in lhs = rhs, where both elements come from sparse planes)
+     */
+    inline SparseValue& operator=(const SparseValue& other) {
+      *this = static_cast<const ValueType&>(other);
+      return *this;
     }
 
     /*
@@ -91,10 +129,10 @@ class SparseBuffer {
      * Addition assignment operator
      */
     void operator+=(const ValueType& value) {
-      if (*_ptr) [[unlikely]]
+      if (_ptr != &zero) [[unlikely]]
         *_ptr += value;
       else [[likely]]
-        _callback(_ptr, value);
+        store(value);
     }
 
     /*
@@ -106,10 +144,10 @@ class SparseBuffer {
      * Subtraction assignment operator
      */
     void operator-=(const ValueType& value) {
-      if (*_ptr) [[unlikely]]
+      if (_ptr != &zero) [[unlikely]]
         *_ptr -= value;
       else [[likely]]
-        _callback(_ptr, ValueType{} - value);
+        store(ValueType{} - value);
     }
 
     /*
@@ -121,7 +159,7 @@ class SparseBuffer {
      * Multiplication assignment operator
      */
     void operator*=(const ValueType& value) {
-      if (*_ptr) [[unlikely]]
+      if (_ptr != &zero) [[unlikely]]
         *_ptr *= value;
     }
 
@@ -134,10 +172,11 @@ class SparseBuffer {
      * Division assignment operator
      */
     void operator/=(const ValueType& value) {
-      if (*_ptr) [[unlikely]]
+      if (_ptr != &zero) [[unlikely]]
         *_ptr /= value;
-      else [[likely]]
-        _callback(_ptr, std::numeric_limits<ValueType>::infinity());
+      else if constexpr (std::is_floating_point_v<ValueType>)
+        // Only a division by zero (or by NaN) can give a non-zero result
+        store(ValueType{} / value);
     }
 
     /*
@@ -179,8 +218,7 @@ class SparseBuffer {
 #ifdef ENABLE_NT_EXPECTS
     Expects(size > 0u && size < std::numeric_limits<std::size_t>::max() / sizeof(T));
 #endif
-    _memory = std::allocate_shared<Container>(nt_allocator<Container>());
-    _memory->reserve(_size);
+    _memory = std::allocate_shared<Container>(nt_allocator<Container>(), make_sparse_container<Container>(_size));
   }
 
   /*
@@ -236,19 +274,10 @@ class SparseBuffer {
    * @return: reference to the element at the specified location
    */
   [[nodiscard]] reference operator[](std::size_t index) {
-    if (_memory->contains(index)) [[unlikely]] {
-      return SparseValue((*_memory)[index]);
+    if (T* value = sparse_find(*_memory, index)) [[unlikely]] {
+      return SparseValue(*value);
     } else [[likely]] {
-      auto callback = [this, index](T*& ptr, const T& value) {
-        if (value == T{}) [[unlikely]] {
-          return;
-        }
-
-        (*_memory)[index] = value;
-        ptr = &(*_memory)[index];
-      };
-
-      return SparseValue<T>(callback);
+      return SparseValue<T>(*this, index);
     }
   }
 
@@ -259,10 +288,8 @@ class SparseBuffer {
    * @return: const reference to the element at the specified location
    */
   [[nodiscard]] const_reference operator[](std::size_t index) const {
-    // hash map doesn't have a const operator[] version, so find is used here as a workaround
-    if (auto it = _memory->find(index); it != _memory->end()) [[unlikely]] {
-      const auto& value = it->second;
-      return SparseValue(value);
+    if (const T* value = sparse_find(std::as_const(*_memory), index)) [[unlikely]] {
+      return SparseValue(*value);
     } else [[likely]] {
       return SparseValue<const T>{};
     }
@@ -294,12 +321,105 @@ class SparseBuffer {
     return this->operator[](index);
   }
 
+  /*
+   * Returns a pointer to the stored element at the specified location
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: pointer to the element, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] inline T* find(std::size_t index) { return _memory ? sparse_find(*_memory, index) : nullptr; }
+
+  /*
+   * Returns a const pointer to the stored element at the specified location
+   * Parameters:
+   * @param index: location of the element to retrieve
+   * @return: const pointer to the element, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] inline const T* find(std::size_t index) const {
+    return _memory ? sparse_find(std::as_const(*_memory), index) : nullptr;
+  }
+
+  /*
+   * Stores elements given as a list of coordinates, sorted by their locations in increasing order
+   * Elements that are already stored are overwritten, and zeros that aren't stored are skipped. This is considerably
+   * faster than assigning the elements one by one, especially with the sorted containers, where appending a list behind
+   * the stored elements is linear, and inserting it in between them is a single merge
+   * Parameters:
+   * @param indices: locations of the elements, in strictly increasing order
+   * @param values: values of the elements
+   * Constraints:
+   * Both lists have to have the same size, and the locations have to be smaller than the buffer's size
+   */
+  void insert_range(std::span<const std::size_t> indices, std::span<const T> values) {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(_memory && indices.size() == values.size());
+    Expects(std::is_sorted(indices.begin(), indices.end()) &&
+            std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+    Expects(indices.empty() || indices.back() < _size);
+#endif
+    sparse_insert_sorted(*_memory, indices, values);
+  }
+
+  /*
+   * Replaces all elements with elements given as a list of coordinates, sorted by their locations in increasing order
+   * See insert_range for details
+   * Parameters:
+   * @param indices: locations of the elements, in strictly increasing order
+   * @param values: values of the elements
+   */
+  void assign_sorted(std::span<const std::size_t> indices, std::span<const T> values) {
+#ifdef ENABLE_NT_EXPECTS
+    Expects(_memory);
+#endif
+    _memory->clear();
+    insert_range(indices, values);
+  }
+
+  /*
+   * Calls an invocable with the location and a reference to each stored element
+   * The elements are visited in the order of their locations, unless the container is an associative container
+   * Parameters:
+   * @param invocable: invocable called with the location (std::size_t) and the reference of each stored element
+   */
+  template <typename Invocable>
+  void for_each_stored(Invocable&& invocable) {
+    if (_memory) sparse_for_each(*_memory, std::forward<Invocable>(invocable));
+  }
+
+  /*
+   * Calls an invocable with the location and a const reference to each stored element
+   * The elements are visited in the order of their locations, unless the container is an associative container
+   * Parameters:
+   * @param invocable: invocable called with the location (std::size_t) and the const reference of each stored element
+   */
+  template <typename Invocable>
+  void for_each_stored(Invocable&& invocable) const {
+    if (_memory) sparse_for_each(std::as_const(*_memory), std::forward<Invocable>(invocable));
+  }
+
   /*
    * Returns the maximum number of elements that can reside inside the buffer
    * Parameters:
    * @return: maximum number of elements that can reside inside the buffer
    */
   [[nodiscard]] inline std::size_t size() const noexcept { return _size; }
+
+  /*
+   * Returns the number of elements stored inside the buffer
+   * Parameters:
+   * @return: number of stored elements
+   */
+  [[nodiscard]] inline std::size_t nonzeros() const noexcept { return _memory ? sparse_nonzeros(*_memory) : 0u; }
+
+  /*
+   * Returns the average number of bytes used for storing a single element
+   * Parameters:
+   * @return: memory used by the container divided by the number of stored elements
+   */
+  [[nodiscard]] double bytes_per_nonzero() const noexcept {
+    const std::size_t n = nonzeros();
+    return n ? static_cast<double>(sparse_memory_usage(*_memory)) / static_cast<double>(n) : 0.0;
+  }
 };
 
 }  // namespace ntensor
@@ -0,0 +1,618 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "concepts.hpp"
+
+namespace ntensor {
+
+/*
+ * Sorted coordinate (COO) container
+ * The indices of the non-zero elements are kept sorted in one array, and the values in another, so a lookup is a binary
+ * search, and the elements are iterated in the order of their indices. Appending elements in increasing index order is
+ * amortized O(1), while inserting an element in between existing ones has to move the elements behind it
+ * Each non-zero element costs sizeof(std::size_t) + sizeof(T) bytes
+ * WARNING:
+ * Inserting an element invalidates the references to the existing elements
+ * Parameters:
+ * @tparam T: type of the stored elements
+ */
+template <arithmetic T>
+class CooContainer {
+ private:
+  std::vector<std::size_t, nt_allocator<std::size_t>> _indices;
+  std::vector<T, nt_allocator<T>> _values;
+
+  [[nodiscard]] inline std::size_t lower_bound(std::size_t index) const noexcept {
+    // Elements are usually appended in increasing index order, so check the last element first
+    if (_indices.empty() || _indices.back() < index) [[likely]] {
+      return _indices.size();
+    }
+    return static_cast<std::size_t>(std::lower_bound(_indices.begin(), _indices.end(), index) - _indices.begin());
+  }
+
+ public:
+  using value_type = T;
+
+  /*
+   * Creates an empty container
+   * Parameters:
+   * @param size: number of logical elements (unused, since the container is independent of the logical size)
+   */
+  explicit CooContainer(std::size_t = 0u) noexcept {}
+
+  /*
+   * Returns a pointer to the element with the given index, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] T* find(std::size_t index) noexcept {
+    return const_cast<T*>(static_cast<const CooContainer*>(this)->find(index));
+  }
+
+  /*
+   * Returns a const pointer to the element with the given index, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] const T* find(std::size_t index) const noexcept {
+    const std::size_t position = lower_bound(index);
+    return position < _indices.size() && _indices[position] == index ? &_values[position] : nullptr;
+  }
+
+  /*
+   * Stores an element, and returns a reference to it. The element can't already be stored
+   */
+  T& insert(std::size_t index, const T& value) {
+    const std::size_t position = lower_bound(index);
+    _indices.insert(_indices.begin() + static_cast<std::ptrdiff_t>(position), index);
+    return *_values.insert(_values.begin() + static_cast<std::ptrdiff_t>(position), value);
+  }
+
+  /*
+   * Stores elements given as a list of coordinates sorted in increasing order. Elements that are already stored are
+   * overwritten, and zeros that aren't stored are skipped
+   * Appending elements behind the stored ones is O(n), and inserting them in between the stored ones merges the two
+   * lists in O(n + m)
+   */
+  void insert_sorted(std::span<const std::size_t> indices, std::span<const T> values) {
+    if (_indices.empty() || (!indices.empty() && indices.front() > _indices.back())) [[likely]] {
+      reserve(_indices.size() + indices.size());
+      for (std::size_t i = 0u; i < indices.size(); ++i) {
+        if (values[i] != T{}) {
+          _indices.push_back(indices[i]);
+          _values.push_back(values[i]);
+        }
+      }
+      return;
+    }
+
+    decltype(_indices) merged_indices;
+    decltype(_values) merged_values;
+    merged_indices.reserve(_indices.size() + indices.size());
+    merged_values.reserve(_indices.size() + indices.size());
+
+    std::size_t i = 0u, j = 0u;
+    while (i < _indices.size() || j < indices.size()) {
+      if (j == indices.size() || (i < _indices.size() && _indices[i] < indices[j])) {
+        merged_indices.push_back(_indices[i]);
+        merged_values.push_back(_values[i++]);
+      } else {
+        const bool stored = i < _indices.size() && _indices[i] == indices[j];
+        if (stored || values[j] != T{}) {
+          merged_indices.push_back(indices[j]);
+          merged_values.push_back(values[j]);
+        }
+        i += stored;
+        ++j;
+      }
+    }
+
+    _indices = std::move(merged_indices);
+    _values = std::move(merged_values);
+  }
+
+  /*
+   * Removes all elements
+   */
+  void clear() noexcept {
+    _indices.clear();
+    _values.clear();
+  }
+
+  /*
+   * Calls the invocable with the index and a reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) {
+    for (std::size_t i = 0u; i < _indices.size(); ++i) {
+      invocable(_indices[i], _values[i]);
+    }
+  }
+
+  /*
+   * Calls the invocable with the index and a const reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) const {
+    for (std::size_t i = 0u; i < _indices.size(); ++i) {
+      invocable(_indices[i], _values[i]);
+    }
+  }
+
+  /*
+   * Reserves memory for the given number of non-zero elements
+   */
+  void reserve(std::size_t nonzeros) {
+    _indices.reserve(nonzeros);
+    _values.reserve(nonzeros);
+  }
+
+  /*
+   * Returns the number of stored elements
+   */
+  [[nodiscard]] inline std::size_t nonzeros() const noexcept { return _values.size(); }
+
+  /*
+   * Returns the number of bytes used by the container
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return sizeof(*this) + _indices.capacity() * sizeof(std::size_t) + _values.capacity() * sizeof(T);
+  }
+};
+
+/*
+ * Compressed sparse row (CSR) container
+ * The logical elements are split into rows of row_stride elements. Passing the outermost stride of a 2D plane (or the
+ * stride of the second dimension of a higher-dimensional plane) as the row stride matches the rows of the plane.
+ * Each row stores the columns of its non-zero elements sorted, and the rows are concatenated, so a lookup is a binary
+ * search limited to a single row. Columns are stored as 32-bit integers
+ * Appending elements in increasing index order is amortized O(1): the offsets of the rows behind the last touched row
+ * aren't stored, but are implicitly equal to the number of stored elements
+ * Each non-zero element costs sizeof(std::uint32_t) + sizeof(T) bytes, and each row up to the last non-empty row costs
+ * sizeof(std::size_t) bytes
+ * WARNING:
+ * Inserting an element invalidates the references to the existing elements
+ * Parameters:
+ * @tparam T: type of the stored elements
+ * @tparam row_stride: number of logical elements per row
+ */
+template <arithmetic T, std::size_t row_stride>
+  requires(row_stride > 0u && row_stride <= UINT32_MAX)
+class CsrContainer {
+ private:
+  // _row_offsets[r] is the position of the first element of row r, for all r <= _last_row
+  std::vector<std::size_t, nt_allocator<std::size_t>> _row_offsets{0u};
+  std::size_t _last_row{};
+  std::vector<std::uint32_t, nt_allocator<std::uint32_t>> _columns;
+  std::vector<T, nt_allocator<T>> _values;
+
+  [[nodiscard]] inline std::size_t row_begin(std::size_t row) const noexcept {
+    return row <= _last_row ? _row_offsets[row] : _values.size();
+  }
+
+  [[nodiscard]] inline std::size_t row_end(std::size_t row) const noexcept {
+    return row < _last_row ? _row_offsets[row + 1u] : _values.size();
+  }
+
+  [[nodiscard]] inline std::size_t lower_bound(std::size_t row, std::uint32_t column) const noexcept {
+    const auto first = _columns.begin() + static_cast<std::ptrdiff_t>(row_begin(row));
+    const auto last = _columns.begin() + static_cast<std::ptrdiff_t>(row_end(row));
+    return static_cast<std::size_t>(std::lower_bound(first, last, column) - _columns.begin());
+  }
+
+ public:
+  using value_type = T;
+
+  /*
+   * Creates an empty container
+   * Parameters:
+   * @param size: number of logical elements, used for reserving the row offsets
+   */
+  explicit CsrContainer(std::size_t size = 0u) { _row_offsets.reserve((size + row_stride - 1u) / row_stride + 1u); }
+
+  /*
+   * Returns a pointer to the element with the given index, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] T* find(std::size_t index) noexcept {
+    return const_cast<T*>(static_cast<const CsrContainer*>(this)->find(index));
+  }
+
+  /*
+   * Returns a const pointer to the element with the given index, or nullptr if the element isn't stored
+   */
+  [[nodiscard]] const T* find(std::size_t index) const noexcept {
+    const std::size_t row = index / row_stride;
+    const auto column = static_cast<std::uint32_t>(index % row_stride);
+    const std::size_t position = lower_bound(row, column);
+    return position < row_end(row) && _columns[position] == column ? &_values[position] : nullptr;
+  }
+
+  /*
+   * Stores an element, and returns a reference to it. The element can't already be stored
+   */
+  T& insert(std::size_t index, const T& value) {
+    const std::size_t row = index / row_stride;
+    const auto column = static_cast<std::uint32_t>(index % row_stride);
+
+    if (row > _last_row) {
+      // The rows in between are empty, so they start where the elements currently end
+      _row_offsets.resize(row + 1u, _values.size());
+      _last_row = row;
+    }
+
+    const std::size_t position = lower_bound(row, column);
+    for (std::size_t r = row + 1u; r <= _last_row; ++r) {
+      ++_row_offsets[r];
+    }
+    _columns.insert(_columns.begin() + static_cast<std::ptrdiff_t>(position), column);
+    return *_values.insert(_values.begin() + static_cast<std::ptrdiff_t>(position), value);
+  }
+
+  /*
+   * Stores elements given as a list of coordinates sorted in increasing order. Elements that are already stored are
+   * overwritten, and zeros that aren't stored are skipped
+   * Appending elements behind the stored ones is O(n), and inserting them in between the stored ones rebuilds the
+   * container in O(n + m)
+   */
+  void insert_sorted(std::span<const std::size_t> indices, std::span<const T> values) {
+    if (!_values.empty() && !indices.empty() && indices.front() <= _last_row * row_stride + _columns.back()) {
+      std::vector<std::size_t> stored_indices;
+      std::vector<T> stored_values;
+      stored_indices.reserve(_values.size());
+      stored_values.reserve(_values.size());
+      std::as_const(*this).for_each([&stored_indices, &stored_values](std::size_t index, const T& value) {
+        stored_indices.push_back(index);
+        stored_values.push_back(value);
+      });
+      clear();
+      reserve(stored_values.size() + indices.size());
+
+      std::size_t i = 0u, j = 0u;
+      while (i < stored_indices.size() || j < indices.size()) {
+        if (j == indices.size() || (i < stored_indices.size() && stored_indices[i] < indices[j])) {
+          insert(stored_indices[i], stored_values[i]);
+          ++i;
+        } else {
+          const bool stored = i < stored_indices.size() && stored_indices[i] == indices[j];
+          if (stored || values[j] != T{}) insert(indices[j], values[j]);
+          i += stored;
+          ++j;
+        }
+      }
+      return;
+    }
+
+    reserve(_values.size() + indices.size());
+    for (std::size_t i = 0u; i < indices.size(); ++i) {
+      if (values[i] != T{}) insert(indices[i], values[i]);
+    }
+  }
+
+  /*
+   * Removes all elements
+   */
+  void clear() noexcept {
+    _row_offsets.resize(1u);
+    _row_offsets[0] = 0u;
+    _last_row = 0u;
+    _columns.clear();
+    _values.clear();
+  }
+
+  /*
+   * Calls the invocable with the index and a reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) {
+    for (std::size_t row = 0u; row <= _last_row; ++row) {
+      for (std::size_t i = row_begin(row), last = row_end(row); i < last; ++i) {
+        invocable(row * row_stride + _columns[i], _values[i]);
+      }
+    }
+  }
+
+  /*
+   * Calls the invocable with the index and a const reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) const {
+    for (std::size_t row = 0u; row <= _last_row; ++row) {
+      for (std::size_t i = row_begin(row), last = row_end(row); i < last; ++i) {
+        invocable(row * row_stride + _columns[i], _values[i]);
+      }
+    }
+  }
+
+  /*
+   * Reserves memory for the given number of non-zero elements
+   */
+  void reserve(std::size_t nonzeros) {
+    _columns.reserve(nonzeros);
+    _values.reserve(nonzeros);
+  }
+
+  /*
+   * Returns the number of stored elements
+   */
+  [[nodiscard]] inline std::size_t nonzeros() const noexcept { return _values.size(); }
+
+  /*
+   * Returns the number of bytes used by the container
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return sizeof(*this) + _row_offsets.capacity() * sizeof(std::size_t) +
+           _columns.capacity() * sizeof(std::uint32_t) + _values.capacity() * sizeof(T);
+  }
+};
+
+/*
+ * Block-sparse container
+ * The logical elements are split into blocks of block_size consecutive elements. A block is stored densely as soon as
+ * any of its elements is stored, so all elements of a stored block are considered stored (including the zeros). The
+ * blocks are aligned to NT_ALIGNMENT, which allows processing them with vector instructions, and a lookup is a binary
+ * search over the stored blocks followed by direct indexing
+ * This suits data whose non-zero elements are clustered, for example masks or regions of interest
+ * WARNING:
+ * Storing a new block invalidates the references to the existing elements
+ * Parameters:
+ * @tparam T: type of the stored elements
+ * @tparam block_size: number of elements per block
+ */
+template <arithmetic T, std::size_t block_size = NT_ALIGNMENT / sizeof(T)>
+  requires(block_size > 0u && block_size * sizeof(T) % NT_ALIGNMENT == 0u)
+class BlockSparseContainer {
+ private:
+  // Indexes of the stored blocks in increasing order, and the slot of each block inside _values
+  std::vector<std::size_t, nt_allocator<std::size_t>> _blocks;
+  std::vector<std::size_t, nt_allocator<std::size_t>> _slots;
+  std::vector<T, nt_allocator<T>> _values;
+
+  [[nodiscard]] inline std::size_t lower_bound(std::size_t block) const noexcept {
+    if (_blocks.empty() || _blocks.back() < block) [[likely]] {
+      return _blocks.size();
+    }
+    return static_cast<std::size_t>(std::lower_bound(_blocks.begin(), _blocks.end(), block) - _blocks.begin());
+  }
+
+ public:
+  using value_type = T;
+
+  /*
+   * Creates an empty container
+   * Parameters:
+   * @param size: number of logical elements (unused, since the container is independent of the logical size)
+   */
+  explicit BlockSparseContainer(std::size_t = 0u) noexcept {}
+
+  /*
+   * Returns a pointer to the element with the given index, or nullptr if its block isn't stored
+   */
+  [[nodiscard]] T* find(std::size_t index) noexcept {
+    return const_cast<T*>(static_cast<const BlockSparseContainer*>(this)->find(index));
+  }
+
+  /*
+   * Returns a const pointer to the element with the given index, or nullptr if its block isn't stored
+   */
+  [[nodiscard]] const T* find(std::size_t index) const noexcept {
+    const std::size_t block = index / block_size;
+    const std::size_t position = lower_bound(block);
+    if (position == _blocks.size() || _blocks[position] != block) return nullptr;
+    return &_values[_slots[position] * block_size + index % block_size];
+  }
+
+  /*
+   * Stores an element, and returns a reference to it. The block of the element can't already be stored
+   */
+  T& insert(std::size_t index, const T& value) {
+    const std::size_t block = index / block_size;
+    const std::size_t position = lower_bound(block);
+    const std::size_t slot = _values.size() / block_size;
+
+    _blocks.insert(_blocks.begin() + static_cast<std::ptrdiff_t>(position), block);
+    _slots.insert(_slots.begin() + static_cast<std::ptrdiff_t>(position), slot);
+    _values.resize(_values.size() + block_size, T{});
+
+    T& element = _values[slot * block_size + index % block_size];
+    element = value;
+    return element;
+  }
+
+  /*
+   * Stores elements given as a list of coordinates sorted in increasing order. Elements that are already stored are
+   * overwritten, and zeros that aren't stored are skipped
+   */
+  void insert_sorted(std::span<const std::size_t> indices, std::span<const T> values) {
+    for (std::size_t i = 0u; i < indices.size(); ++i) {
+      if (T* element = find(indices[i])) {
+        *element = values[i];
+      } else if (values[i] != T{}) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+
+  /*
+   * Removes all elements
+   */
+  void clear() noexcept {
+    _blocks.clear();
+    _slots.clear();
+    _values.clear();
+  }
+
+  /*
+   * Returns a pointer to the dense block holding the element with the given index, or nullptr if the block isn't stored
+   */
+  [[nodiscard]] const T* block(std::size_t index) const noexcept {
+    const T* element = find(index);
+    return element ? element - index % block_size : nullptr;
+  }
+
+  /*
+   * Calls the invocable with the index and a reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) {
+    for (std::size_t i = 0u; i < _blocks.size(); ++i) {
+      T* values = &_values[_slots[i] * block_size];
+      for (std::size_t j = 0u; j < block_size; ++j) {
+        invocable(_blocks[i] * block_size + j, values[j]);
+      }
+    }
+  }
+
+  /*
+   * Calls the invocable with the index and a const reference to each stored element, in increasing index order
+   */
+  template <typename Invocable>
+  void for_each(Invocable&& invocable) const {
+    for (std::size_t i = 0u; i < _blocks.size(); ++i) {
+      const T* values = &_values[_slots[i] * block_size];
+      for (std::size_t j = 0u; j < block_size; ++j) {
+        invocable(_blocks[i] * block_size + j, values[j]);
+      }
+    }
+  }
+
+  /*
+   * Reserves memory for the given number of non-zero elements
+   */
+  void reserve(std::size_t nonzeros) {
+    const std::size_t num_blocks = (nonzeros + block_size - 1u) / block_size;
+    _blocks.reserve(num_blocks);
+    _slots.reserve(num_blocks);
+    _values.reserve(num_blocks * block_size);
+  }
+
+  /*
+   * Returns the number of stored elements (including the zeros inside the stored blocks)
+   */
+  [[nodiscard]] inline std::size_t nonzeros() const noexcept { return _values.size(); }
+
+  /*
+   * Returns the number of bytes used by the container
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return sizeof(*this) + (_blocks.capacity() + _slots.capacity()) * sizeof(std::size_t) +
+           _values.capacity() * sizeof(T);
+  }
+};
+
+inline namespace internal {
+
+/*
+ * Determines whether a container has the interface of an associative container, like std::unordered_map
+ */
+template <typename Container>
+concept associative_sparse_container = requires { typename Container::mapped_type; };
+
+/*
+ * Creates a sparse container for the given number of logical elements
+ * Associative containers reserve space for all of the logical elements, like the SparseBuffer always did
+ */
+template <typename Container>
+[[nodiscard]] Container make_sparse_container(std::size_t size) {
+  if constexpr (associative_sparse_container<Container>) {
+    Container container;
+    container.reserve(size);
+    return container;
+  } else {
+    return Container(size);
+  }
+}
+
+/*
+ * Returns a pointer to the element with the given index, or nullptr if the element isn't stored
+ */
+template <typename Container>
+[[nodiscard]] inline auto sparse_find(Container& container, std::size_t index) {
+  if constexpr (associative_sparse_container<std::remove_const_t<Container>>) {
+    auto it = container.find(index);
+    return it != container.end() ? &it->second : nullptr;
+  } else {
+    return container.find(index);
+  }
+}
+
+/*
+ * Stores an element that isn't stored yet, and returns a reference to it
+ */
+template <typename Container, typename T>
+inline auto& sparse_insert(Container& container, std::size_t index, const T& value) {
+  if constexpr (associative_sparse_container<Container>) {
+    return container.emplace(index, value).first->second;
+  } else {
+    return container.insert(index, value);
+  }
+}
+
+/*
+ * Calls the invocable with the index and a reference to each stored element
+ * Associative containers aren't iterated in index order
+ */
+template <typename Container, typename Invocable>
+void sparse_for_each(Container& container, Invocable&& invocable) {
+  if constexpr (associative_sparse_container<std::remove_const_t<Container>>) {
+    for (auto& [index, value] : container) {
+      invocable(index, value);
+    }
+  } else {
+    container.for_each(std::forward<Invocable>(invocable));
+  }
+}
+
+/*
+ * Stores elements given as a list of coordinates sorted in increasing order. Elements that are already stored are
+ * overwritten, and zeros that aren't stored are skipped
+ */
+template <typename Container, typename T>
+void sparse_insert_sorted(Container& container, std::span<const std::size_t> indices, std::span<const T> values) {
+  if constexpr (associative_sparse_container<Container>) {
+    for (std::size_t i = 0u; i < indices.size(); ++i) {
+      if (auto it = container.find(indices[i]); it != container.end()) {
+        it->second = values[i];
+      } else if (values[i] != T{}) {
+        container.emplace(indices[i], values[i]);
+      }
+    }
+  } else {
+    container.insert_sorted(indices, values);
+  }
+}
+
+/*
+ * Returns the number of stored elements
+ */
+template <typename Container>
+[[nodiscard]] inline std::size_t sparse_nonzeros(const Container& container) noexcept {
+  if constexpr (associative_sparse_container<Container>) {
+    return container.size();
+  } else {
+    return container.nonzeros();
+  }
+}
+
+/*
+ * Returns the number of bytes used by the container
+ * The memory used by an associative container is estimated from its bucket array, and a node per element holding the
+ * element, a pointer to the next node, and the cached hash
+ */
+template <typename Container>
+[[nodiscard]] inline std::size_t sparse_memory_usage(const Container& container) noexcept {
+  if constexpr (associative_sparse_container<Container>) {
+    static constexpr std::size_t node_size = sizeof(typename Container::value_type) + 2u * sizeof(void*);
+    return sizeof(container) + container.bucket_count() * sizeof(void*) + container.size() * node_size;
+  } else {
+    return container.memory_usage();
+  }
+}
+
+}  // namespace internal
+
+}  // namespace ntensor
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "execute.hpp"
+#include "tensor.hpp"
+
+namespace ntensor {
+
+/*
+ * Elements visited by the execute_sparse method
+ * stored: only the elements stored inside the sparse buffers. Suitable for invocables that keep zeros unchanged (for
+ * example multiplication or reading the values)
+ * all: all elements, including the ones that aren't stored. Elements that aren't stored are passed to the invocable as
+ * zero-initialized temporaries, and stored only if the invocable changes them to a non-zero value. Suitable for
+ * invocables that can densify the buffer (for example adding a constant)
+ */
+enum class sparse_visit { stored, all };
+
+/*
+ * Concept satisfied by buffers that only store some of their elements, and can iterate the stored elements
+ */
+template <typename Buffer>
+concept sparse_buffer = requires(Buffer b) {
+  { b.find(0u) };
+  b.for_each_stored([](std::size_t, auto&) {});
+};
+
+inline namespace internal {
+
+/*
+ * Channel and multi-index of a plane element
+ */
+template <std::size_t rank>
+struct sparse_element_position {
+  std::size_t channel;
+  std::array<std::size_t, rank> indexes;
+};
+
+/*
+ * Maps the location of an element inside a buffer back to the channel and the multi-index of the element inside a plane
+ * The dimensions are visited from the one with the largest stride to the one with the smallest stride, so planes with
+ * permuted strides are supported as well
+ * Parameters:
+ * @param plane: plane viewing the buffer
+ * @param index: location of the element inside the buffer
+ * @return: position of the element, or an empty optional if the element isn't a part of the plane
+ * Constraints:
+ * All of the plane's strides have to be positive
+ */
+template <typename Plane>
+[[nodiscard]] std::optional<sparse_element_position<std::decay_t<Plane>::rank()>> sparse_position(const Plane& plane,
+                                                                                                  std::size_t index) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t rank = plane_type::rank();
+  static constexpr auto channels = static_cast<long long>(plane_type::channels());
+  static constexpr auto dimensions = plane_type::dimensions();
+  static constexpr auto strides = plane_type::strides();
+
+  static constexpr auto order = []<std::size_t... is>(std::index_sequence<is...>) {
+    static_assert(((strides.template at<is>() > 0) && ...),
+                  "execute_sparse requires planes with positive strides");
+    constexpr std::array strides_array{strides.template at<is>()...};
+    std::array<std::size_t, rank> order{is...};
+    std::sort(order.begin(), order.end(),
+              [&strides_array](std::size_t lhs, std::size_t rhs) { return strides_array[lhs] > strides_array[rhs]; });
+    return order;
+  }(std::make_index_sequence<rank>());
+
+  static constexpr auto dimensions_array = []<std::size_t... is>(std::index_sequence<is...>) {
+    return std::array<std::size_t, rank>{dimensions.template at<is>()...};
+  }(std::make_index_sequence<rank>());
+  static constexpr auto strides_array = []<std::size_t... is>(std::index_sequence<is...>) {
+    return std::array<long long, rank>{strides.template at<is>()...};
+  }(std::make_index_sequence<rank>());
+
+  long long relative = static_cast<long long>(index) - plane.offset();
+  if (relative < 0) return std::nullopt;
+
+  sparse_element_position<rank> position{static_cast<std::size_t>(relative % channels), {}};
+  relative /= channels;
+
+  for (std::size_t d : order) {
+    const auto i = static_cast<std::size_t>(relative / strides_array[d]);
+    if (i >= dimensions_array[d]) return std::nullopt;
+    position.indexes[d] = i;
+    relative -= static_cast<long long>(i) * strides_array[d];
+  }
+
+  // A remainder means that the element lies inside a padding
+  if (relative) return std::nullopt;
+  return position;
+}
+
+/*
+ * Calls the invocable with an element, and with its channel and multi-index if the invocable accepts them
+ */
+template <typename Invocable, typename Value, std::size_t rank>
+inline void invoke_sparse(Invocable& invocable, Value& value, std::size_t channel,
+                          const std::array<std::size_t, rank>& indexes) {
+  if constexpr (std::is_invocable_v<Invocable&, Value&, std::size_t, const std::array<std::size_t, rank>&>) {
+    invocable(value, channel, indexes);
+  } else {
+    invocable(value);
+  }
+}
+
+/*
+ * Calls the invocable on the stored elements of a sparse plane
+ */
+template <typename Invocable, typename Plane>
+void sparse_execute_stored(Invocable& invocable, Plane&& plane) {
+  plane.buffer().for_each_stored([&invocable, &plane](std::size_t index, auto& value) {
+    if (const auto position = sparse_position(plane, index)) {
+      invoke_sparse(invocable, value, position->channel, position->indexes);
+    }
+  });
+}
+
+/*
+ * Calls the invocable on all elements of a sparse plane
+ * Elements that aren't stored are passed as temporaries. The ones changed to a non-zero value are stored after the
+ * iteration, since storing an element can invalidate the references to the other elements
+ */
+template <typename Invocable, typename Plane>
+void sparse_execute_all(Invocable& invocable, Plane&& plane) {
+  using plane_type = std::decay_t<Plane>;
+  using buffer_type = std::remove_reference_t<decltype(plane.buffer())>;
+  using element_type = std::remove_pointer_t<decltype(plane.buffer().find(0u))>;
+  using value_type = std::remove_const_t<element_type>;
+  static constexpr std::size_t N = product(plane_type::dimensions());
+  static constexpr std::size_t channels = plane_type::channels();
+
+  auto& buffer = plane.buffer();
+  std::vector<std::pair<std::size_t, value_type>> densified;
+  position_counter<plane_type> counter;
+
+  for (std::size_t idx = 0u; idx < N; ++idx, counter.advance()) {
+    for (std::size_t c = 0u; c < channels; ++c) {
+      const auto index = static_cast<std::size_t>(plane.offset() + counter.position() + static_cast<long long>(c));
+
+      if (element_type* value = buffer.find(index)) {
+        invoke_sparse(invocable, *value, c, counter.indexes());
+      } else if constexpr (std::is_const_v<buffer_type> || std::is_const_v<element_type>) {
+        const value_type zero{};
+        invoke_sparse(invocable, zero, c, counter.indexes());
+      } else {
+        value_type temporary{};
+        invoke_sparse(invocable, temporary, c, counter.indexes());
+        if (temporary != value_type{}) densified.emplace_back(index, temporary);
+      }
+    }
+  }
+
+  if constexpr (!std::is_const_v<buffer_type> && !std::is_const_v<element_type>) {
+    for (const auto& [index, value] : densified) {
+      buffer[index] = value;
+    }
+  }
+}
+
+/*
+ * Calls the invocable on all elements of a plane without a sparse buffer, together with their channels and
+ * multi-indexes
+ */
+template <typename Invocable, typename Plane>
+void dense_execute_indexed(Invocable& invocable, Plane&& plane) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t channels = plane_type::channels();
+
+  const std::size_t N = plane_elements(plane);
+  position_counter<plane_type> counter{plane};
+
+  for (std::size_t idx = 0u; idx < N; ++idx, counter.advance()) {
+    for (std::size_t c = 0u; c < channels; ++c) {
+      invoke_sparse(invocable, plane.at(counter.position() + static_cast<long long>(c)), c, counter.indexes());
+    }
+  }
+}
+
+}  // namespace internal
+
+/*
+ * Calls an invocable on the elements of a tensor, skipping the elements that aren't stored inside sparse buffers
+ * For planes with sparse buffers, only the stored elements are iterated (with sparse_visit::stored), so the cost is
+ * proportional to the number of stored elements instead of the number of logical elements. The locations of the stored
+ * elements are mapped back to the plane, so planes viewing a part of a buffer only visit their own elements. The
+ * elements are visited in the order in which the buffer's container stores them
+ * Planes with other buffers are iterated using the execute method, or element by element if the invocable takes the
+ * channel and the multi-index
+ * The invocable is called either with a reference to the element, or with a reference to the element, the element's
+ * channel (std::size_t), and the element's multi-index (const std::array<std::size_t, rank>&, starting from the
+ * innermost dimension)
+ * Parameters:
+ * @tparam visit: elements that are visited (see sparse_visit)
+ * @param invocable: Invocable called on the elements of a tensor
+ * @param tensor: Tensor on whose elements the invocable is called upon
+ */
+template <sparse_visit visit = sparse_visit::stored, typename Invocable, typename Tensor>
+void execute_sparse(Invocable&& invocable, Tensor&& tensor) {
+  for_each_plane(
+      [&invocable](auto&& plane) {
+        using indexes_type = std::array<std::size_t, std::decay_t<decltype(plane)>::rank()>;
+
+        if constexpr (sparse_buffer<std::remove_reference_t<decltype(plane.buffer())>>) {
+          if constexpr (visit == sparse_visit::stored) {
+            sparse_execute_stored(invocable, std::forward<decltype(plane)>(plane));
+          } else {
+            sparse_execute_all(invocable, std::forward<decltype(plane)>(plane));
+          }
+        } else if constexpr (std::is_invocable_v<Invocable&, decltype(plane.at(0u)), std::size_t,
+                                                 const indexes_type&>) {
+          dense_execute_indexed(invocable, std::forward<decltype(plane)>(plane));
+        } else {
+          sequenced_recursive_execute<sequenced_policy>(invocable, std::forward<decltype(plane)>(plane));
+        }
+      },
+      tensor);
+}
+
+}  // namespace ntensor
@@ -1,10 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <charconv>
-#include <format>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
+#include "concepts.hpp"
 #include "execute.hpp"
+#include "execution_policy.hpp"
 
 namespace ntensor {
 
@@ -31,6 +44,137 @@ struct additional_output_content {
   std::string footer;
 };
 
+/*
+ * Size of the buffer of the BufferedWriter class
+ */
+inline constexpr std::size_t writer_buffer_size = 1u << 14u;
+
+/*
+ * Writer that formats text into a local buffer, and writes the buffer to a sink in large blocks
+ * Writing each character and each value to a stream separately costs a virtual call (and often a locale lookup) per
+ * write, which dominates the time needed to write a large tensor. Arithmetic values are formatted using std::to_chars
+ * instead, and the sink is only accessed once the buffer is full, or when the writer is flushed
+ * Supported sinks:
+ * std::ostream and the classes derived from it
+ * std::FILE*
+ * invocables accepting a std::string_view
+ * any other type supporting operator<< with a std::string_view
+ * Parameters:
+ * @tparam Sink: type of the sink
+ */
+template <typename Sink>
+class BufferedWriter {
+ private:
+  // Number of characters reserved for a single value. The shortest representation of a long double needs fewer
+  static constexpr std::size_t max_value_length = 64u;
+
+  Sink& _sink;
+  std::size_t _size{};
+  std::array<char, writer_buffer_size> _buffer;
+
+  /*
+   * Flushes the buffer if it doesn't have enough space for the given number of characters
+   */
+  inline void reserve(std::size_t length) {
+    if (_buffer.size() - _size < length) [[unlikely]] {
+      flush();
+    }
+  }
+
+  /*
+   * Writes characters directly to the sink
+   */
+  void write_directly(const char* data, std::size_t size) {
+    if constexpr (std::is_base_of_v<std::ostream, Sink>) {
+      _sink.write(data, static_cast<std::streamsize>(size));
+    } else if constexpr (std::is_same_v<std::remove_cv_t<Sink>, std::FILE*>) {
+      std::fwrite(data, 1u, size, _sink);
+    } else if constexpr (std::is_invocable_v<Sink&, std::string_view>) {
+      _sink(std::string_view{data, size});
+    } else {
+      _sink << std::string_view{data, size};
+    }
+  }
+
+ public:
+  /*
+   * Creates a writer for the given sink
+   * Parameters:
+   * @param sink: sink to which the text is written. It has to outlive the writer
+   */
+  explicit BufferedWriter(Sink& sink) noexcept : _sink{sink} {}
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  /*
+   * Destructor
+   * Writes the remaining text to the sink. Flush the writer explicitly to handle the errors of the sink
+   */
+  ~BufferedWriter() { flush(); }
+
+  /*
+   * Writes the buffered text to the sink
+   */
+  void flush() {
+    if (_size) {
+      const std::size_t size = _size;
+      _size = 0u;
+      write_directly(_buffer.data(), size);
+    }
+  }
+
+  /*
+   * Writes a character
+   */
+  BufferedWriter& operator<<(char c) {
+    reserve(1u);
+    _buffer[_size++] = c;
+    return *this;
+  }
+
+  /*
+   * Writes a sequence of characters
+   * Sequences that don't fit into the buffer are written directly to the sink
+   */
+  BufferedWriter& operator<<(std::string_view text) {
+    if (text.size() > _buffer.size()) {
+      flush();
+      write_directly(text.data(), text.size());
+    } else {
+      reserve(text.size());
+      std::memcpy(_buffer.data() + _size, text.data(), text.size());
+      _size += text.size();
+    }
+    return *this;
+  }
+
+  /*
+   * Writes a value
+   * Arithmetic values are formatted using std::to_chars (floating-point values use their shortest representation which
+   * is read back exactly). Other values are formatted using their operator<< for output streams
+   * Parameters:
+   * @param value: written value
+   */
+  template <typename T>
+  BufferedWriter& operator<<(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return *this << (value ? '1' : '0');
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      reserve(max_value_length);
+      const auto result = std::to_chars(_buffer.data() + _size, _buffer.data() + _buffer.size(), value);
+      _size = static_cast<std::size_t>(result.ptr - _buffer.data());
+      return *this;
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      return *this << static_cast<std::string_view>(value);
+    } else {
+      std::ostringstream stream;
+      stream << value;
+      return *this << stream.view();
+    }
+  }
+};
+
 inline namespace internal {
 
 /*
@@ -92,14 +236,13 @@ void write_to_sink_impl(Plane&& plane, Sink&& sink, Formatter&& formatter) {
   if constexpr (rank > 1u) {
     sink << parameters.dimension_start << parameters.newline;
 
-    for (std::size_t i = 0u; i < plane_type::dimensions().template at<rank - 1U>(); ++i) {
-      write_to_sink_impl<parameters>(plane.template like<remove_nth_element<rank - 1u>(plane_type::dimensions()),
-                                                         remove_nth_element<rank - 1u>(plane_type::strides())>(
-                                         i * plane_type::strides().template at<rank - 1u>() * plane_type::channels()),
-                                     std::forward<Sink>(sink), std::forward<Formatter>(formatter));
+    for (std::size_t i = 0u; i < plane_extent<rank - 1u>(plane); ++i) {
+      write_to_sink_impl<parameters>(slice_outermost(plane, i), std::forward<Sink>(sink),
+                                     std::forward<Formatter>(formatter));
     }
   } else if constexpr (rank == 1U) {
-    static constexpr std::size_t dimension = plane_type::dimensions().template at<0u>();
+    const std::size_t dimension = plane_extent<0u>(plane);
+    const long long stride = plane_stride<0u>(plane);
     static constexpr std::size_t channels = plane_type::channels();
 
     sink << parameters.dimension_start;
@@ -109,11 +252,11 @@ void write_to_sink_impl(Plane&& plane, Sink&& sink, Formatter&& formatter) {
         sink << parameters.channels_start;
       }
 
-      formatter(sink, plane.at(d * plane_type::strides().template at<0u>() * plane_type::channels()));
+      formatter(sink, plane.at(d * stride * plane_type::channels()));
 
       for (std::size_t c = 1u; c < plane_type::channels(); ++c) {
         sink << parameters.delimiter;
-        formatter(sink, plane.at(d * plane_type::strides().template at<0u>() * plane_type::channels() + c));
+        formatter(sink, plane.at(d * stride * plane_type::channels() + c));
       }
 
       if constexpr (channels > 1u) {
@@ -214,8 +357,14 @@ void load_from_source_impl(Plane&& plane, Converter&& converter, std::string_vie
 
     using plane_type = typename std::decay_t<decltype(plane)>;
 
-    const auto pos = compute_array_position_from_index<plane_type::channels()>(
-        compute_unaligned_strides(plane_type::dimensions()), plane_type::strides(), channel, array_idx);
+    const auto pos = [&plane, channel, array_idx] {
+      if constexpr (is_dynamic_plane_v<plane_type>) {
+        return position_counter<plane_type>{plane, array_idx}.position() + static_cast<long long>(channel);
+      } else {
+        return compute_array_position_from_index<plane_type::channels()>(
+            compute_unaligned_strides(plane_type::dimensions()), plane_type::strides(), channel, array_idx);
+      }
+    }();
     typename plane_type::value_type value{};
 
     [[maybe_unused]] auto success = converter(string_value, value);
@@ -237,61 +386,618 @@ expects:
   return;
 };
 
-}  // namespace internal
+/*
+ * Minimum number of characters parsed by a single chunk of a parallel load
+ * Smaller chunks cost more to schedule than to parse
+ */
+inline constexpr std::size_t parallel_min_chunk_characters = 1u << 16u;
 
 /*
- * Saves a tensor to a sink
+ * Special IO characters, which separate the values in a source
  * Parameters:
- * @tparam parameters: Special characters used while writing the Tensor object
- * @param tensor: Tensor object that's going to be written to the given stream
- * @param sink: Stream to which the Tensor object is written
- * @param additional_content: Additional content that will be added to the stream, if it exists
- * @param formatter: User specified function used for custom formatting of the written tensor elements. For example, the
- * user can determine how real and imaginary numbers are stored in the stream, adjust the precision for floating-point
- * numbers, encode the values, store the values in binary format, etc.
+ * @tparam parameters: Special characters used while reading the Tensor object
  */
-template <io_parameters parameters = {}, typename Tensor, typename Sink, typename Formatter>
-void write_to_sink(Tensor&& tensor, Sink&& sink, const additional_output_content& additional_content,
-                   Formatter&& formatter) {
+template <io_parameters parameters>
+inline constexpr std::array<char, 9u> separators{parameters.delimiter,       parameters.newline,
+                                                 parameters.plane_start,     parameters.plane_end,
+                                                 parameters.dimension_start, parameters.dimension_end,
+                                                 parameters.channels_start,  parameters.channels_end,
+                                                 parameters.comment};
+
+/*
+ * Table specifying for each character whether it's a separator
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ */
+template <io_parameters parameters>
+inline constexpr std::array<bool, 256u> separator_table = [] {
+  std::array<bool, 256u> table{};
+  for (char separator : separators<parameters>) {
+    table[static_cast<std::uint8_t>(separator)] = true;
+  }
+  return table;
+}();
+
+/*
+ * Checks whether a character separates the values in a source (whether it's one of the special IO characters)
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param c: checked character
+ */
+template <io_parameters parameters>
+[[nodiscard]] inline bool is_separator(char c) noexcept {
+  return separator_table<parameters>[static_cast<std::uint8_t>(c)];
+}
+
+/*
+ * Vectorizable version of the is_separator method, used when classifying blocks of characters
+ * Table lookups can't be vectorized, and compilers turn chains of equality comparisons into bit tests, which can't be
+ * vectorized either. The character is therefore compared using a minimum of exclusive ors
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param c: checked character
+ * @return: 1 if the character is a separator, 0 otherwise
+ */
+template <io_parameters parameters>
+[[nodiscard]] inline std::uint8_t separator_flag(std::uint8_t c) noexcept {
+  std::uint8_t distance = std::numeric_limits<std::uint8_t>::max();
+
+  for (char separator : separators<parameters>) {
+    distance = std::min<std::uint8_t>(distance, c ^ static_cast<std::uint8_t>(separator));
+  }
+
+  return distance == 0u;
+}
+
+/*
+ * Structural characters found in a chunk of a source
+ * values: number of values (sequences of characters that aren't separators) starting in the chunk
+ * dimensions: number of opened dimensions minus the number of closed dimensions
+ * channels: number of opened channel groups minus the number of closed channel groups
+ */
+struct chunk_structure {
+  std::size_t values{};
+  long long dimensions{};
+  long long channels{};
+};
+
+/*
+ * Number of characters classified at once by the scan_chunk method. The counts of a block fit into 8-bit integers, so
+ * the compiler classifies 16 or more characters per vector instruction
+ */
+inline constexpr std::size_t scan_block_size = 64u;
+
+/*
+ * Scans a chunk of a source for its structural characters
+ * A value starts at each character that isn't a separator, but follows a separator (or starts the chunk). Since values
+ * are stored in the logical order of the plane's elements (channels included), the number of values preceding a chunk
+ * is the index of the chunk's first value in the plane, regardless of how deeply the chunk is nested in dimensions
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param chunk: scanned chunk
+ */
+template <io_parameters parameters>
+[[nodiscard]] chunk_structure scan_chunk(std::string_view chunk) noexcept {
+  static constexpr std::size_t block = scan_block_size;
+  static constexpr auto count = [](std::uint8_t character, char special_character) -> std::uint8_t {
+    return character == static_cast<std::uint8_t>(special_character);
+  };
+
+  if (chunk.empty()) {
+    return {};
+  }
+
+  const auto* characters = reinterpret_cast<const std::uint8_t*>(chunk.data());
+  chunk_structure structure;
+
+  auto scan_character = [&structure, characters](std::size_t i) {
+    structure.dimensions += count(characters[i], parameters.dimension_start);
+    structure.dimensions -= count(characters[i], parameters.dimension_end);
+    structure.channels += count(characters[i], parameters.channels_start);
+    structure.channels -= count(characters[i], parameters.channels_end);
+  };
+
+  structure.values = !is_separator<parameters>(chunk[0u]);
+  scan_character(0u);
+
+  // The blocks start at the second character, so the first separator flag of a block belongs to the preceding character
+  std::size_t i = 1u;
+  std::array<std::uint8_t, block + 1u> flags;
+
+  for (; i + block <= chunk.size(); i += block) {
+    flags[0u] = separator_flag<parameters>(characters[i - 1u]);
+    for (std::size_t j = 0u; j < block; ++j) {
+      flags[j + 1u] = separator_flag<parameters>(characters[i + j]);
+    }
+
+    std::uint8_t values = 0u;
+    for (std::size_t j = 0u; j < block; ++j) {
+      values += flags[j] & (flags[j + 1u] ^ 1u);
+    }
+
+    std::uint8_t dimensions_start = 0u, dimensions_end = 0u, channels_start = 0u, channels_end = 0u;
+    for (std::size_t j = 0u; j < block; ++j) {
+      dimensions_start += count(characters[i + j], parameters.dimension_start);
+      dimensions_end += count(characters[i + j], parameters.dimension_end);
+      channels_start += count(characters[i + j], parameters.channels_start);
+      channels_end += count(characters[i + j], parameters.channels_end);
+    }
+
+    structure.values += values;
+    structure.dimensions += static_cast<long long>(dimensions_start) - dimensions_end;
+    structure.channels += static_cast<long long>(channels_start) - channels_end;
+  }
+
+  // Characters that don't fill a whole block
+  for (; i < chunk.size(); ++i) {
+    structure.values += is_separator<parameters>(chunk[i - 1u]) && !is_separator<parameters>(chunk[i]);
+    scan_character(i);
+  }
+
+  return structure;
+}
+
+/*
+ * Converts the values of a chunk of a source, and writes them to a plane
+ * The positions of the elements are computed with a position_counter, so there's a single division per chunk
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param plane: plane to which the values are written
+ * @param converter: function used for converting the values
+ * @param chunk: chunk of the source
+ * @param first_value: index of the chunk's first value in the plane (channels included)
+ */
+template <io_parameters parameters, typename Plane, typename Converter>
+void load_chunk(Plane& plane, Converter& converter, std::string_view chunk, std::size_t first_value) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t channels = plane_type::channels();
+
+  position_counter<plane_type> counter{plane, first_value / channels};
+  std::size_t channel = first_value % channels;
+  std::size_t i = 0u;
+
+  while (true) {
+    while (i < chunk.size() && is_separator<parameters>(chunk[i])) {
+      ++i;
+    }
+
+    if (i == chunk.size()) {
+      break;
+    }
+
+    const std::size_t first = i;
+    while (i < chunk.size() && !is_separator<parameters>(chunk[i])) {
+      ++i;
+    }
+
+    typename plane_type::value_type value{};
+
+    [[maybe_unused]] auto success = converter(chunk.substr(first, i - first), value);
+
+#ifdef ENABLE_NT_EXPECTS
+    Expects(success);
+#endif
+
+    plane.at(counter.position() + channel) = value;
+
+    if (++channel == channels) {
+      channel = 0u;
+      counter.advance();
+    }
+  }
+}
+
+/*
+ * Parallel implementation of the load_from_source method
+ * The text of the plane is split into chunks that end at separators, so no value is split between two chunks. The
+ * chunks are scanned in parallel to count their values, and once the index of each chunk's first value is known, the
+ * chunks are converted in parallel, each one writing to its own elements of the plane
+ * Only the buffers that expose their memory are known to be safe to write concurrently, so the planes with other
+ * buffers are loaded as a single chunk
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param pool: thread pool on which the chunks are processed
+ * @param plane: plane to which the values are written
+ * @param converter: function used for converting the values. It's called concurrently
+ * @param data: source, which is advanced past the plane
+ */
+template <io_parameters parameters, typename Plane, typename Converter>
+void parallel_load_from_source_impl(ThreadPool& pool, Plane&& plane, Converter&& converter, std::string_view& data) {
+  using plane_type = std::decay_t<Plane>;
+
+#ifdef ENABLE_NT_EXPECTS
+  Expects(data.size());
+#endif
+
+  // The plane ends with its closing character, or with the footer
+  const std::size_t length = std::min(data.find(parameters.plane_end), data.find(parameters.comment));
+  const std::string_view text = data.substr(0u, length);
+
+  std::vector<std::size_t> boundaries{0u};
+
+  if constexpr (contiguous_buffer<typename plane_type::buffer_type>) {
+    const std::size_t chunk_size = std::max(parallel_min_chunk_characters, text.size() / (4u * pool.size() + 1u));
+
+    for (std::size_t boundary = chunk_size; boundary < text.size(); boundary += chunk_size) {
+      while (boundary < text.size() && !is_separator<parameters>(text[boundary])) {
+        ++boundary;
+      }
+      if (boundary < text.size()) {
+        boundaries.push_back(boundary);
+      }
+    }
+  }
+
+  boundaries.push_back(text.size());
+
+  const std::size_t num_chunks = boundaries.size() - 1u;
+  auto chunk = [&text, &boundaries](std::size_t i) {
+    return text.substr(boundaries[i], boundaries[i + 1u] - boundaries[i]);
+  };
+
+  std::vector<chunk_structure> structures(num_chunks);
+  pool.parallel_for(0u, num_chunks, 1u, [&structures, &chunk](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      structures[i] = scan_chunk<parameters>(chunk(i));
+    }
+  });
+
+  // Index of the first value of each chunk
+  std::vector<std::size_t> first_values(num_chunks + 1u);
+  chunk_structure total;
+
+  for (std::size_t i = 0u; i < num_chunks; ++i) {
+    first_values[i] = total.values;
+    total.values += structures[i].values;
+    total.dimensions += structures[i].dimensions;
+    total.channels += structures[i].channels;
+  }
+
+#ifdef ENABLE_NT_EXPECTS
+  Expects(total.values <= plane_elements(plane) * plane_type::channels());
+  Expects(total.dimensions == 0);
+  Expects(total.channels == 0);
+#endif
+
+  pool.parallel_for(0u, num_chunks, 1u, [&](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      load_chunk<parameters>(plane, converter, chunk(i), first_values[i]);
+    }
+  });
+
+  data.remove_prefix(text.size());
+  if (data.starts_with(parameters.plane_end)) {
+    data.remove_prefix(1u);
+  }
+}
+
+/*
+ * Skips the header and the empty lines at the beginning of a source
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param data: source
+ */
+template <io_parameters parameters>
+void skip_header(std::string_view& data) {
+  while (data.starts_with(parameters.comment) || data.front() == parameters.newline) {
+    data.remove_prefix(data.find_first_of(parameters.newline));
+    data.remove_prefix(data.find_first_not_of(parameters.newline));
+  }
+}
+
+/*
+ * Size of the buffer used by the load_from_stream method. It's also the maximum length of a single value
+ */
+inline constexpr std::size_t reader_buffer_size = 1u << 16u;
+
+/*
+ * Reads characters from a stream or a read callback into a fixed size buffer, and splits them into special characters
+ * and values
+ * Values are returned as views into the buffer. When a value reaches the end of the buffered characters, the
+ * unconsumed characters are moved to the beginning of the buffer, and the rest of the buffer is refilled from the
+ * source, so a value that's split between two reads is still returned as a single view
+ * Supported sources:
+ * std::istream and the classes derived from it
+ * invocables accepting a pointer to a character buffer and its size, and returning the number of characters written
+ * to the buffer (0 once the source is exhausted)
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @tparam Source: type of the source
+ */
+template <io_parameters parameters, typename Source>
+class stream_reader {
+ private:
+  Source& _source;
+  std::vector<char> _buffer;
+  std::size_t _first{};
+  std::size_t _last{};
+  bool _exhausted{false};
+
+  /*
+   * Moves the unconsumed characters to the beginning of the buffer, and reads more characters after them
+   * @return: false if no characters could be read
+   */
+  bool refill() {
+    if (_exhausted) {
+      return false;
+    }
+
+    std::memmove(_buffer.data(), _buffer.data() + _first, _last - _first);
+    _last -= _first;
+    _first = 0u;
+
+    std::size_t read = 0u;
+    if constexpr (std::is_base_of_v<std::istream, Source>) {
+      _source.read(_buffer.data() + _last, static_cast<std::streamsize>(_buffer.size() - _last));
+      read = static_cast<std::size_t>(_source.gcount());
+    } else {
+      read = _source(_buffer.data() + _last, _buffer.size() - _last);
+    }
+
+    _exhausted = !read;
+    _last += read;
+    return read;
+  }
+
+ public:
+  /*
+   * Creates a reader for the given source
+   * Parameters:
+   * @param source: source from which the characters are read. It has to outlive the reader
+   */
+  explicit stream_reader(Source& source) : _source{source}, _buffer(reader_buffer_size) {}
+
+  /*
+   * Makes sure that at least one unconsumed character is buffered
+   * @return: false if the source is exhausted
+   */
+  [[nodiscard]] bool fill() { return _first < _last || (refill() && _first < _last); }
+
+  /*
+   * Returns the next unconsumed character. The fill method has to return true beforehand
+   */
+  [[nodiscard]] char front() const noexcept { return _buffer[_first]; }
+
+  /*
+   * Consumes the next character. The fill method has to return true beforehand
+   */
+  void pop() noexcept { ++_first; }
+
+  /*
+   * Consumes the characters up to the next newline character (or up to the end of the source)
+   */
+  void skip_line() {
+    while (fill() && front() != parameters.newline) {
+      pop();
+    }
+  }
+
+  /*
+   * Consumes the next value, which ends at the next separator (or at the end of the source)
+   * @return: view of the value, which remains valid until the next call of a method of the reader
+   */
+  [[nodiscard]] std::string_view value() {
+    std::size_t length = 0u;
+
+    while (true) {
+      while (_first + length < _last && !is_separator<parameters>(_buffer[_first + length])) {
+        ++length;
+      }
+
+      if (_first + length < _last) {
+        break;
+      }
+
+#ifdef ENABLE_NT_EXPECTS
+      // The value doesn't fit into the buffer
+      Expects(_first || _last < _buffer.size());
+#endif
+
+      if (!refill()) {
+        break;
+      }
+    }
+
+    const std::string_view view{_buffer.data() + _first, length};
+    _first += length;
+    return view;
+  }
+};
+
+/*
+ * Implementation of the load_from_stream method
+ * The source is read the same way as by the load_from_source_impl method, except that the values are taken from a
+ * stream_reader
+ */
+template <io_parameters parameters, typename Plane, typename Converter, typename Reader>
+void load_from_stream_impl(Plane&& plane, Converter&& converter, Reader& reader) {
+  using plane_type = std::decay_t<Plane>;
+  static constexpr std::size_t channels = plane_type::channels();
+
+  position_counter<plane_type> counter{plane};
+  std::size_t channel = 0u;
+
+#ifdef ENABLE_NT_EXPECTS
+  const std::size_t num_values = plane_elements(plane) * channels;
+  std::size_t values = 0u;
+  int dimensions_open = 0;
+  bool channels_closed = true;
+  bool plane_closed = true;
+
+  Expects(reader.fill());
+#endif
+
+  while (reader.fill()) {
+    switch (reader.front()) {
+      case parameters.plane_start:
+#ifdef ENABLE_NT_EXPECTS
+        Expects(plane_closed);
+        plane_closed = false;
+#endif
+        reader.pop();
+        continue;
+      case parameters.plane_end:
+#ifdef ENABLE_NT_EXPECTS
+        Expects(!plane_closed);
+        plane_closed = true;
+#endif
+        reader.pop();
+        goto expects;
+      case parameters.dimension_start:
+#ifdef ENABLE_NT_EXPECTS
+        ++dimensions_open;
+#endif
+        reader.pop();
+        continue;
+      case parameters.dimension_end:
+#ifdef ENABLE_NT_EXPECTS
+        --dimensions_open;
+#endif
+        reader.pop();
+        continue;
+      case parameters.channels_start:
+#ifdef ENABLE_NT_EXPECTS
+        Expects(channels_closed);
+        channels_closed = false;
+#endif
+        reader.pop();
+        continue;
+      case parameters.channels_end:
+#ifdef ENABLE_NT_EXPECTS
+        Expects(!channels_closed);
+        channels_closed = true;
+#endif
+        reader.pop();
+        continue;
+      case parameters.delimiter:
+      case parameters.newline:
+        reader.pop();
+        continue;
+      case parameters.comment:
+        // We've reached the footer
+        goto expects;
+    };
+
+    {
+      const std::string_view string_value = reader.value();
+      typename plane_type::value_type value{};
+
+      [[maybe_unused]] auto success = converter(string_value, value);
+
+#ifdef ENABLE_NT_EXPECTS
+      Expects(success);
+      Expects(values++ < num_values);
+#endif
+
+      plane.at(counter.position() + channel) = value;
+
+      if (++channel == channels) {
+        channel = 0u;
+        counter.advance();
+      }
+    }
+  }
+
+expects:
+#ifdef ENABLE_NT_EXPECTS
+  Expects(dimensions_open == 0);
+  Expects(channels_closed);
+  Expects(plane_closed);
+#endif
+  return;
+}
+
+/*
+ * Implementation of the write_to_sink methods
+ * The text is written through a BufferedWriter, and each element is written by the formatter, which is called with
+ * the writer and the element
+ */
+template <io_parameters parameters, typename Tensor, typename Sink, typename Formatter>
+void write_to_writer(Tensor&& tensor, Sink& sink, const additional_output_content& additional_content,
+                     Formatter&& formatter) {
   static_assert(all_io_parameters_unique<parameters>());
 
-  auto write_additional_content = [&sink](auto& content, auto& comment, auto& newline) {
+  using writer_type = BufferedWriter<Sink>;
+  writer_type writer{sink};
+
+  auto write_additional_content = [&writer](auto& content, auto& comment, auto& newline) {
     if (!content.empty()) {
-      sink << comment;
+      writer << comment;
 
       for (auto c : content) {
-        sink << c;
+        writer << c;
 
         if (c == '\n' || c == '\r') {
-          sink << comment;
+          writer << comment;
         }
       }
-      sink << newline;
+      writer << newline;
     }
   };
 
   write_additional_content(additional_content.header, parameters.comment, parameters.newline);
 
-  std::string plane_delimiter{};
+  bool first_plane = true;
 
   for_each_plane(
       [&](auto&& plane) {
-        static_assert((std::is_invocable_v<decltype(formatter), Sink, decltype(plane.at(0u))>));
-        sink << plane_delimiter << parameters.plane_start << parameters.newline;
-        write_to_sink_impl<parameters>(std::forward<decltype(plane)>(plane), sink, formatter);
-        sink << parameters.plane_end;
-        plane_delimiter = std::format("{}{}", parameters.delimiter, parameters.newline);
+        static_assert((std::is_invocable_v<decltype(formatter), writer_type&, decltype(plane.at(0u))>));
+        if (!first_plane) {
+          writer << parameters.delimiter << parameters.newline;
+        }
+        writer << parameters.plane_start << parameters.newline;
+        write_to_sink_impl<parameters>(std::forward<decltype(plane)>(plane), writer, formatter);
+        writer << parameters.plane_end;
+        first_plane = false;
       },
       tensor);
-  sink << parameters.newline << parameters.newline;
+  writer << parameters.newline << parameters.newline;
 
   write_additional_content(additional_content.footer, parameters.comment, parameters.newline);
+
+  writer.flush();
+}
+
+}  // namespace internal
+
+/*
+ * Saves a tensor to a sink
+ * The text is written through a BufferedWriter, so the sink can be any of the sinks supported by it
+ * Parameters:
+ * @tparam parameters: Special characters used while writing the Tensor object
+ * @param tensor: Tensor object that's going to be written to the given stream
+ * @param sink: Stream to which the Tensor object is written
+ * @param additional_content: Additional content that will be added to the stream, if it exists
+ * @param formatter: User specified function used for custom formatting of the written tensor elements. For example, the
+ * user can determine how real and imaginary numbers are stored in the stream, adjust the precision for floating-point
+ * numbers, encode the values, store the values in binary format, etc. The formatter is called with the sink and the
+ * element, so it can rely on the sink's own formatting (like the precision of a std::ostream). The text buffered
+ * before an element is written to the sink first, so custom formatters don't benefit from the buffering. A std::FILE*
+ * and the invocable sinks don't support operator<<, so for them, the formatter is called with the BufferedWriter
+ */
+template <io_parameters parameters = {}, typename Tensor, typename Sink, typename Formatter>
+void write_to_sink(Tensor&& tensor, Sink&& sink, const additional_output_content& additional_content,
+                   Formatter&& formatter) {
+  using sink_type = std::remove_reference_t<Sink>;
+
+  if constexpr (std::is_same_v<std::remove_cv_t<sink_type>, std::FILE*> ||
+                std::is_invocable_v<sink_type&, std::string_view>) {
+    write_to_writer<parameters>(tensor, sink, additional_content, formatter);
+  } else {
+    write_to_writer<parameters>(tensor, sink, additional_content,
+                                [&sink, &formatter](BufferedWriter<sink_type>& writer, const auto& value) {
+                                  static_assert(std::is_invocable_v<Formatter&, sink_type&, decltype(value)>);
+                                  writer.flush();
+                                  formatter(sink, value);
+                                });
+  }
 }
 
 /*
  * Adapter for the write_to_sink method that uses a predefined formatter
  * In this case no value formatting is applied. Instead the values are stored exactly as they are found in the Tensor
- * object Parameters:
+ * object. Arithmetic values are formatted by the BufferedWriter (see its operator<<), without the sink's formatting
+ * Parameters:
  * @tparam parameters: Special characters used while writing the Tensor object
  * @param tensor: Tensor object that's going to be written to the given stream
  * @param sink: Stream to which the Tensor object is written
@@ -299,7 +1005,8 @@ void write_to_sink(Tensor&& tensor, Sink&& sink, const additional_output_content
  */
 template <io_parameters parameters = {}, typename Tensor, typename Sink>
 void write_to_sink(Tensor&& tensor, Sink&& sink, const additional_output_content& additional_content = {}) {
-  write_to_sink<parameters>(tensor, sink, additional_content, [](auto& sink, const auto& value) { sink << value; });
+  write_to_writer<parameters>(tensor, sink, additional_content,
+                              [](auto& writer, const auto& value) { writer << value; });
 }
 
 /*
@@ -314,11 +1021,7 @@ template <io_parameters parameters = {}, typename Tensor, typename Converter>
 void load_from_source(Tensor&& tensor, std::string_view data, Converter&& converter) {
   static_assert(all_io_parameters_unique<parameters>());
 
-  // Skip header and empty lines
-  while (data.starts_with(parameters.comment) || data.front() == parameters.newline) {
-    data.remove_prefix(data.find_first_of(parameters.newline));
-    data.remove_prefix(data.find_first_not_of(parameters.newline));
-  }
+  skip_header<parameters>(data);
 
   for_each_plane(
       [&converter, &data](auto& plane) {
@@ -347,4 +1050,100 @@ void load_from_source(Tensor&& tensor, std::string_view data) {
                                [](std::string_view view, auto& value) { return string_view_to_number(view, value); });
 }
 
+/*
+ * Reads a sequence of elements from a source into a Tensor object, using the specified execution policy
+ * With the parallel policy, the text of each plane is split into chunks, whose values are converted on a thread pool
+ * (see parallel_load_from_source_impl). The converter has to be safe to call concurrently. The other policies read
+ * the source sequentially
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param policy: execution policy
+ * @param tensor: Tensor object to which the read elements are written to
+ * @param data: string_view of the source from which the elements are read
+ * @param converter: User specified function used for reading (parsing) the elements from the source
+ */
+template <io_parameters parameters = {}, execution_policy Policy, typename Tensor, typename Converter>
+void load_from_source(Policy&& policy, Tensor&& tensor, std::string_view data, Converter&& converter) {
+  static_assert(all_io_parameters_unique<parameters>());
+
+  if constexpr (is_parallel_policy_v<Policy>) {
+    skip_header<parameters>(data);
+
+    for_each_plane(
+        [&policy, &converter, &data](auto& plane) {
+          static_assert((std::is_invocable_v<Converter, std::string_view, decltype(plane.at(0u))>));
+          parallel_load_from_source_impl<parameters>(policy.pool(), plane, converter, data);
+        },
+        tensor);
+  } else {
+    load_from_source<parameters>(std::forward<Tensor>(tensor), data, std::forward<Converter>(converter));
+  }
+}
+
+/*
+ * Adapter for the load_from_source method with an execution policy, that uses a predefined converter
+ * Warning
+ * The default converter supports integer values only. For any other type, a custom converter needs to be supplied
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param policy: execution policy
+ * @param tensor: Tensor object to which the read elements are written to
+ * @param data: string_view of the source from which the elements are read
+ */
+template <io_parameters parameters = {}, execution_policy Policy, typename Tensor>
+void load_from_source(Policy&& policy, Tensor&& tensor, std::string_view data) {
+  load_from_source<parameters>(std::forward<Policy>(policy), std::forward<Tensor>(tensor), data,
+                               [](std::string_view view, auto& value) { return string_view_to_number(view, value); });
+}
+
+/*
+ * Reads a sequence of elements from a stream into a Tensor object
+ * Unlike load_from_source, the source doesn't have to be stored in memory. It's read in blocks into a buffer of a fixed
+ * size (see reader_buffer_size), and the elements are written to the planes as soon as they're read, so the memory
+ * used by the method doesn't depend on the size of the source. Only the planes are read from the stream: the reading
+ * stops at the footer, or after the last plane
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param tensor: Tensor object to which the read elements are written to
+ * @param source: std::istream, or an invocable that writes at most the given number of characters to the given buffer,
+ * and returns the number of written characters (0 once there are no more characters)
+ * @param converter: User specified function used for reading (parsing) the elements from the source
+ */
+template <io_parameters parameters = {}, typename Tensor, typename Source, typename Converter>
+void load_from_stream(Tensor&& tensor, Source&& source, Converter&& converter) {
+  static_assert(all_io_parameters_unique<parameters>());
+
+  stream_reader<parameters, std::remove_reference_t<Source>> reader{source};
+
+  // Skip header and empty lines
+  while (reader.fill() && (reader.front() == parameters.comment || reader.front() == parameters.newline)) {
+    reader.skip_line();
+    while (reader.fill() && reader.front() == parameters.newline) {
+      reader.pop();
+    }
+  }
+
+  for_each_plane(
+      [&converter, &reader](auto& plane) {
+        static_assert((std::is_invocable_v<Converter, std::string_view, decltype(plane.at(0u))>));
+        load_from_stream_impl<parameters>(plane, converter, reader);
+      },
+      tensor);
+}
+
+/*
+ * Adapter for the load_from_stream method that uses a predefined converter
+ * Warning
+ * The default converter supports integer values only. For any other type, a custom converter needs to be supplied
+ * Parameters:
+ * @tparam parameters: Special characters used while reading the Tensor object
+ * @param tensor: Tensor object to which the read elements are written to
+ * @param source: std::istream, or a read callback (see the load_from_stream method)
+ */
+template <io_parameters parameters = {}, typename Tensor, typename Source>
+void load_from_stream(Tensor&& tensor, Source&& source) {
+  load_from_stream<parameters>(std::forward<Tensor>(tensor), std::forward<Source>(source),
+                               [](std::string_view view, auto& value) { return string_view_to_number(view, value); });
+}
+
 }  // namespace ntensor
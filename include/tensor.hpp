@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <numeric>
 
+#include "dynamic_plane.hpp"
+#include "execution_policy.hpp"
 #include "planes.hpp"
 
 namespace ntensor {
@@ -214,6 +220,21 @@ class Tensor : public reorder_as_first_policy_t<Policies<Tensor<Planes, Policies
    */
   explicit Tensor(Planes&& planes) : _planes{std::move(planes)} {}
 
+  /*
+   * Evaluates an expression and stores the result into the elements of the tensor (see the assign method in
+   * expression.hpp). Unlike the copy assignment, which makes the tensor share the planes of another tensor, the planes
+   * of the tensor are kept and their elements are overwritten
+   * Parameters:
+   * @param expression: evaluated expression
+   * @return: reference to the tensor
+   */
+  template <typename Expression>
+    requires requires(Tensor& tensor, const Expression& expression) { assign(tensor, expression); }
+  Tensor& operator=(const Expression& expression) {
+    assign(*this, expression);
+    return *this;
+  }
+
   /*
    * Compares two tensors for equality
    * Parameters:
@@ -276,6 +297,21 @@ class Tensor<Planes> {
    */
   explicit Tensor(Planes&& planes) : _planes{std::move(planes)} {}
 
+  /*
+   * Evaluates an expression and stores the result into the elements of the tensor (see the assign method in
+   * expression.hpp). Unlike the copy assignment, which makes the tensor share the planes of another tensor, the planes
+   * of the tensor are kept and their elements are overwritten
+   * Parameters:
+   * @param expression: evaluated expression
+   * @return: reference to the tensor
+   */
+  template <typename Expression>
+    requires requires(Tensor& tensor, const Expression& expression) { assign(tensor, expression); }
+  Tensor& operator=(const Expression& expression) {
+    assign(*this, expression);
+    return *this;
+  }
+
   /*
    * Compares two tensors for equality
    * Parameters:
@@ -353,6 +389,7 @@ void for_each_plane(Invocable&& invocable, Tensor&& tensor) {
  * @param tensors: Sequence of Tensor objects over whose planes the invocable is called
  */
 template <typename Invocable, typename... Tensors>
+  requires(!execution_policy<Invocable>)
 void for_all_planes(Invocable&& invocable, Tensors&&... tensors) {
   using first_tensor = fts_t<Tensors...>;
   static constexpr std::size_t N = std::decay_t<decltype(std::declval<first_tensor>().planes())>::size();
@@ -364,4 +401,70 @@ void for_all_planes(Invocable&& invocable, Tensors&&... tensors) {
   dispatcher([&tensors..., &invocable](auto idx) { invocable(tensors.planes().template plane<idx>()...); });
 }
 
+/*
+ * Calls the invocable with a plane from each tensor, using the specified execution policy. See the overload without
+ * an execution policy for details
+ * With the parallel policy, the invocations for different planes run concurrently on a thread pool, and the method
+ * returns once all of them are completed. The work of an invocation is estimated by the number of elements of all
+ * channels of its planes, and invocations are started in order of decreasing work, so that a large plane doesn't start
+ * last and delay the return. Each thread of the pool takes the next invocation once it's done with its previous one.
+ * The invocations must therefore not depend on each other. If one of them throws, the first exception is rethrown once
+ * all of them are completed
+ * With the sequenced and the unsequenced policies, the planes are dispatched one after another
+ * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param invocable: invocable that's called with all of the planes
+ * @param tensors: Sequence of Tensor objects over whose planes the invocable is called
+ */
+template <execution_policy Policy, typename Invocable, typename... Tensors>
+void for_all_planes(Policy&& policy, Invocable&& invocable, Tensors&&... tensors) {
+  using first_tensor = fts_t<Tensors...>;
+  static constexpr std::size_t N = std::decay_t<decltype(std::declval<first_tensor>().planes())>::size();
+
+  if constexpr (!is_parallel_policy_v<Policy> || N == 1u) {
+    for_all_planes(std::forward<Invocable>(invocable), std::forward<Tensors>(tensors)...);
+  } else {
+    // Assure that all tensors have the same number of planes
+    static_assert(((N == std::decay_t<decltype(tensors.planes())>::size()) && ...));
+
+    static constexpr auto dispatcher = make_index_dispatcher(std::make_index_sequence<N>{});
+
+    std::array<std::size_t, N> work{};
+    dispatcher([&work, &tensors...](auto idx) {
+      work[idx] = ((plane_elements(tensors.planes().template plane<idx>()) *
+                    std::decay_t<decltype(tensors.planes().template plane<idx>())>::channels()) +
+                   ...);
+    });
+
+    std::array<std::size_t, N> order;
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&work](std::size_t a, std::size_t b) { return work[a] > work[b]; });
+
+    // Each chunk of parallel_for claims the remaining invocations in order, until none are left
+    ThreadPool& pool = policy.pool();
+    std::atomic<std::size_t> next{0u};
+    pool.parallel_for(0u, std::min(N, pool.size() + 1u), 1u, [&](std::size_t, std::size_t) {
+      for (std::size_t i = next++; i < N; i = next++) {
+        dispatcher([&order, &tensors..., &invocable, i](auto idx) {
+          if (idx == order[i]) invocable(tensors.planes().template plane<idx>()...);
+        });
+      }
+    });
+  }
+}
+
+/*
+ * Calls an invocable with each plane of a tensor separately, using the specified execution policy
+ * With the parallel policy, the invocations for different planes run concurrently on a thread pool, starting with the
+ * planes with the most elements. See for_all_planes for details
+ * Parameters:
+ * @param policy: execution policy (nt::seq, nt::par or nt::unseq)
+ * @param invocable: invocable that's called with each plane
+ * @param tensor: Tensor object over whose planes the invocable is called
+ */
+template <execution_policy Policy, typename Invocable, typename Tensor>
+void for_each_plane(Policy&& policy, Invocable&& invocable, Tensor&& tensor) {
+  for_all_planes(std::forward<Policy>(policy), std::forward<Invocable>(invocable), std::forward<Tensor>(tensor));
+}
+
 }  // namespace ntensor
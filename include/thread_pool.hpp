@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ntensor {
+
+/*
+ * Work-stealing thread pool used by the parallel algorithms
+ * Each worker owns a task queue. Workers pop tasks from the back of their own queue (LIFO, to keep the data that was
+ * just produced in the cache), and if their queue is empty, they steal tasks from the front of the other queues (FIFO,
+ * since the oldest tasks usually represent the largest portions of work). Tasks submitted from a worker thread are
+ * pushed into that worker's queue, while tasks submitted from other threads are distributed in a round-robin manner.
+ * Threads that wait for a group of tasks to complete help executing the pending tasks instead of blocking, so nested
+ * parallel calls can't deadlock the pool.
+ */
+class ThreadPool {
+ private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> _queues;
+  std::vector<std::jthread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::atomic<std::size_t> _pending{0u};
+  std::atomic<std::size_t> _next_queue{0u};
+  bool _stop{false};
+
+  /*
+   * Returns the index of the worker queue owned by the calling thread, or the number of queues if the calling thread
+   * isn't a worker of this pool
+   */
+  [[nodiscard]] std::size_t worker_index() const noexcept {
+    return current_pool() == this ? current_worker() : _queues.size();
+  }
+
+  [[nodiscard]] static const ThreadPool*& current_pool() noexcept {
+    static thread_local const ThreadPool* pool{nullptr};
+    return pool;
+  }
+
+  [[nodiscard]] static std::size_t& current_worker() noexcept {
+    static thread_local std::size_t worker{0u};
+    return worker;
+  }
+
+  /*
+   * Pops a task from the back of the specified queue
+   * Parameters:
+   * @param idx: index of the queue
+   * @param task: object in which the popped task is stored
+   * @return: true if a task was popped, false otherwise
+   */
+  [[nodiscard]] bool pop(std::size_t idx, std::function<void()>& task) {
+    auto& queue = *_queues[idx];
+    std::scoped_lock lock{queue.mutex};
+
+    if (queue.tasks.empty()) {
+      return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    _pending.fetch_sub(1u, std::memory_order_relaxed);
+    return true;
+  }
+
+  /*
+   * Steals a task from the front of any queue other than the specified one
+   * Parameters:
+   * @param idx: index of the queue that is skipped
+   * @param task: object in which the stolen task is stored
+   * @return: true if a task was stolen, false otherwise
+   */
+  [[nodiscard]] bool steal(std::size_t idx, std::function<void()>& task) {
+    for (std::size_t i = 1u; i <= _queues.size(); ++i) {
+      auto& queue = *_queues[(idx + i) % _queues.size()];
+      std::unique_lock lock{queue.mutex, std::try_to_lock};
+
+      if (!lock.owns_lock() || queue.tasks.empty()) {
+        continue;
+      }
+
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      _pending.fetch_sub(1u, std::memory_order_relaxed);
+      return true;
+    }
+
+    return false;
+  }
+
+  /*
+   * Main loop of each worker thread
+   * Parameters:
+   * @param token: token used to request the worker to stop
+   * @param idx: index of the queue owned by the worker
+   */
+  void run(std::stop_token token, std::size_t idx) {
+    current_pool() = this;
+    current_worker() = idx;
+
+    std::function<void()> task;
+
+    while (!token.stop_requested()) {
+      if (pop(idx, task) || steal(idx, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+
+      std::unique_lock lock{_mutex};
+      _condition.wait(lock, [this] { return _stop || _pending.load(std::memory_order_relaxed) > 0u; });
+
+      if (_stop) {
+        break;
+      }
+    }
+  }
+
+ public:
+  /*
+   * Creates a thread pool with the specified number of worker threads
+   * Parameters:
+   * @param num_threads: number of worker threads. If it's equal to 0, a single worker thread is created
+   */
+  explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency()) {
+    num_threads = std::max<std::size_t>(num_threads, 1u);
+
+    _queues.reserve(num_threads);
+    for (std::size_t i = 0u; i < num_threads; ++i) {
+      _queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+
+    _workers.reserve(num_threads);
+    for (std::size_t i = 0u; i < num_threads; ++i) {
+      _workers.emplace_back([this, i](std::stop_token token) { run(token, i); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /*
+   * Stops all worker threads. Tasks that weren't started are discarded
+   */
+  ~ThreadPool() {
+    {
+      std::scoped_lock lock{_mutex};
+      _stop = true;
+    }
+
+    for (auto& worker : _workers) {
+      worker.request_stop();
+    }
+
+    _condition.notify_all();
+    _workers.clear();
+  }
+
+  /*
+   * Returns the number of worker threads
+   * Parameters:
+   * @return: number of worker threads
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return _workers.size(); }
+
+  /*
+   * Schedules a task for execution
+   * Parameters:
+   * @param task: invocable that's executed by one of the worker threads
+   */
+  void submit(std::function<void()> task) {
+    std::size_t idx = worker_index();
+
+    if (idx == _queues.size()) {
+      idx = _next_queue.fetch_add(1u, std::memory_order_relaxed) % _queues.size();
+    }
+
+    {
+      auto& queue = *_queues[idx];
+      std::scoped_lock lock{queue.mutex};
+      queue.tasks.emplace_back(std::move(task));
+      _pending.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    {
+      // Taking the lock prevents the notification from being lost between the predicate check and the wait
+      std::scoped_lock lock{_mutex};
+    }
+    _condition.notify_one();
+  }
+
+  /*
+   * Executes one pending task on the calling thread, if there is any
+   * Parameters:
+   * @return: true if a task was executed, false otherwise
+   */
+  bool try_run_pending_task() {
+    const std::size_t idx = worker_index();
+    std::function<void()> task;
+
+    if ((idx < _queues.size() && pop(idx, task)) || steal(idx % _queues.size(), task)) {
+      task();
+      return true;
+    }
+
+    return false;
+  }
+
+  /*
+   * Splits the range [first, last) into chunks of the specified size, and calls the invocable with each chunk in
+   * parallel. The calling thread participates in the execution, and the method returns once all chunks are processed.
+   * If any invocation throws, the first exception is rethrown after all chunks are processed
+   * Parameters:
+   * @param first: beginning of the range
+   * @param last: end of the range (excluded)
+   * @param grain: number of elements in each chunk (the last chunk can be smaller)
+   * @param invocable: invocable called with the beginning and the end of each chunk
+   */
+  template <typename Invocable>
+    requires std::invocable<Invocable&, std::size_t, std::size_t>
+  void parallel_for(std::size_t first, std::size_t last, std::size_t grain, Invocable&& invocable) {
+    if (first >= last) {
+      return;
+    }
+
+    grain = std::max<std::size_t>(grain, 1u);
+    const std::size_t num_chunks = (last - first + grain - 1u) / grain;
+
+    if (num_chunks == 1u) {
+      invocable(first, last);
+      return;
+    }
+
+    std::atomic<std::size_t> remaining{num_chunks};
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    auto run_chunk = [&](std::size_t chunk) {
+      const std::size_t begin = first + chunk * grain;
+      const std::size_t end = std::min(begin + grain, last);
+
+      try {
+        invocable(begin, end);
+      } catch (...) {
+        std::scoped_lock lock{exception_mutex};
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+
+      remaining.fetch_sub(1u, std::memory_order_acq_rel);
+    };
+
+    for (std::size_t chunk = 1u; chunk < num_chunks; ++chunk) {
+      submit([&run_chunk, chunk] { run_chunk(chunk); });
+    }
+
+    run_chunk(0u);
+
+    while (remaining.load(std::memory_order_acquire) > 0u) {
+      if (!try_run_pending_task()) {
+        std::this_thread::yield();
+      }
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+};
+
+/*
+ * Returns the thread pool used by the parallel algorithms when no other pool is specified
+ * The pool is lazily created on first use, with one worker thread per hardware thread
+ * Parameters:
+ * @return: reference to the default thread pool
+ */
+[[nodiscard]] inline ThreadPool& default_thread_pool() {
+  static ThreadPool pool{};
+  return pool;
+}
+
+}  // namespace ntensor
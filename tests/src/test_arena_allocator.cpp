@@ -0,0 +1,228 @@
+#include <arena_allocator.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <memory>
+#include <plane.hpp>
+#include <reshape.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+#include <vector>
+
+namespace nt = ntensor;
+
+namespace {
+
+[[nodiscard]] bool is_aligned(const void* p) { return !(reinterpret_cast<std::uintptr_t>(p) % NT_ALIGNMENT); }
+
+/*
+ * Free-list arena counting the number of live allocations
+ */
+struct counting_arena {
+  nt::FreeListArena<> arena;
+  std::size_t live{};
+
+  [[nodiscard]] void* allocate(std::size_t bytes) {
+    ++live;
+    return arena.allocate(bytes);
+  }
+
+  void deallocate(void* memory, std::size_t bytes) noexcept {
+    --live;
+    arena.deallocate(memory, bytes);
+  }
+};
+
+template <typename T>
+using counting_allocator = nt::ArenaAllocator<T, counting_arena>;
+
+}  // namespace
+
+TEST_CASE("LinearArena class tests") {
+  nt::LinearArena<> arena{1024u};
+
+  SECTION("allocations are aligned and don't overlap") {
+    void* first = arena.allocate(3u);
+    void* second = arena.allocate(100u);
+    void* third = arena.allocate(2000u);
+    CHECK(is_aligned(first));
+    CHECK(is_aligned(second));
+    CHECK(is_aligned(third));
+    CHECK(static_cast<std::byte*>(second) - static_cast<std::byte*>(first) >= 3);
+    CHECK((static_cast<std::byte*>(second) + 100 <= static_cast<std::byte*>(third) ||
+           static_cast<std::byte*>(third) + 2000 <= static_cast<std::byte*>(second)));
+    arena.deallocate(third, 2000u);
+    arena.deallocate(second, 100u);
+    arena.deallocate(first, 3u);
+  }
+
+  SECTION("the most recent allocation is reclaimed") {
+    void* first = arena.allocate(64u);
+    arena.deallocate(first, 64u);
+    void* second = arena.allocate(64u);
+    CHECK(first == second);
+    arena.deallocate(second, 64u);
+  }
+
+  SECTION("reset reuses the blocks") {
+    std::vector<void*> first_round;
+    for (std::size_t i = 0u; i < 20u; ++i) {
+      first_round.push_back(arena.allocate(200u));
+    }
+    for (void* p : first_round) {
+      arena.deallocate(p, 200u);
+    }
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+
+    std::vector<void*> second_round;
+    for (std::size_t i = 0u; i < 20u; ++i) {
+      second_round.push_back(arena.allocate(200u));
+    }
+    CHECK(second_round == first_round);
+    CHECK(arena.capacity() == capacity);
+    for (void* p : second_round) {
+      arena.deallocate(p, 200u);
+    }
+  }
+}
+
+TEST_CASE("FreeListArena class tests") {
+  nt::FreeListArena<> arena;
+
+  SECTION("freed blocks are reused by allocations of the same size class") {
+    void* first = arena.allocate(1000u);
+    void* second = arena.allocate(1000u);
+    CHECK(is_aligned(first));
+    CHECK(is_aligned(second));
+    CHECK(first != second);
+
+    arena.deallocate(first, 1000u);
+    void* third = arena.allocate(900u);
+    CHECK(third == first);
+
+    arena.deallocate(second, 1000u);
+    void* fourth = arena.allocate(5000u);
+    CHECK(fourth != second);
+
+    arena.deallocate(third, 900u);
+    arena.deallocate(fourth, 5000u);
+  }
+
+  SECTION("trim releases the free blocks") {
+    void* first = arena.allocate(256u);
+    arena.deallocate(first, 256u);
+    arena.trim();
+    void* second = arena.allocate(256u);
+    CHECK(is_aligned(second));
+    arena.deallocate(second, 256u);
+  }
+}
+
+TEST_CASE("ArenaAllocator class tests") {
+  nt::LinearArena<> first_arena;
+  nt::LinearArena<> second_arena;
+
+  SECTION("equality operator") {
+    CHECK(nt::LinearAllocator<int>{first_arena} == nt::LinearAllocator<float>{first_arena});
+    CHECK(nt::LinearAllocator<int>{first_arena} != nt::LinearAllocator<int>{second_arena});
+    CHECK(nt::LinearAllocator<int>{first_arena} == nt::LinearAllocator<int>{nt::LinearAllocator<char>{first_arena}});
+    CHECK(nt::LinearAllocator<int>{} != nt::LinearAllocator<int>{first_arena});
+  }
+
+  SECTION("scopes select the arena of default-constructed allocators") {
+    CHECK(!nt::LinearAllocator<int>{}.arena());
+    {
+      nt::ArenaScope first_scope{first_arena};
+      CHECK(nt::LinearAllocator<int>{}.arena() == &first_arena);
+      {
+        nt::ArenaScope second_scope{second_arena};
+        CHECK(nt::LinearAllocator<int>{}.arena() == &second_arena);
+      }
+      CHECK(nt::LinearAllocator<int>{}.arena() == &first_arena);
+    }
+    CHECK(!nt::LinearAllocator<int>{}.arena());
+  }
+
+  SECTION("allocators without an arena use aligned allocations") {
+    nt::FreeListAllocator<double> allocator;
+    double* p = allocator.allocate(10u);
+    REQUIRE(p);
+    CHECK(is_aligned(p));
+    allocator.deallocate(p, 10u);
+  }
+
+  SECTION("standard containers") {
+    std::vector<int, nt::LinearAllocator<int>> v{nt::LinearAllocator<int>{first_arena}};
+    for (int i = 0; i < 1000; ++i) {
+      v.push_back(i);
+    }
+    CHECK(v.get_allocator().arena() == &first_arena);
+    CHECK(v[999] == 999);
+    CHECK(first_arena.capacity() > 0u);
+  }
+}
+
+TEST_CASE("DenseBuffer with arena allocators") {
+  static constexpr nt::Dimensions<30u, 32u> dimensions;
+  static constexpr nt::Dimensions<32u, 30u> reshaped_dimensions;
+
+  nt::FreeListArena<> arena;
+
+  SECTION("buffers created in a scope use the arena") {
+    using buffer_type = nt::DenseBuffer<float, nt::FreeListAllocator<float>>;
+    void* first_memory = nullptr;
+    {
+      nt::ArenaScope scope{arena};
+      buffer_type buffer(100u);
+      CHECK(buffer.get_allocator().arena() == &arena);
+      CHECK(is_aligned(buffer.data()));
+      first_memory = buffer.data();
+    }
+
+    // The allocator is stored in the buffer, so the memory is returned to the arena after the scope has ended
+    buffer_type buffer(std::allocator_arg, nt::FreeListAllocator<float>{arena}, 100u);
+    CHECK(static_cast<void*>(buffer.data()) == first_memory);
+  }
+
+  SECTION("reshape allocates the temporary plane from the arena") {
+    using buffer_type = nt::DenseBuffer<float, counting_allocator<float>>;
+    counting_arena counting;
+    {
+      nt::ArenaScope scope{counting};
+
+      auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<buffer_type, dimensions>());
+      nt::execute(
+          [](float& v) {
+            static int i = 0;
+            v = static_cast<float>(i++);
+          },
+          tensor);
+      CHECK(counting.live == 1u);
+
+      // The rows of the plane are padded, so reshape has to allocate a new plane
+      auto reshaped_tensor = nt::reshape<reshaped_dimensions>(tensor);
+      CHECK(counting.live == 2u);
+      for (unsigned j = 0u; j < 30u; ++j) {
+        for (unsigned i = 0u; i < 32u; ++i) {
+          const unsigned flat = j * 32u + i;
+          CHECK(reshaped_tensor.slicing_value(0u, i, j) == tensor.slicing_value(0u, flat % 30u, flat / 30u));
+        }
+      }
+    }
+    CHECK(!counting.live);
+  }
+
+  SECTION("planes created with an explicit allocator") {
+    using buffer_type = nt::DenseBuffer<int, counting_allocator<int>>;
+    counting_arena counting;
+    {
+      auto plane = nt::create_plane<buffer_type, dimensions>(std::allocator_arg, counting_allocator<int>{counting});
+      CHECK(counting.live == 1u);
+      auto copy = plane;
+      CHECK(counting.live == 1u);
+    }
+    CHECK(!counting.live);
+  }
+}
@@ -0,0 +1,192 @@
+#include <async.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <optional>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <stdexcept>
+#include <string>
+#include <tensor.hpp>
+#include <thread_pool.hpp>
+#include <vector>
+
+namespace nt = ntensor;
+
+namespace {
+
+/*
+ * Executor which runs the submitted tasks on the calling thread, once run is called
+ */
+struct ManualExecutor {
+  std::vector<std::function<void()>> tasks;
+
+  void submit(std::function<void()> task) { tasks.emplace_back(std::move(task)); }
+
+  void run() {
+    while (!tasks.empty()) {
+      auto task = std::move(tasks.front());
+      tasks.erase(tasks.begin());
+      task();
+    }
+  }
+};
+
+static_assert(nt::executor<nt::ThreadPool>);
+static_assert(nt::executor<ManualExecutor>);
+static_assert(!nt::executor<int>);
+
+}  // namespace
+
+TEST_CASE("async method tests") {
+  SECTION("result of the invocable") {
+    nt::ThreadPool pool{2u};
+    auto future = nt::async(pool, [](int a, const std::string& b) { return b + std::to_string(a); }, 42, "answer ");
+    CHECK(future.get() == "answer 42");
+  }
+
+  SECTION("exceptions are stored in the future") {
+    nt::ThreadPool pool{2u};
+    auto future = nt::async(pool, [] { throw std::runtime_error("failure"); });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
+  SECTION("waiting on a worker thread") {
+    // The outer task waits for the inner task on the only worker thread, by running it itself
+    nt::ThreadPool pool{1u};
+    auto outer = nt::async(pool, [&pool] {
+      auto inner = nt::async(pool, [] { return 21; });
+      return 2 * nt::await_future(pool, inner);
+    });
+    CHECK(nt::await_future(pool, outer) == 42);
+  }
+}
+
+TEST_CASE("async_execute method tests") {
+  nt::ThreadPool pool{2u};
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+      nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<30, 20>{}>());
+
+  SECTION("without an execution policy") {
+    auto future = nt::async_execute(pool, [](int& v) { v = 3; }, tensor);
+    future.get();
+  }
+
+  SECTION("with an execution policy") {
+    auto future = nt::async_execute(pool, nt::par.on(pool), [](int& v) { v = 3; }, tensor);
+    nt::await_future(pool, future);
+  }
+
+  // The task shares the buffer of the tensor
+  int sum = 0;
+  nt::execute([&sum](int v) { sum += v; }, tensor);
+  CHECK(sum == 3 * 30 * 20);
+}
+
+TEST_CASE("run_pipeline method tests") {
+  SECTION("load, transform and write planes in order") {
+    nt::ThreadPool pool{3u};
+    static constexpr int count = 50;
+
+    int next = 0;
+    std::vector<int> written;
+    auto future = nt::run_pipeline(
+        pool, 2u,
+        [&next]() -> std::optional<int> {
+          if (next == count) return std::nullopt;
+          return next++;
+        },
+        [](int seed) {
+          auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+              nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<8, 4>{}>());
+          nt::execute([seed](int& v) { v = seed; }, tensor);
+          return tensor;
+        },
+        [](auto tensor) {
+          int sum = 0;
+          nt::execute([&sum](int v) { sum += v; }, tensor);
+          return sum;
+        },
+        [&written](int sum) { written.emplace_back(sum); });
+    future.get();
+
+    REQUIRE(written.size() == count);
+    for (int i = 0; i < count; ++i) {
+      CHECK(written[i] == i * 32);
+    }
+  }
+
+  SECTION("back-pressure bounds the values waiting between the stages") {
+    ManualExecutor executor;
+    static constexpr std::size_t capacity = 3u;
+
+    int produced = 0;
+    int consumed = 0;
+    int max_waiting = 0;
+    auto future = nt::run_pipeline(
+        executor, capacity,
+        [&produced, &consumed, &max_waiting]() -> std::optional<int> {
+          if (produced == 100) return std::nullopt;
+          max_waiting = std::max(max_waiting, produced - consumed);
+          return produced++;
+        },
+        [](int value) { return value; },
+        [&consumed](int) { ++consumed; });
+    executor.run();
+    future.get();
+
+    CHECK(consumed == 100);
+    // At most capacity values wait in each queue, and one value is held by the running stage
+    CHECK(max_waiting <= static_cast<int>(2u * capacity + 1u));
+  }
+
+  SECTION("a single worker thread runs all stages") {
+    nt::ThreadPool pool{1u};
+
+    int next = 0;
+    int sum = 0;
+    auto future = nt::run_pipeline(
+        pool, 1u,
+        [&next]() -> std::optional<int> {
+          if (next == 10) return std::nullopt;
+          return next++;
+        },
+        [&sum](int value) { sum += value; });
+    future.get();
+
+    CHECK(sum == 45);
+  }
+
+  SECTION("an empty source") {
+    nt::ThreadPool pool{2u};
+    bool called = false;
+    auto future = nt::run_pipeline(
+        pool, 1u, []() -> std::optional<int> { return std::nullopt; }, [&called](int) { called = true; });
+    future.get();
+
+    CHECK(!called);
+  }
+
+  SECTION("exceptions stop the pipeline") {
+    nt::ThreadPool pool{2u};
+
+    int next = 0;
+    std::atomic<int> consumed{0};
+    auto future = nt::run_pipeline(
+        pool, 1u,
+        [&next]() -> std::optional<int> {
+          if (next == 1000) return std::nullopt;
+          return next++;
+        },
+        [](int value) {
+          if (value == 5) throw std::runtime_error("failure");
+          return value;
+        },
+        [&consumed](int) { ++consumed; });
+
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+    CHECK(consumed <= 5);
+    CHECK(next < 1000);
+  }
+}
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <binary_io.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <filesystem>
+#include <fstream>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sstream>
+#include <streambuf>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+namespace {
+
+/*
+ * Removes the file when it goes out of scope
+ */
+struct temporary_file {
+  std::filesystem::path path;
+
+  explicit temporary_file(const char* name) : path{std::filesystem::temp_directory_path() / name} {}
+  ~temporary_file() { std::filesystem::remove(path); }
+};
+
+/*
+ * Stream buffer accepting a limited number of bytes, after which each write fails
+ */
+class limited_buffer : public std::streambuf {
+ private:
+  std::size_t _capacity;
+
+ protected:
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    const auto written = std::min(count, static_cast<std::streamsize>(_capacity));
+    _capacity -= static_cast<std::size_t>(written);
+    return written;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (!_capacity || traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::eof();
+    --_capacity;
+    return ch;
+  }
+
+ public:
+  explicit limited_buffer(std::size_t capacity) : _capacity{capacity} {}
+};
+
+}  // namespace
+
+TEST_CASE("binary_io tests") {
+  static constexpr nt::Dimensions<37u, 5u, 3u> first_dimensions;
+  static constexpr nt::Dimensions<7u, 4u> second_dimensions;
+
+  auto first_plane = nt::create_plane<nt::DenseBuffer<float>, first_dimensions>();
+  auto second_plane = nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>();
+  auto out_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane, second_plane);
+
+  auto fill_float = [](float& v) {
+    static int i = 0;
+    v = static_cast<float>(i++) * 0.5f;
+  };
+  auto fill_int = [](std::int16_t& v) {
+    static int i = 0;
+    v = static_cast<std::int16_t>(i++ - 40);
+  };
+  nt::execute(fill_float, nt::create_tensor<nt::ShapeTransmutation>(first_plane));
+  nt::execute(fill_int, nt::create_tensor<nt::ShapeTransmutation>(second_plane));
+
+  auto check = [&out_tensor](auto& in_tensor) {
+    for (unsigned k = 0u; k < 3u; ++k) {
+      for (unsigned j = 0u; j < 5u; ++j) {
+        for (unsigned i = 0u; i < 37u; ++i) {
+          CHECK(in_tensor.slicing_value(0u, i, j, k) == out_tensor.slicing_value(0u, i, j, k));
+        }
+      }
+    }
+
+    for (unsigned j = 0u; j < 4u; ++j) {
+      for (unsigned i = 0u; i < 7u; ++i) {
+        for (unsigned c = 0u; c < 3u; ++c) {
+          CHECK(in_tensor.template slicing_value<1u>(c, i, j) == out_tensor.template slicing_value<1u>(c, i, j));
+        }
+      }
+    }
+  };
+
+  SECTION("write to a stream and load from it") {
+    std::stringstream ss;
+    nt::write_binary(out_tensor, ss);
+
+    auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, first_dimensions>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>());
+    nt::load_binary(in_tensor, ss);
+    check(in_tensor);
+  }
+
+  SECTION("planes without the payload layout are gathered and scattered") {
+    // Unaligned strides, and a plane viewing a part of a larger buffer
+    auto unaligned_plane = nt::create_plane<nt::DenseBuffer<float>, first_dimensions, 1u, false>();
+    auto larger_plane = nt::create_plane<nt::DenseBuffer<std::int16_t>, nt::Dimensions<7u, 5u>{}, 3u>();
+    auto offset_plane = larger_plane.template like<second_dimensions, decltype(larger_plane)::strides()>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(unaligned_plane, offset_plane);
+    nt::execute([](auto& dst, const auto& src) { dst = src; }, tensor, out_tensor);
+
+    std::stringstream unaligned_ss;
+    nt::write_binary(tensor, unaligned_ss);
+
+    auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, first_dimensions, 1u, false>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>());
+    nt::load_binary(in_tensor, unaligned_ss);
+    check(in_tensor);
+  }
+
+  SECTION("map a file") {
+    temporary_file file{"ntensor_test_binary_io.bin"};
+    {
+      std::ofstream stream{file.path, std::ios::binary};
+      nt::write_binary(out_tensor, stream);
+    }
+
+    auto mapped_tensor = nt::map_binary<decltype(out_tensor)>(file.path);
+    check(mapped_tensor);
+
+    const auto mapped_plane = mapped_tensor.planes().template plane<0u>();
+    CHECK(!(reinterpret_cast<std::uintptr_t>(&mapped_plane[0u]) % NT_ALIGNMENT));
+
+    float sum = 0.0f, expected_sum = 0.0f;
+    auto mapped_first = nt::create_tensor<nt::ShapeTransmutation>(mapped_plane);
+    nt::execute(nt::unseq, [&sum](const float& v) { sum += v; }, mapped_first);
+    nt::execute([&expected_sum](const float& v) { expected_sum += v; },
+                nt::create_tensor<nt::ShapeTransmutation>(first_plane));
+    CHECK(sum == expected_sum);
+
+    // Copy-on-write mappings can be modified without changing the file
+    auto private_tensor = nt::map_binary<decltype(out_tensor), nt::mapping_mode::copy_on_write>(file.path);
+    nt::execute(nt::unseq, nt::vectorized([](auto& v) { v = v * 2.0f; }),
+                nt::create_tensor<nt::ShapeTransmutation>(private_tensor.planes().template plane<0u>()));
+    CHECK(private_tensor.slicing_value(0u, 3u, 1u, 2u) == out_tensor.slicing_value(0u, 3u, 1u, 2u) * 2.0f);
+    check(mapped_tensor);
+  }
+
+  SECTION("mismatching tensors are rejected") {
+    std::stringstream ss;
+    nt::write_binary(out_tensor, ss);
+    const auto data = ss.str();
+
+    auto other_dimensions = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, first_dimensions>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 2u>());
+    std::stringstream first_ss{data};
+    CHECK_THROWS_AS(nt::load_binary(other_dimensions, first_ss), std::runtime_error);
+
+    auto other_type = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, first_dimensions>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>());
+    std::stringstream second_ss{data};
+    CHECK_THROWS_AS(nt::load_binary(other_type, second_ss), std::runtime_error);
+
+    auto fewer_planes =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, first_dimensions>());
+    std::stringstream third_ss{data};
+    CHECK_THROWS_AS(nt::load_binary(fewer_planes, third_ss), std::runtime_error);
+
+    std::stringstream truncated_ss{data.substr(0u, data.size() / 2u)};
+    auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, first_dimensions>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>());
+    CHECK_THROWS_AS(nt::load_binary(in_tensor, truncated_ss), std::runtime_error);
+
+    std::stringstream text_ss{"{\n[1,2,3]\n}"};
+    CHECK_THROWS_AS(nt::load_binary(in_tensor, text_ss), std::runtime_error);
+
+    CHECK_THROWS_AS(nt::map_binary<decltype(in_tensor)>("/nonexistent/ntensor.bin"), std::system_error);
+  }
+
+  SECTION("failed writes are reported") {
+    std::stringstream ss;
+    nt::write_binary(out_tensor, ss);
+    const std::size_t size = ss.str().size();
+
+    // The stream fails while writing the header, the plane descriptors and the last payload
+    for (const std::size_t capacity : {std::size_t{0u}, std::size_t{40u}, size - 1u}) {
+      limited_buffer buffer{capacity};
+      std::ostream sink{&buffer};
+      CHECK_THROWS_AS(nt::write_binary(out_tensor, sink), std::runtime_error);
+    }
+
+    limited_buffer buffer{size};
+    std::ostream sink{&buffer};
+    CHECK_NOTHROW(nt::write_binary(out_tensor, sink));
+  }
+
+  SECTION("corrupt counts are rejected before allocating the records") {
+    std::stringstream ss;
+    nt::write_binary(out_tensor, ss);
+    const auto data = ss.str();
+
+    // The number of planes is stored at the offset 20 of the header, and the rank of the first plane at the offset 8
+    // of its descriptor, which follows the 32 bytes of the header
+    auto corrupt = [&data](std::size_t offset) {
+      auto corrupt_data = data;
+      const std::uint32_t count = 0xffffffffu;
+      std::memcpy(corrupt_data.data() + offset, &count, sizeof(count));
+      return corrupt_data;
+    };
+
+    auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, first_dimensions>(),
+        nt::create_plane<nt::DenseBuffer<std::int16_t>, second_dimensions, 3u>());
+    for (const std::size_t offset : {20u, 40u}) {
+      std::stringstream corrupt_ss{corrupt(offset)};
+      CHECK_THROWS_AS(nt::load_binary(in_tensor, corrupt_ss), std::runtime_error);
+
+      temporary_file file{"ntensor_test_binary_io_corrupt.bin"};
+      {
+        std::ofstream stream{file.path, std::ios::binary};
+        stream << corrupt(offset);
+      }
+      CHECK_THROWS_AS(nt::map_binary<decltype(in_tensor)>(file.path), std::runtime_error);
+    }
+  }
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include <contraction.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+namespace {
+
+/*
+ * Fills a tensor with small integers, so that the products are computed exactly with floating point values as well
+ */
+template <typename Tensor>
+void fill(Tensor& tensor, int seed) {
+  int value = seed;
+  nt::execute([&value](auto& v) { v = static_cast<std::decay_t<decltype(v)>>((value = (value * 7 + 3) % 11) - 5); },
+              tensor);
+}
+
+/*
+ * Multiplies the first planes of two tensors as matrices, one element at a time
+ */
+template <typename Result, typename Lhs, typename Rhs>
+void check_product(Result& result, Lhs& lhs, Rhs& rhs, std::size_t M, std::size_t K, std::size_t N,
+                   std::size_t channels = 1u) {
+  for (std::size_t c = 0u; c < channels; ++c) {
+    for (std::size_t m = 0u; m < M; ++m) {
+      for (std::size_t n = 0u; n < N; ++n) {
+        std::decay_t<decltype(result.slicing_value(c, n, m))> expected{};
+        for (std::size_t k = 0u; k < K; ++k) {
+          expected += lhs.slicing_value(c, k, m) * rhs.slicing_value(c, n, k);
+        }
+        CHECK(result.slicing_value(c, n, m) == expected);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("matmul method tests") {
+  SECTION("small matrices") {
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<3, 2>{}>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<2, 3>{}>());
+
+    // [[1, 2, 3], [4, 5, 6]] * [[7, 8], [9, 10], [11, 12]]
+    int value = 1;
+    nt::execute([&value](int& v) { v = value++; }, lhs);
+    nt::execute([&value](int& v) { v = value++; }, rhs);
+
+    auto result = nt::matmul(lhs, rhs);
+    using result_plane_type = std::decay_t<decltype(result.planes().template plane<0u>())>;
+    static_assert(std::is_same_v<std::decay_t<decltype(result_plane_type::dimensions())>, nt::Dimensions<2, 2>>);
+    static_assert(std::is_same_v<result_plane_type::value_type, int>);
+
+    CHECK(result.slicing_value(0u, 0u, 0u) == 58);
+    CHECK(result.slicing_value(0u, 1u, 0u) == 64);
+    CHECK(result.slicing_value(0u, 0u, 1u) == 139);
+    CHECK(result.slicing_value(0u, 1u, 1u) == 154);
+  }
+
+  SECTION("sizes that aren't multiples of the blocks") {
+    // The contracted dimension is longer than a packed block, and the rows are split into several blocks
+    static constexpr std::size_t M = 150u;
+    static constexpr std::size_t K = 301u;
+    static constexpr std::size_t N = 37u;
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<K, M>{}>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<N, K>{}>());
+    fill(lhs, 1);
+    fill(rhs, 2);
+
+    auto result = nt::matmul(lhs, rhs);
+    check_product(result, lhs, rhs, M, K, N);
+
+    auto parallel_result = nt::matmul(nt::par, lhs, rhs);
+    check_product(parallel_result, lhs, rhs, M, K, N);
+  }
+
+  SECTION("permuted and unaligned planes") {
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<double>, nt::Dimensions<19, 13>{}, 1u, false>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<double>, nt::Dimensions<19, 11>{}>());
+    fill(lhs, 3);
+    fill(rhs, 4);
+
+    // The transposed right-hand side has the dimensions [11, 19], it isn't copied before the multiplication
+    auto transposed = rhs.template permute<0u, 1u, 0u>();
+    auto result = nt::matmul(nt::unseq, lhs, transposed);
+    check_product(result, lhs, transposed, 13u, 19u, 11u);
+  }
+
+  SECTION("planes with several channels, tensors with several planes") {
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<5, 6>{}, 3u>(),
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<2, 9>{}>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<7, 5>{}, 3u>(),
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4, 2>{}>());
+    fill(lhs, 5);
+    fill(rhs, 6);
+
+    auto result = nt::matmul(lhs, rhs);
+    check_product(result, lhs, rhs, 6u, 5u, 7u, 3u);
+
+    for (std::size_t m = 0u; m < 9u; ++m) {
+      for (std::size_t n = 0u; n < 4u; ++n) {
+        int expected = 0;
+        for (std::size_t k = 0u; k < 2u; ++k) {
+          expected += lhs.template slicing_value<1u>(0u, k, m) * rhs.template slicing_value<1u>(0u, n, k);
+        }
+        CHECK(result.template slicing_value<1u>(0u, n, m) == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("tensordot method tests") {
+  SECTION("two contracted axes") {
+    // lhs[a][b][c] (dimensions [c, b, a]) contracted with rhs[b][d][c] (dimensions [c, d, b]) over b and c
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4, 3, 5>{}>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4, 6, 3>{}>());
+    fill(lhs, 7);
+    fill(rhs, 8);
+
+    auto result = nt::tensordot<0u, 0u, 1u, 2u>(nt::par, lhs, rhs);
+    using result_plane_type = std::decay_t<decltype(result.planes().template plane<0u>())>;
+    static_assert(std::is_same_v<std::decay_t<decltype(result_plane_type::dimensions())>, nt::Dimensions<6, 5>>);
+
+    for (std::size_t a = 0u; a < 5u; ++a) {
+      for (std::size_t d = 0u; d < 6u; ++d) {
+        int expected = 0;
+        for (std::size_t b = 0u; b < 3u; ++b) {
+          for (std::size_t c = 0u; c < 4u; ++c) {
+            expected += lhs.slicing_value(0u, c, b, a) * rhs.slicing_value(0u, c, d, b);
+          }
+        }
+        CHECK(result.slicing_value(0u, d, a) == expected);
+      }
+    }
+  }
+
+  SECTION("outer product") {
+    auto lhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<3>{}>());
+    auto rhs = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4, 2>{}>());
+    fill(lhs, 9);
+    fill(rhs, 10);
+
+    auto result = nt::tensordot(lhs, rhs);
+    using result_plane_type = std::decay_t<decltype(result.planes().template plane<0u>())>;
+    static_assert(std::is_same_v<std::decay_t<decltype(result_plane_type::dimensions())>, nt::Dimensions<4, 2, 3>>);
+    static_assert(std::is_same_v<result_plane_type::value_type, float>);
+
+    for (std::size_t i = 0u; i < 3u; ++i) {
+      for (std::size_t j = 0u; j < 2u; ++j) {
+        for (std::size_t k = 0u; k < 4u; ++k) {
+          CHECK(result.slicing_value(0u, k, j, i) == lhs.slicing_value(0u, i) * rhs.slicing_value(0u, k, j));
+        }
+      }
+    }
+  }
+}
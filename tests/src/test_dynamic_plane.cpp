@@ -0,0 +1,237 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <dynamic_plane.hpp>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <reshape.hpp>
+#include <shape_transmutation.hpp>
+#include <sstream>
+#include <stream_io.hpp>
+#include <tensor.hpp>
+#include <thread_pool.hpp>
+
+namespace nt = ntensor;
+
+TEST_CASE("DynamicPlane class tests") {
+  SECTION("create_dynamic_plane method") {
+    {
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>>({2u, 4u, 6u});
+      using plane_type = std::decay_t<decltype(plane)>;
+
+      static_assert(std::is_same_v<plane_type::buffer_type, nt::DenseBuffer<int>>);
+      static_assert(std::is_same_v<plane_type::reference, nt::DenseBuffer<int>::reference>);
+      static_assert(std::is_same_v<plane_type::value_type, nt::DenseBuffer<int>::value_type>);
+      static_assert(plane_type::channels() == 1u);
+      static_assert(plane_type::rank() == 3u);
+      static_assert(plane_type::extents_type::rank_dynamic() == 3u);
+
+      // The same strides as the ones of a plane whose dimensions are known at compile time
+      auto static_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<2u, 4u, 6u>{}>();
+      CHECK(plane.dimensions() == std::array<std::size_t, 3u>{2u, 4u, 6u});
+      CHECK(plane.strides() == nt::plane_strides(static_plane));
+      CHECK(plane.template extent<2u>() == 6u);
+      CHECK(plane.template stride<1u>() == static_plane.strides().template at<1u>());
+      CHECK(plane.real_size() == static_plane.real_size());
+      CHECK(plane.offset() == 0);
+    }
+
+    {
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<float>, nt::DynamicExtents<2u>, 3u, false>({5u, 7u});
+      CHECK(plane.strides() == std::array<long long, 2u>{1, 5});
+      CHECK(plane.real_size() == 105u);
+    }
+
+    {
+      // Mixed static and dynamic extents
+      using extents_type = nt::Extents<nt::dynamic_extent, 4u>;
+      static_assert(extents_type::rank() == 2u);
+      static_assert(extents_type::rank_dynamic() == 1u);
+      static_assert(extents_type::static_extent<0u>() == nt::dynamic_extent);
+      static_assert(extents_type::static_extent<1u>() == 4u);
+
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, extents_type>({9u, 4u});
+      CHECK(plane.template extent<0u>() == 9u);
+      CHECK(plane.template extent<1u>() == 4u);
+    }
+  }
+
+  SECTION("to_dynamic_plane method") {
+    static constexpr nt::Dimensions<3u, 5u> dimensions;
+    auto static_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 2u>(4);
+    auto plane = nt::to_dynamic_plane(static_plane);
+
+    CHECK(plane.dimensions() == std::array<std::size_t, 2u>{3u, 5u});
+    CHECK(plane.strides() == nt::plane_strides(static_plane));
+    CHECK(plane.offset() == 4);
+    CHECK(plane.buffer() == static_plane.buffer());
+  }
+
+  SECTION("execute") {
+    const std::array<std::size_t, 3u> dimensions{5u, 3u, 4u};
+    auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>, 2u>(dimensions);
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, tensor);
+    CHECK(value == 120);
+
+    // The elements are iterated in the same order as the elements of a Plane with the same dimensions
+    auto static_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<5u, 3u, 4u>{}, 2u>();
+    auto static_tensor = nt::create_tensor<nt::ShapeTransmutation>(static_plane);
+    value = 0;
+    nt::execute([&value](int& v) { v = value++; }, static_tensor);
+
+    bool equal = true;
+    nt::execute([&equal](int l, int r) { equal &= l == r; }, tensor, static_tensor);
+    CHECK(equal);
+    CHECK(tensor.slicing_value(1u, 4u, 2u, 3u) == static_tensor.slicing_value(1u, 4u, 2u, 3u));
+    CHECK(tensor.slicing_value(0u, 4u, 2u, 3u) == 2 * (4 + 2 * 5 + 3 * 15));
+
+    // Planes with different dimensions, but the same number of elements
+    auto other_plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<2u>, 2u>({15u, 4u});
+    auto other_tensor = nt::create_tensor<nt::ShapeTransmutation>(other_plane);
+    nt::execute([](int& l, int r) { l = r; }, other_tensor, tensor);
+    CHECK(other_tensor.slicing_value(1u, 14u, 3u) == tensor.slicing_value(1u, 4u, 2u, 3u));
+
+    nt::ThreadPool pool{3u};
+    nt::execute(nt::par.on(pool), [](int& v) { v *= 2; }, tensor);
+    CHECK(tensor.slicing_value(1u, 4u, 2u, 3u) == 2 * static_tensor.slicing_value(1u, 4u, 2u, 3u));
+  }
+
+  SECTION("slice") {
+    auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::Extents<nt::dynamic_extent, 3u, 4u>>({5u, 3u, 4u});
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, tensor);
+
+    auto sliced_tensor = tensor.template slice<1u>(2u);
+    auto& sliced_plane = sliced_tensor.planes().template plane<0u>();
+    using sliced_plane_type = std::decay_t<decltype(sliced_plane)>;
+    static_assert(std::is_same_v<sliced_plane_type::extents_type, nt::Extents<nt::dynamic_extent, 4u>>);
+
+    CHECK(sliced_plane.dimensions() == std::array<std::size_t, 2u>{5u, 4u});
+    CHECK(sliced_tensor.slicing_value(0u, 3u, 1u) == tensor.slicing_value(0u, 3u, 2u, 1u));
+  }
+
+  SECTION("reshape") {
+    {
+      // Unaligned planes share their buffer with the reshaped plane
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<2u>, 1u, false>({6u, 4u});
+      auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+      int value = 0;
+      nt::execute([&value](int& v) { v = value++; }, tensor);
+
+      auto reshaped_tensor = nt::reshape(tensor, std::array<std::size_t, 3u>{3u, 2u, 4u});
+      auto& reshaped_plane = reshaped_tensor.planes().template plane<0u>();
+      CHECK(reshaped_plane.buffer() == plane.buffer());
+      CHECK(reshaped_tensor.slicing_value(0u, 2u, 1u, 3u) == 23);
+    }
+
+    {
+      // Aligned planes are copied
+      auto static_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<6u, 4u>{}>();
+      auto tensor = nt::create_tensor<nt::ShapeTransmutation>(static_plane);
+      int value = 0;
+      nt::execute([&value](int& v) { v = value++; }, tensor);
+
+      auto reshaped_tensor = nt::reshape(tensor, std::array<std::size_t, 2u>{8u, 3u});
+      auto& reshaped_plane = reshaped_tensor.planes().template plane<0u>();
+      CHECK(!(reshaped_plane.buffer() == static_plane.buffer()));
+      CHECK(reshaped_plane.strides() == std::array<long long, 2u>{1, 8});
+
+      bool equal = true;
+      nt::execute([&equal](int l, int r) { equal &= l == r; }, reshaped_tensor, tensor);
+      CHECK(equal);
+    }
+  }
+
+  SECTION("stream_io") {
+    auto out_plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>, 3u>({7u, 2u, 3u});
+    auto out_tensor = nt::create_tensor<nt::ShapeTransmutation>(out_plane);
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++ * 3 - 50; }, out_tensor);
+
+    // The text is the same as the text of a Plane with the same dimensions
+    auto static_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<7u, 2u, 3u>{}, 3u, false>();
+    auto static_tensor = nt::create_tensor<nt::ShapeTransmutation>(static_plane);
+    nt::execute([](int& l, int r) { l = r; }, static_tensor, out_tensor);
+
+    std::stringstream ss;
+    std::stringstream static_ss;
+    nt::write_to_sink(out_tensor, ss);
+    nt::write_to_sink(static_tensor, static_ss);
+    CHECK(ss.view() == static_ss.view());
+
+    auto elements_equal = [](auto& lhs, auto& rhs) {
+      bool equal = true;
+      nt::execute([&equal](int l, int r) { equal &= l == r; }, lhs, rhs);
+      return equal;
+    };
+
+    {
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>, 3u, false>({7u, 2u, 3u}));
+      nt::load_from_source(in_tensor, ss.view());
+      CHECK(elements_equal(in_tensor, out_tensor));
+    }
+
+    {
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>, 3u>({7u, 2u, 3u}));
+      nt::ThreadPool pool{2u};
+      nt::load_from_source(nt::par.on(pool), in_tensor, ss.view());
+      CHECK(elements_equal(in_tensor, out_tensor));
+    }
+
+    {
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<3u>, 3u>({7u, 2u, 3u}));
+      std::stringstream in{ss.str()};
+      nt::load_from_stream(in_tensor, in);
+      CHECK(elements_equal(in_tensor, out_tensor));
+    }
+  }
+
+  SECTION("dispatch_static method") {
+    static constexpr nt::Dimensions<4u, 4u> small;
+    static constexpr nt::Dimensions<8u, 6u> large;
+
+    std::size_t static_calls = 0u, dynamic_calls = 0u;
+    auto count = [&static_calls, &dynamic_calls](auto&& plane) {
+      if constexpr (nt::is_dynamic_plane_v<decltype(plane)>) {
+        ++dynamic_calls;
+      } else {
+        ++static_calls;
+      }
+      nt::execute([](int& v) { v = 1; }, nt::create_tensor<nt::ShapeTransmutation>(plane));
+    };
+
+    {
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<2u>>({8u, 6u});
+      CHECK(nt::dispatch_static<small, large>(plane, count));
+      CHECK(static_calls == 1u);
+
+      // The static plane shares the buffer of the dynamic plane
+      int sum = 0;
+      nt::execute([&sum](int v) { sum += v; }, nt::create_tensor<nt::ShapeTransmutation>(plane));
+      CHECK(sum == 48);
+    }
+
+    {
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<2u>, 1u, false>({4u, 4u});
+      CHECK(nt::dispatch_static<small, large>(plane, count));
+      CHECK(static_calls == 2u);
+    }
+
+    {
+      // Unknown shapes and permuted strides are handled by the dynamic plane
+      auto plane = nt::create_dynamic_plane<nt::DenseBuffer<int>, nt::DynamicExtents<2u>>({5u, 4u});
+      CHECK(!nt::dispatch_static<small, large>(plane, count));
+
+      auto permuted_plane = plane.like({4u, 5u}, {plane.template stride<1u>(), 1});
+      CHECK(!nt::dispatch_static<small, large>(permuted_plane, count));
+      CHECK(dynamic_calls == 2u);
+    }
+  }
+}
@@ -1,9 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <dense_buffer.hpp>
 #include <execute.hpp>
 #include <plane.hpp>
 #include <shape_transmutation.hpp>
+#include <sparse_buffer.hpp>
 #include <tensor.hpp>
+#include <type_traits>
+#include <vector>
 
 namespace nt = ntensor;
 
@@ -524,3 +528,599 @@ TEST_CASE("execute method tests") {
     }
   }
 }
+
+TEST_CASE("execute planes with equal dimensions and different strides") {
+  static constexpr nt::Dimensions<37, 5, 3> dimensions;
+  auto aligned_tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+  auto unaligned_tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions, 1u, false>());
+  auto fn = [](int& v) {
+    static int i = 0;
+    v = i++;
+  };
+  nt::execute(fn, aligned_tensor);
+
+  auto check = [&](int sign) {
+    int value = 0;
+    for (std::size_t k = 0u; k < 3u; ++k) {
+      for (std::size_t j = 0u; j < 5u; ++j) {
+        for (std::size_t i = 0u; i < 37u; ++i) {
+          CHECK(unaligned_tensor.slicing_value(0u, i, j, k) == sign * value);
+          CHECK(aligned_tensor.slicing_value(0u, i, j, k) == value++);
+        }
+      }
+    }
+  };
+
+  nt::execute([](int& fst, const int& snd) { fst = snd; }, unaligned_tensor, aligned_tensor);
+  check(1);
+
+  nt::execute(nt::par, [](int& fst, const int& snd) { fst = -snd; }, unaligned_tensor, aligned_tensor);
+  nt::execute(nt::unseq, nt::vectorized([](auto& fst, const auto& snd) { fst = -snd; }), aligned_tensor,
+              unaligned_tensor);
+  check(-1);
+}
+
+TEST_CASE("parallel execute method tests") {
+  SECTION("single tensor, one plane") {
+    static constexpr nt::Dimensions<130, 70, 5> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, tensor);
+    nt::execute(nt::par, [](int& v) { v *= 2; }, tensor);
+
+    int value = 0;
+
+    for (std::size_t k = 0u; k < 5u; ++k) {
+      for (std::size_t j = 0u; j < 70u; ++j) {
+        for (std::size_t i = 0u; i < 130u; ++i) {
+          CHECK(tensor.slicing_value(0u, i, j, k) == 2 * value);
+          ++value;
+        }
+      }
+    }
+  }
+
+  SECTION("single tensor, one plane of rank 1 with three channels") {
+    static constexpr nt::Dimensions<20000> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, tensor);
+    nt::execute(nt::par, [](int& v) { v += 1; }, tensor);
+
+    int value = 0;
+
+    for (std::size_t i = 0u; i < 20000u; ++i) {
+      for (std::size_t c = 0u; c < 3u; ++c) {
+        CHECK(tensor.slicing_value(c, i) == value + 1);
+        ++value;
+      }
+    }
+  }
+
+  SECTION("two tensors, each with one plane, recursive executed called") {
+    static constexpr nt::Dimensions<100, 3, 90> dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, second_tensor);
+    nt::execute(nt::par, [](int& fst, const int& snd) { fst = snd - 1; }, first_tensor, second_tensor);
+
+    int value = 0;
+
+    for (std::size_t k = 0u; k < 90u; ++k) {
+      for (std::size_t j = 0u; j < 3u; ++j) {
+        for (std::size_t i = 0u; i < 100u; ++i) {
+          CHECK(first_tensor.slicing_value(0, i, j, k) == value - 1);
+          ++value;
+        }
+      }
+    }
+  }
+
+  SECTION("two tensors, each with one plane, iterative execute called") {
+    static constexpr nt::Dimensions<100, 3, 90> first_plane_dimensions;
+    static constexpr nt::Dimensions<300, 90> second_plane_dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, first_plane_dimensions>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, second_plane_dimensions>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, second_tensor);
+    nt::execute(nt::par, [](int& fst, const int& snd) { fst = snd; }, first_tensor, second_tensor);
+
+    int value = 0;
+
+    for (std::size_t k = 0u; k < 90u; ++k) {
+      for (std::size_t j = 0u; j < 3u; ++j) {
+        for (std::size_t i = 0u; i < 100u; ++i) {
+          CHECK(first_tensor.slicing_value(0, i, j, k) == value);
+          ++value;
+        }
+      }
+    }
+  }
+
+  SECTION("custom thread pool, matches the sequential execution") {
+    static constexpr nt::Dimensions<64, 33, 17> dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<float>, dimensions, 2u>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<float>, dimensions, 2u>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](float& v) {
+      static int i = 0;
+      v = static_cast<float>(i++ % 1000);
+    };
+    nt::execute(fn, first_tensor);
+    nt::execute([](float& fst, float& snd) { snd = fst; }, first_tensor, second_tensor);
+
+    nt::ThreadPool pool{3u};
+    auto transform = [](float& v) { v = v * 0.5f + 1.0f; };
+    nt::execute(nt::seq, transform, first_tensor);
+    nt::execute(nt::par.on(pool), transform, second_tensor);
+
+    for (std::size_t k = 0u; k < 17u; ++k) {
+      for (std::size_t j = 0u; j < 33u; ++j) {
+        for (std::size_t i = 0u; i < 64u; ++i) {
+          for (std::size_t c = 0u; c < 2u; ++c) {
+            CHECK(first_tensor.slicing_value(c, i, j, k) == second_tensor.slicing_value(c, i, j, k));
+          }
+        }
+      }
+    }
+  }
+  SECTION("sparse planes are written sequentially") {
+    // Writing elements that aren't stored inserts them into the shared container of the buffer
+    static constexpr nt::Dimensions<300, 200> dimensions;
+    auto sparse = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::SparseBuffer<float>, dimensions>());
+    auto dense = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>());
+    nt::execute([](float& v) { v = 2.0f; }, dense);
+
+    nt::ThreadPool pool{3u};
+    nt::execute(nt::par.on(pool), [](auto&& v) { v = 1.0f; }, sparse);
+    CHECK(sparse.planes().template plane<0u>().buffer().nonzeros() == 300u * 200u);
+
+    // Recursive and iterative execution of several tensors
+    nt::execute(nt::par.on(pool), [](auto&& s, float d) { s = s + d; }, sparse, dense);
+    auto flat = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<60000>{}>());
+    nt::execute([](float& v) { v = 1.0f; }, flat);
+    nt::execute(nt::par.on(pool), [](auto&& s, float f) { s = s + f; }, sparse, flat);
+
+    bool equal = true;
+    nt::execute([&equal](float v) { equal &= v == 4.0f; }, sparse);
+    CHECK(equal);
+  }
+}
+
+TEST_CASE("unsequenced execute method tests") {
+  SECTION("single tensor, one plane with three channels, matches the sequential execution") {
+    static constexpr nt::Dimensions<37, 5, 3> dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, first_tensor);
+    nt::execute([](int& fst, int& snd) { snd = fst; }, first_tensor, second_tensor);
+
+    auto transform = nt::vectorized([](auto& v) { v = v * 2 + 1; });
+    nt::execute(nt::seq, transform, first_tensor);
+    nt::execute(nt::unseq, transform, second_tensor);
+
+    for (std::size_t k = 0u; k < 3u; ++k) {
+      for (std::size_t j = 0u; j < 5u; ++j) {
+        for (std::size_t i = 0u; i < 37u; ++i) {
+          for (std::size_t c = 0u; c < 3u; ++c) {
+            CHECK(first_tensor.slicing_value(c, i, j, k) == second_tensor.slicing_value(c, i, j, k));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("unaligned plane") {
+    static constexpr nt::Dimensions<101> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<float>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](float& v) {
+      static int i = 0;
+      v = static_cast<float>(i++);
+    };
+    nt::execute(fn, tensor);
+
+    auto unaligned_plane = plane.template like<nt::Dimensions<97>{}, nt::Strides<1>{}>(3);
+    auto unaligned_tensor = nt::create_tensor<nt::ShapeTransmutation>(unaligned_plane);
+    nt::execute(nt::unseq, nt::vectorized([](auto& v) { v = -v; }), unaligned_tensor);
+
+    for (std::size_t i = 0u; i < 101u; ++i) {
+      const float expected = static_cast<float>(i);
+      CHECK(tensor.slicing_value(0u, i) == (i >= 3u && i < 100u ? -expected : expected));
+    }
+  }
+
+  SECTION("the same tensor passed as a mutable and as a const tensor") {
+    static constexpr nt::Dimensions<100, 3, 9> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++ % 1000;
+    };
+    nt::execute(fn, tensor);
+    const auto& const_tensor = tensor;
+    nt::execute(nt::unseq, nt::vectorized([](auto& fst, const auto& snd) { fst = snd * 2; }), tensor, const_tensor);
+
+    int value = 0;
+    for (std::size_t k = 0u; k < 9u; ++k) {
+      for (std::size_t j = 0u; j < 3u; ++j) {
+        for (std::size_t i = 0u; i < 100u; ++i) {
+          CHECK(tensor.slicing_value(0u, i, j, k) == (value++ % 1000) * 2);
+        }
+      }
+    }
+  }
+
+  SECTION("two tensors, each with one plane, recursive executed called") {
+    static constexpr nt::Dimensions<100, 3, 9> dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, second_tensor);
+    nt::execute(nt::unseq, nt::vectorized([](auto& fst, const auto& snd) { fst = snd - 1; }), first_tensor,
+                second_tensor);
+
+    int value = 0;
+
+    for (std::size_t k = 0u; k < 9u; ++k) {
+      for (std::size_t j = 0u; j < 3u; ++j) {
+        for (std::size_t i = 0u; i < 100u; ++i) {
+          CHECK(first_tensor.slicing_value(0, i, j, k) == value - 1);
+          CHECK(second_tensor.slicing_value(0, i, j, k) == value);
+          ++value;
+        }
+      }
+    }
+  }
+
+  SECTION("the last elements of a row are processed by narrower packs") {
+    static constexpr std::size_t width = nt::simd_width_v<float>;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<2u * width - 1u, 3u>{}>());
+    nt::execute([](float& v) { v = 1.0f; }, tensor);
+
+    std::vector<std::size_t> sizes;
+    nt::execute(
+        nt::unseq, nt::vectorized([&sizes](auto& v) {
+          if constexpr (std::is_arithmetic_v<std::decay_t<decltype(v)>>) {
+            sizes.emplace_back(1u);
+          } else {
+            sizes.emplace_back(std::decay_t<decltype(v)>::size());
+          }
+          v = v * 2.0f;
+        }),
+        tensor);
+
+    // Each row is processed by a full pack, followed by packs of halving widths and a single element
+    std::vector<std::size_t> expected;
+    for (std::size_t j = 0u; j < 3u; ++j) {
+      for (std::size_t size = width; size > 0u; size /= 2u) expected.emplace_back(size);
+    }
+    CHECK(sizes == expected);
+
+    bool doubled = true;
+    nt::execute([&doubled](float v) { doubled &= v == 2.0f; }, tensor);
+    CHECK(doubled);
+  }
+
+  SECTION("packs are only used with a single plane that can be written") {
+    using plane_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<64, 3>{}>());
+    auto fn = nt::vectorized([](auto& fst, const auto& snd) { fst = snd; });
+    static_assert(nt::is_vectorizable<decltype(fn), plane_type&, const plane_type&>());
+    // The packs of the second plane would be stored after each call, even though it's only read
+    static_assert(!nt::is_vectorizable<decltype(fn), plane_type&, plane_type&>());
+  }
+
+  SECTION("packs are only used with invocables marked as accepting them") {
+    using plane_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<64, 3>{}>());
+    auto fn = [](auto& v) { v = -v; };
+    static_assert(!nt::is_vectorizable<decltype(fn), plane_type&>());
+    static_assert(nt::is_vectorizable<decltype(nt::vectorized(fn)), plane_type&>());
+  }
+
+  SECTION("unmarked generic invocable that doesn't support packs") {
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<100, 3>{}>());
+    float value = -50.0f;
+    nt::execute([&value](float& v) { v = value++; }, tensor);
+
+    // Comparisons and math functions don't accept packs, so the elements are iterated one by one
+    nt::execute(
+        nt::unseq,
+        [](auto& v) {
+          if (v > 0.0f) v = std::sqrt(v);
+        },
+        tensor);
+
+    value = -50.0f;
+    for (std::size_t j = 0u; j < 3u; ++j) {
+      for (std::size_t i = 0u; i < 100u; ++i, ++value) {
+        CHECK(tensor.slicing_value(0u, i, j) == (value > 0.0f ? std::sqrt(value) : value));
+      }
+    }
+  }
+
+  SECTION("scalar invocable, falls back to the sequential execution") {
+    static constexpr nt::Dimensions<30, 4> first_plane_dimensions;
+    static constexpr nt::Dimensions<120> second_plane_dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, first_plane_dimensions>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, second_plane_dimensions>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(nt::unseq, fn, second_tensor);
+    nt::execute(nt::unseq, [](int& fst, const int& snd) { fst = snd * 3; }, first_tensor, second_tensor);
+
+    int value = 0;
+
+    for (std::size_t j = 0u; j < 4u; ++j) {
+      for (std::size_t i = 0u; i < 30u; ++i) {
+        CHECK(first_tensor.slicing_value(0, i, j) == value * 3);
+        ++value;
+      }
+    }
+  }
+}
+
+TEST_CASE("sequenced execute with a generic invocable that doesn't support packs") {
+  static constexpr nt::Dimensions<40, 3> dimensions;
+  auto first_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+  auto second_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+  auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+  auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+
+  // The comparison isn't defined for packs, so the invocable can't be instantiated with them
+  nt::execute(nt::seq, [](auto& v) { v = v < v ? 0 : 7; }, first_tensor);
+  nt::execute(nt::seq, [](auto& fst, auto& snd) { snd = fst > 5 ? fst : 0; }, first_tensor, second_tensor);
+
+  for (std::size_t j = 0u; j < 3u; ++j) {
+    for (std::size_t i = 0u; i < 40u; ++i) {
+      CHECK(second_tensor.slicing_value(0u, i, j) == 7);
+    }
+  }
+}
+
+TEST_CASE("broadcasting execute method tests") {
+  SECTION("broadcastable dimensions") {
+    using row_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<37>{}>());
+    using column_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<1, 50>{}>());
+    using matrix_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<37, 50>{}>());
+    using other_type = decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<50, 37>{}>());
+    static_assert(nt::are_broadcastable<matrix_type, row_type>());
+    static_assert(nt::are_broadcastable<column_type, matrix_type, row_type>());
+    static_assert(!nt::are_broadcastable<other_type, row_type>());
+    static_assert(!nt::are_broadcastable<other_type, matrix_type>());
+    static_assert(*nt::broadcast_dimensions_array<row_type, column_type>() == std::array<std::size_t, 2u>{37u, 50u});
+
+    // Only the planes that are broadcast have to be read-only
+    static_assert(nt::are_broadcast_planes_read_only<matrix_type, const row_type>());
+    static_assert(nt::are_broadcast_planes_read_only<const matrix_type, const row_type>());
+    static_assert(!nt::are_broadcast_planes_read_only<matrix_type, row_type>());
+    static_assert(!nt::are_broadcast_planes_read_only<const column_type, matrix_type, row_type&>());
+  }
+
+  SECTION("a row added to each row of a plane") {
+    auto tensor =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<37, 50>{}>());
+    auto bias =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<37>{}>());
+    float value = 0.0f;
+    nt::execute([&value](float& v) { v = value++; }, bias);
+    const auto& const_bias = bias;
+
+    auto check = [&](float scale) {
+      for (std::size_t j = 0u; j < 50u; ++j) {
+        for (std::size_t i = 0u; i < 37u; ++i) {
+          CHECK(tensor.slicing_value(0u, i, j) == scale * static_cast<float>(i));
+        }
+      }
+    };
+
+    nt::execute([](float& v) { v = 0.0f; }, tensor);
+    nt::execute([](float& v, const float& b) { v += b; }, tensor, const_bias);
+    check(1.0f);
+    nt::execute(nt::unseq, nt::vectorized([](auto& v, const auto& b) { v += b; }), tensor, const_bias);
+    check(2.0f);
+    nt::execute(nt::par, [](float& v, const float& b) { v += b; }, tensor, const_bias);
+    check(3.0f);
+  }
+
+  SECTION("a column multiplied with each column of a plane, planes of different ranks") {
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<40, 6, 3>{}>());
+    auto scale =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<1, 6>{}>());
+    float value = 1.0f;
+    nt::execute([&value](float& v) { v = value++; }, scale);
+    const auto& const_scale = scale;
+
+    auto check = [&](float expected) {
+      for (std::size_t k = 0u; k < 3u; ++k) {
+        for (std::size_t j = 0u; j < 6u; ++j) {
+          for (std::size_t i = 0u; i < 40u; ++i) {
+            CHECK(tensor.slicing_value(0u, i, j, k) == expected * static_cast<float>(j + 1u));
+          }
+        }
+      }
+    };
+
+    // The scale is invariant along the innermost dimension, so it's loaded once per row (and broadcast into a pack)
+    nt::execute([](float& v) { v = 1.0f; }, tensor);
+    nt::execute([](float& v, const float& s) { v *= s; }, tensor, const_scale);
+    check(1.0f);
+    nt::execute(nt::unseq, nt::vectorized([](auto& v, auto s) { v *= (s = s + 1.0f) - 1.0f; }), tensor, const_scale);
+    for (std::size_t j = 0u; j < 6u; ++j) {
+      CHECK(scale.slicing_value(0u, std::size_t{0u}, j) == static_cast<float>(j + 1u));
+    }
+    nt::execute(nt::par, [](float& v, const float& s) { v /= s; }, tensor, const_scale);
+    check(1.0f);
+  }
+
+  SECTION("planes with several channels") {
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<20, 30>{}, 3u>());
+    auto column = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<1, 30>{}, 3u>());
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, column);
+    const auto& const_column = column;
+
+    nt::execute(nt::unseq, nt::vectorized([](auto& v, const auto& c) { v = c; }), tensor, const_column);
+    for (std::size_t j = 0u; j < 30u; ++j) {
+      for (std::size_t i = 0u; i < 20u; ++i) {
+        for (std::size_t c = 0u; c < 3u; ++c) {
+          CHECK(tensor.slicing_value(c, i, j) == static_cast<int>(j * 3u + c));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("unrolled execute method tests") {
+  SECTION("small planes are unrolled") {
+    static_assert(nt::is_unrollable<decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<4, 4>{}>())>());
+    static_assert(
+        nt::is_unrollable<decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<3, 3>{}, 3u>())>());
+    static_assert(
+        !nt::is_unrollable<decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<5, 5, 3>{}>())>());
+    static_assert(
+        !nt::is_unrollable<decltype(nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<5, 5>{}, 3u>())>());
+  }
+
+  SECTION("matches the order of the loops, with channels") {
+    static constexpr nt::Dimensions<3, 2, 2> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>();
+    auto unaligned_plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u, false>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto unaligned_tensor = nt::create_tensor<nt::ShapeTransmutation>(unaligned_plane);
+
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, tensor);
+    nt::execute(nt::par, [](int& fst, const int& snd) { fst = 2 * snd; }, unaligned_tensor, tensor);
+
+    int expected = 0;
+    for (std::size_t k = 0u; k < 2u; ++k) {
+      for (std::size_t j = 0u; j < 2u; ++j) {
+        for (std::size_t i = 0u; i < 3u; ++i) {
+          for (std::size_t c = 0u; c < 3u; ++c) {
+            CHECK(unaligned_tensor.slicing_value(c, i, j, k) == 2 * expected);
+            CHECK(tensor.slicing_value(c, i, j, k) == expected++);
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("planes with different dimensions") {
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<2, 6>{}>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<3, 4>{}>();
+    auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane);
+    auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(second_plane);
+
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, first_tensor);
+    nt::execute(nt::seq, [](const int& fst, int& snd) { snd = fst + 1; }, first_tensor, second_tensor);
+
+    int expected = 1;
+    for (std::size_t j = 0u; j < 4u; ++j) {
+      for (std::size_t i = 0u; i < 3u; ++i) {
+        CHECK(second_tensor.slicing_value(0u, i, j) == expected++);
+      }
+    }
+
+    nt::execute(nt::par, [](int& fst, const int& snd) { fst = -snd; }, first_tensor, second_tensor);
+    expected = 1;
+    for (std::size_t j = 0u; j < 6u; ++j) {
+      for (std::size_t i = 0u; i < 2u; ++i) {
+        CHECK(first_tensor.slicing_value(0u, i, j) == -expected++);
+      }
+    }
+  }
+
+  SECTION("the unsequenced policy calls the invocable with scalars") {
+    auto plane = nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<4, 4>{}>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+
+    nt::execute(nt::unseq, [](auto& v) { v = 3.0f; }, tensor);
+    nt::execute(nt::unseq, [](auto& v) { v *= 2.0f; }, tensor);
+
+    for (std::size_t j = 0u; j < 4u; ++j) {
+      for (std::size_t i = 0u; i < 4u; ++i) {
+        CHECK(tensor.slicing_value(0u, i, j) == 6.0f);
+      }
+    }
+  }
+}
+
+TEST_CASE("position_counter class tests") {
+  SECTION("matches compute_array_position_from_index") {
+    static constexpr nt::Dimensions<5, 3, 4> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 2u>();
+    using plane_type = std::decay_t<decltype(plane)>;
+    static constexpr auto unaligned_strides = nt::compute_unaligned_strides(dimensions);
+
+    nt::position_counter<plane_type> counter{};
+
+    for (std::size_t idx = 0u; idx < 60u; ++idx) {
+      CHECK(counter.position() ==
+            nt::compute_array_position_from_index<2u>(unaligned_strides, plane_type::strides(), 0u, idx));
+      counter.advance();
+    }
+  }
+
+  SECTION("starts from an arbitrary index") {
+    static constexpr nt::Dimensions<7, 2, 3> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    using plane_type = std::decay_t<decltype(plane)>;
+    static constexpr auto unaligned_strides = nt::compute_unaligned_strides(dimensions);
+
+    for (std::size_t first = 0u; first < 42u; ++first) {
+      nt::position_counter<plane_type> counter{first};
+      CHECK(counter.indexes()[0u] == first % 7u);
+      CHECK(counter.indexes()[1u] == (first / 7u) % 2u);
+      CHECK(counter.indexes()[2u] == first / 14u);
+
+      for (std::size_t idx = first; idx < 42u; ++idx) {
+        CHECK(counter.position() ==
+              nt::compute_array_position_from_index<1u>(unaligned_strides, plane_type::strides(), 0u, idx));
+        counter.advance();
+      }
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <expression.hpp>
+#include <functional>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+TEST_CASE("expression tests") {
+  static constexpr nt::Dimensions<37, 5, 3> dimensions;
+  auto first_tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+  auto second_tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+  auto third_tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+  auto result_tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+
+  auto fn = [](int& v) {
+    static int i = 0;
+    v = i++ % 1000;
+  };
+  nt::execute(fn, first_tensor);
+  nt::execute([](int& fst, int& snd, int& trd) { snd = fst + 1, trd = fst * 2; }, first_tensor, second_tensor,
+              third_tensor);
+
+  auto check = [&](auto expected) {
+    for (unsigned k = 0u; k < 3u; ++k) {
+      for (unsigned j = 0u; j < 5u; ++j) {
+        for (unsigned i = 0u; i < 37u; ++i) {
+          const int a = first_tensor.slicing_value(0u, i, j, k);
+          CHECK(result_tensor.slicing_value(0u, i, j, k) == expected(a, a + 1, a * 2));
+        }
+      }
+    }
+  };
+
+  SECTION("expressions are lazy") {
+    auto expression = first_tensor * second_tensor + third_tensor;
+    STATIC_REQUIRE(decltype(expression)::num_leaves == 3u);
+    STATIC_REQUIRE(std::tuple_size_v<decltype(expression.leaves())> == 3u);
+  }
+
+  SECTION("binary operators") {
+    nt::assign(result_tensor, first_tensor * second_tensor + third_tensor);
+    check([](int a, int b, int c) { return a * b + c; });
+
+    nt::assign(result_tensor, (first_tensor - third_tensor) / second_tensor);
+    check([](int a, int b, int c) { return (a - c) / b; });
+  }
+
+  SECTION("scalars and unary minus") {
+    nt::assign(result_tensor, 2 * first_tensor - -second_tensor + 3);
+    check([](int a, int b, int) { return 2 * a + b + 3; });
+  }
+
+  SECTION("map") {
+    auto max = [](const auto& lhs, const auto& rhs) { return lhs > rhs ? lhs : rhs; };
+    nt::assign(result_tensor, nt::map(max, first_tensor - 500, third_tensor - 1000) * 2);
+    check([](int a, int, int c) { return std::max(a - 500, c - 1000) * 2; });
+  }
+
+  SECTION("destination is an operand") {
+    nt::assign(result_tensor, first_tensor + 0);
+    nt::assign(result_tensor, result_tensor * result_tensor + second_tensor);
+    check([](int a, int b, int) { return a * a + b; });
+
+    nt::assign(result_tensor, first_tensor + 0);
+    nt::assign(nt::unseq, result_tensor, result_tensor * 2 + third_tensor);
+    check([](int a, int, int c) { return a * 2 + c; });
+  }
+
+  SECTION("assignment operator") {
+    result_tensor = first_tensor * second_tensor + third_tensor;
+    check([](int a, int b, int c) { return a * b + c; });
+
+    // The tensor keeps its planes, so copies of it see the result
+    auto copy = result_tensor;
+    copy = first_tensor - third_tensor;
+    check([](int a, int, int c) { return a - c; });
+  }
+
+  SECTION("execution policies") {
+    nt::assign(nt::par, result_tensor, first_tensor * second_tensor + third_tensor);
+    check([](int a, int b, int c) { return a * b + c; });
+
+    nt::assign(nt::unseq, result_tensor, first_tensor * 3 + third_tensor / 2);
+    check([](int a, int, int c) { return a * 3 + c / 2; });
+  }
+
+  SECTION("only arithmetic operators and marked operations are evaluated on packs") {
+    auto select = [](const auto& x, const auto& y) { return x > 500 ? x : y; };
+    STATIC_REQUIRE(decltype(first_tensor * second_tensor + third_tensor)::vectorized);
+    STATIC_REQUIRE(!decltype(nt::map(select, first_tensor, second_tensor) * 2)::vectorized);
+    STATIC_REQUIRE(decltype(nt::map(nt::vectorized(std::plus<>{}), first_tensor, second_tensor))::vectorized);
+
+    // The comparison doesn't accept packs, so the expression is evaluated element by element
+    nt::assign(nt::unseq, result_tensor, nt::map(select, first_tensor, third_tensor) * 2);
+    check([](int a, int, int c) { return (a > 500 ? a : c) * 2; });
+  }
+
+  SECTION("planes with different dimensions") {
+    static constexpr nt::Dimensions<185, 3> other_dimensions;
+    auto other_tensor =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, other_dimensions>());
+    nt::assign(other_tensor, first_tensor + 1);
+
+    int value = 0;
+    for (unsigned k = 0u; k < 3u; ++k) {
+      for (unsigned j = 0u; j < 5u; ++j) {
+        for (unsigned i = 0u; i < 37u; ++i) {
+          CHECK(other_tensor.slicing_value(0u, value % 185u, value / 185u) ==
+                first_tensor.slicing_value(0u, i, j, k) + 1);
+          ++value;
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("expression tests, float planes with channels") {
+  static constexpr nt::Dimensions<70, 3> dimensions;
+  auto first_tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions, 3u>());
+  auto second_tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions, 3u>());
+  auto fn = [](float& v) {
+    static int i = 0;
+    v = static_cast<float>(i++);
+  };
+  nt::execute(fn, first_tensor);
+
+  nt::assign(nt::unseq, second_tensor, first_tensor * 0.5f + 1.0f);
+
+  for (unsigned j = 0u; j < 3u; ++j) {
+    for (unsigned i = 0u; i < 70u; ++i) {
+      for (unsigned c = 0u; c < 3u; ++c) {
+        CHECK(second_tensor.slicing_value(c, i, j) == first_tensor.slicing_value(c, i, j) * 0.5f + 1.0f);
+      }
+    }
+  }
+}
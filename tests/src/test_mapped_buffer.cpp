@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mapped_buffer.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+namespace {
+
+/*
+ * Removes the file when it goes out of scope
+ */
+struct temporary_file {
+  std::filesystem::path path;
+
+  explicit temporary_file(const char* name) : path{std::filesystem::temp_directory_path() / name} {
+    std::filesystem::remove(path);
+  }
+  ~temporary_file() { std::filesystem::remove(path); }
+};
+
+/*
+ * Reads the integers stored in a file
+ */
+std::vector<int> read_file(const std::filesystem::path& path) {
+  std::ifstream stream{path, std::ios::binary};
+  std::vector<int> values(std::filesystem::file_size(path) / sizeof(int));
+  stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(int)));
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("MappedBuffer tests") {
+  temporary_file file{"ntensor_test_mapped_buffer.bin"};
+  {
+    std::ofstream stream{file.path, std::ios::binary};
+    for (int i = 0; i < 100; ++i) {
+      stream.write(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+  }
+
+  SECTION("read-only mapping") {
+    nt::MappedBuffer<int> buffer{file.path};
+    STATIC_REQUIRE(nt::buffer<nt::MappedBuffer<int>>);
+    STATIC_REQUIRE(nt::contiguous_buffer<nt::MappedBuffer<int>>);
+    STATIC_REQUIRE(std::is_same_v<nt::MappedBuffer<int>::reference, const int&>);
+
+    REQUIRE(buffer.size() == 100u);
+    for (std::size_t i = 0u; i < buffer.size(); ++i) {
+      CHECK(buffer[i] == static_cast<int>(i));
+      CHECK(buffer.at(i) == static_cast<int>(i));
+    }
+
+    auto copy = buffer;
+    CHECK(copy == buffer);
+    CHECK(copy.data() == buffer.data());
+
+    // Views of a part of the file start at a multiple of NT_ALIGNMENT
+    static constexpr std::size_t first = NT_ALIGNMENT / sizeof(int);
+    auto mapping = std::make_shared<const nt::FileMapping>(file.path);
+    nt::MappedBuffer<int> part{mapping, NT_ALIGNMENT, 20u};
+    REQUIRE(part.size() == 20u);
+    CHECK(part[0u] == static_cast<int>(first));
+    CHECK(part[19u] == static_cast<int>(first) + 19);
+
+    part.advise(nt::access_pattern::sequential);
+    part.advise(nt::access_pattern::random);
+    mapping->advise(nt::access_pattern::will_need);
+    CHECK(part[5u] == static_cast<int>(first) + 5);
+  }
+
+  SECTION("copy-on-write mapping") {
+    nt::MappedBuffer<int, nt::mapping_mode::copy_on_write> buffer{file.path};
+    STATIC_REQUIRE(nt::contiguous_buffer<nt::MappedBuffer<int, nt::mapping_mode::copy_on_write>>);
+
+    for (std::size_t i = 0u; i < buffer.size(); ++i) {
+      buffer[i] = -buffer[i];
+    }
+    CHECK(buffer[7u] == -7);
+
+    const auto values = read_file(file.path);
+    CHECK(values[7u] == 7);
+  }
+
+  SECTION("shared mapping") {
+    {
+      nt::MappedBuffer<int, nt::mapping_mode::shared> buffer{file.path};
+      buffer.at(7u) = 700;
+      buffer.flush();
+    }
+
+    const auto values = read_file(file.path);
+    CHECK(values.size() == 100u);
+    CHECK(values[7u] == 700);
+    CHECK(values[8u] == 8);
+  }
+
+  SECTION("missing files and files that are too small") {
+    CHECK_THROWS_AS(nt::MappedBuffer<int>{"/nonexistent/ntensor.bin"}, std::system_error);
+    CHECK_THROWS_AS((nt::MappedBuffer<int>{file.path, 1000u}), std::system_error);
+    CHECK_THROWS_AS((nt::MappedBuffer<int, nt::mapping_mode::copy_on_write>{file.path, 1000u}), std::system_error);
+  }
+}
+
+TEST_CASE("planes stored in mapped files") {
+  temporary_file file{"ntensor_test_mapped_plane.bin"};
+  static constexpr nt::Dimensions<37u, 5u, 3u> dimensions;
+
+  {
+    // The shared mode creates the file
+    auto plane = nt::create_plane<nt::MappedBuffer<int, nt::mapping_mode::shared>, dimensions>(file.path);
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, tensor);
+    nt::execute(nt::unseq, nt::vectorized([](auto& v) { v = v * 3; }), tensor);
+
+    REQUIRE(plane.real_size() == static_cast<std::size_t>(nt::max_product(dimensions, decltype(plane)::strides())));
+    CHECK(std::filesystem::file_size(file.path) == plane.real_size() * sizeof(int));
+  }
+
+  auto plane = nt::create_plane<nt::MappedBuffer<int>, dimensions>(file.path);
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+
+  int value = 0;
+  for (unsigned k = 0u; k < 3u; ++k) {
+    for (unsigned j = 0u; j < 5u; ++j) {
+      for (unsigned i = 0u; i < 37u; ++i) {
+        CHECK(tensor.slicing_value(0u, i, j, k) == 3 * value++);
+      }
+    }
+  }
+
+  static constexpr auto strides = decltype(plane)::strides();
+  auto sub_plane = plane.template like<nt::Dimensions<37u, 5u>{}, nt::Strides<1, strides.template at<1u>()>{}>(
+      strides.template at<2u>());
+  auto sub_tensor = nt::create_tensor<nt::ShapeTransmutation>(sub_plane);
+  CHECK(sub_tensor.slicing_value(0u, 2u, 1u) == 3 * (37 * 5 + 37 + 2));
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <materialize.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sparse_buffer.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+template <typename T, nt::Dimensions dimensions, std::size_t channels = 1u>
+auto create_numbered_tensor() {
+  auto tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<T>, dimensions, channels>());
+  T value{};
+  nt::execute([&value](T& v) { v = value++; }, tensor);
+  return tensor;
+}
+
+template <typename Tensor>
+using first_plane_t = std::decay_t<decltype(std::declval<Tensor&>().planes().template plane<0u>())>;
+
+// Compares the elements of two tensors in the logical order
+template <typename Lhs, typename Rhs>
+bool elements_equal(Lhs& lhs, Rhs& rhs) {
+  bool equal = true;
+  nt::execute([&equal](const auto& l, const auto& r) { equal &= l == r; }, lhs, rhs);
+  return equal;
+}
+
+template <typename T>
+void test_transposed_matrix() {
+  // The extents aren't multiples of the block size, so the edges are copied element by element
+  static constexpr nt::Dimensions<37u, 45u> dimensions;
+  auto tensor = create_numbered_tensor<T, dimensions>();
+  auto transposed = tensor.template permute<0u, 1u, 0u>();
+
+  auto materialized = nt::materialize(transposed);
+  using materialized_plane = first_plane_t<decltype(materialized)>;
+
+  static_assert(std::is_same_v<std::decay_t<decltype(materialized_plane::dimensions())>, nt::Dimensions<45u, 37u>>);
+  static_assert(std::is_same_v<std::decay_t<decltype(materialized_plane::strides())>,
+                               std::decay_t<decltype(nt::compute_aligned_strides<T>(nt::Dimensions<45u, 37u>{}))>>);
+  CHECK(elements_equal(materialized, transposed));
+  CHECK(materialized.slicing_value(0u, 44u, 3u) == transposed.slicing_value(0u, 44u, 3u));
+  CHECK(materialized.slicing_value(0u, 44u, 36u) == tensor.slicing_value(0u, 36u, 44u));
+
+  // The materialized plane has its own buffer
+  materialized.slicing_value(0u, 0u, 0u) = T{100};
+  CHECK(tensor.slicing_value(0u, 0u, 0u) == T{0});
+}
+
+TEST_CASE("materialize method tests") {
+  SECTION("transposed matrix") {
+    test_transposed_matrix<float>();
+    test_transposed_matrix<double>();
+    test_transposed_matrix<int>();
+    test_transposed_matrix<std::uint8_t>();
+    test_transposed_matrix<std::int16_t>();
+  }
+
+  SECTION("matrix spanning several tiles") {
+    static constexpr nt::Dimensions<150u, 260u> dimensions;
+    auto tensor = create_numbered_tensor<float, dimensions>();
+    auto transposed = tensor.template permute<0u, 1u, 0u>();
+
+    auto materialized = nt::materialize(transposed);
+    CHECK(elements_equal(materialized, transposed));
+  }
+
+  SECTION("reversed dimensions") {
+    static constexpr nt::Dimensions<33u, 18u, 20u> dimensions;
+    auto tensor = create_numbered_tensor<int, dimensions>();
+    auto reversed = tensor.template permute<0u, 2u, 1u, 0u>();
+
+    auto materialized = nt::materialize(reversed);
+    static_assert(nt::has_canonical_strides<first_plane_t<decltype(materialized)>>());
+    CHECK(elements_equal(materialized, reversed));
+    CHECK(materialized.slicing_value(0u, 19u, 17u, 32u) == tensor.slicing_value(0u, 32u, 17u, 19u));
+  }
+
+  SECTION("innermost dimension moved to the middle") {
+    static constexpr nt::Dimensions<40u, 3u, 24u> dimensions;
+    auto tensor = create_numbered_tensor<float, dimensions>();
+    auto permuted = tensor.template permute<0u, 1u, 0u, 2u>();
+
+    auto materialized = nt::materialize(permuted);
+    CHECK(elements_equal(materialized, permuted));
+  }
+
+  SECTION("innermost dimension kept") {
+    static constexpr nt::Dimensions<40u, 3u, 24u> dimensions;
+    auto tensor = create_numbered_tensor<float, dimensions>();
+    auto permuted = tensor.template permute<0u, 0u, 2u, 1u>();
+    static_assert(nt::innermost_stored_dimension<first_plane_t<decltype(permuted)>>() == 0u);
+
+    auto materialized = nt::materialize(permuted);
+    CHECK(elements_equal(materialized, permuted));
+  }
+
+  SECTION("interleaved channels") {
+    static constexpr nt::Dimensions<19u, 21u> dimensions;
+    auto tensor = create_numbered_tensor<int, dimensions, 3u>();
+    auto transposed = tensor.template permute<0u, 1u, 0u>();
+
+    auto materialized = nt::materialize(transposed);
+    static_assert(first_plane_t<decltype(materialized)>::channels() == 3u);
+    CHECK(elements_equal(materialized, transposed));
+    CHECK(materialized.slicing_value(2u, 20u, 5u) == tensor.slicing_value(2u, 5u, 20u));
+  }
+
+  SECTION("sparse buffer") {
+    static constexpr nt::Dimensions<20u, 30u> dimensions;
+    auto tensor =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::SparseBuffer<int>, dimensions, 1u, false>());
+    tensor.slicing_value(0u, 4u, 7u) = 5;
+    tensor.slicing_value(0u, 19u, 29u) = 6;
+    auto transposed = tensor.template permute<0u, 1u, 0u>();
+
+    auto materialized = nt::materialize(transposed);
+    CHECK(materialized.slicing_value(0u, 7u, 4u) == 5);
+    CHECK(materialized.slicing_value(0u, 29u, 19u) == 6);
+    CHECK(materialized.slicing_value(0u, 0u, 0u) == 0);
+  }
+}
+
+TEST_CASE("contiguous method tests") {
+  SECTION("canonical strides") {
+    static constexpr nt::Dimensions<7u, 5u> dimensions;
+    auto aligned = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+    auto unaligned =
+        nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions, 1u, false>());
+
+    // The same buffer is returned, without copying the elements
+    auto contiguous_aligned = nt::contiguous(aligned);
+    auto contiguous_unaligned = nt::contiguous(unaligned);
+    static_assert(std::is_same_v<decltype(contiguous_aligned), decltype(aligned)>);
+    static_assert(std::is_same_v<decltype(contiguous_unaligned), decltype(unaligned)>);
+    CHECK(contiguous_aligned.planes().template plane<0u>() == aligned.planes().template plane<0u>());
+    CHECK(contiguous_unaligned.planes().template plane<0u>() == unaligned.planes().template plane<0u>());
+  }
+
+  SECTION("permuted strides") {
+    static constexpr nt::Dimensions<7u, 5u> dimensions;
+    auto tensor = create_numbered_tensor<int, dimensions>();
+    auto transposed = tensor.template permute<0u, 1u, 0u>();
+    static_assert(!nt::has_canonical_strides<first_plane_t<decltype(transposed)>>());
+
+    auto contiguous = nt::contiguous(transposed);
+    static_assert(nt::has_canonical_strides<first_plane_t<decltype(contiguous)>>());
+    CHECK(elements_equal(contiguous, transposed));
+  }
+}
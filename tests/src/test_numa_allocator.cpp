@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <memory>
+#include <numa_allocator.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <tensor.hpp>
+#include <thread_pool.hpp>
+#include <vector>
+
+namespace nt = ntensor;
+
+TEST_CASE("NumaAllocator class tests") {
+  SECTION("node count") { CHECK(nt::numa_node_count() >= 1u); }
+
+  SECTION("small and large allocations with each placement") {
+    for (const auto placement : {nt::numa_placement::first_touch, nt::numa_placement::interleave,
+                                 nt::numa_placement::bind}) {
+      nt::NumaAllocator<float> allocator{placement};
+      CHECK(allocator.placement() == placement);
+
+      for (const std::size_t n : {1u, 100u, 1u << 20u}) {
+        float* memory = allocator.allocate(n);
+        REQUIRE(memory);
+        CHECK(reinterpret_cast<std::uintptr_t>(memory) % NT_ALIGNMENT == 0u);
+
+        for (std::size_t i = 0u; i < n; i += 97u) {
+          memory[i] = static_cast<float>(i);
+        }
+        bool written = true;
+        for (std::size_t i = 0u; i < n; i += 97u) {
+          written &= memory[i] == static_cast<float>(i);
+        }
+        CHECK(written);
+        allocator.deallocate(memory, n);
+      }
+    }
+  }
+
+  SECTION("a node that doesn't exist falls back to the default placement") {
+    nt::NumaAllocator<int> allocator{nt::numa_placement::bind, 63u};
+    int* memory = allocator.allocate(1u << 16u);
+    memory[0] = 1;
+    memory[(1u << 16u) - 1u] = 2;
+    CHECK(memory[0] + memory[(1u << 16u) - 1u] == 3);
+    allocator.deallocate(memory, 1u << 16u);
+  }
+
+  SECTION("rebinding and comparison") {
+    nt::NumaAllocator<float> allocator{nt::numa_placement::bind, 1u};
+    nt::NumaAllocator<double> rebound{allocator};
+    CHECK(rebound.placement() == nt::numa_placement::bind);
+    CHECK(rebound.node() == 1u);
+    CHECK(rebound == allocator);
+    CHECK(nt::NumaAllocator<float>{}.placement() == nt::numa_placement::interleave);
+  }
+
+  SECTION("standard containers") {
+    std::vector<int, nt::NumaAllocator<int>> values(10000u, 3);
+    CHECK(values.back() == 3);
+  }
+}
+
+TEST_CASE("create_plane with an execution policy tests") {
+  static constexpr nt::Dimensions<300u, 200u, 3u> dimensions;
+  nt::ThreadPool pool{3u};
+
+  auto check_zeros = [](auto& plane) {
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    bool zeros = true;
+    nt::execute([&zeros](float v) { zeros &= v == 0.0f; }, tensor);
+    CHECK(zeros);
+  };
+
+  SECTION("parallel first touch") {
+    auto plane = nt::create_plane<nt::NumaBuffer<float>, dimensions>(
+        nt::par.on(pool), std::allocator_arg, nt::NumaAllocator<float>{nt::numa_placement::first_touch});
+    CHECK(plane.buffer().get_allocator().placement() == nt::numa_placement::first_touch);
+    check_zeros(plane);
+  }
+
+  SECTION("default allocator, several channels, unaligned strides") {
+    auto plane = nt::create_plane<nt::DenseBuffer<float>, dimensions, 3u, false>(nt::par.on(pool));
+    check_zeros(plane);
+  }
+
+  SECTION("sequenced and unsequenced policies") {
+    auto sequenced = nt::create_plane<nt::NumaBuffer<float>, dimensions>(nt::seq);
+    check_zeros(sequenced);
+
+    auto unsequenced = nt::create_plane<nt::DenseBuffer<float>, dimensions, 2u>(nt::unseq);
+    check_zeros(unsequenced);
+  }
+}
@@ -181,8 +181,8 @@ TEST_CASE("Plane class tests") {
       static_assert(plane_type::rank() == 3u);
 
       CHECK(plane.offset() == 0u);
-      CHECK(plane.effective_size() == 96u);
-      CHECK(plane.real_size() == 96u);
+      CHECK(plane.effective_size() == 48u);
+      CHECK(plane.real_size() == 48u);
     }
 
     {
@@ -208,8 +208,8 @@ TEST_CASE("Plane class tests") {
       static_assert(plane_type::rank() == 3u);
 
       CHECK(plane.offset() == 0u);
-      CHECK(plane.effective_size() == 96u);
-      CHECK(plane.real_size() == 96u);
+      CHECK(plane.effective_size() == 48u);
+      CHECK(plane.real_size() == 48u);
     }
 
     {
@@ -235,8 +235,8 @@ TEST_CASE("Plane class tests") {
       static_assert(plane_type::rank() == 3u);
 
       CHECK(plane.offset() == 0u);
-      CHECK(plane.effective_size() == 140u);
-      CHECK(plane.real_size() == 140u);
+      CHECK(plane.effective_size() == 84u);
+      CHECK(plane.real_size() == 84u);
     }
 
     {
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <execute.hpp>
+#include <functional>
+#include <limits>
+#include <plane.hpp>
+#include <reduce.hpp>
+#include <shape_transmutation.hpp>
+#include <sparse_buffer.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+TEST_CASE("reduce method tests") {
+  SECTION("single tensor, one plane") {
+    static constexpr nt::Dimensions<37, 5, 3> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](int& v) {
+      static int i = 0;
+      v = i++;
+    };
+    nt::execute(fn, tensor);
+
+    static constexpr int expected_sum = 37 * 5 * 3 * (37 * 5 * 3 - 1) / 2;
+    CHECK(nt::reduce(tensor, std::plus<>{}, 0) == expected_sum);
+    CHECK(nt::reduce(nt::seq, tensor, std::plus<>{}, 10) == expected_sum + 10);
+    CHECK(nt::reduce(nt::par, tensor, std::plus<>{}, 0) == expected_sum);
+    CHECK(nt::reduce(nt::unseq, tensor, std::plus<>{}, 0) == expected_sum);
+    CHECK(nt::reduce(tensor, [](int lhs, int rhs) { return std::max(lhs, rhs); }, 0) == 37 * 5 * 3 - 1);
+    // Generic operations that don't support simd packs can be used with the sequenced and parallel policies
+    auto max = [](const auto& lhs, const auto& rhs) { return std::max(lhs, rhs); };
+    CHECK(nt::reduce(nt::seq, tensor, max, 0) == 37 * 5 * 3 - 1);
+    CHECK(nt::reduce(nt::par, tensor, max, 0) == 37 * 5 * 3 - 1);
+  }
+
+  SECTION("single tensor, two planes, one plane with three channels") {
+    static constexpr nt::Dimensions<3, 4> first_plane_dimensions;
+    static constexpr nt::Dimensions<2000> second_plane_dimensions;
+    auto first_plane = nt::create_plane<nt::DenseBuffer<int>, first_plane_dimensions>();
+    auto second_plane = nt::create_plane<nt::DenseBuffer<int>, second_plane_dimensions, 3u>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(first_plane, second_plane);
+    nt::execute([](int& v) { v = 1; }, tensor);
+
+    CHECK(nt::reduce(tensor, std::plus<>{}, 0) == 3 * 4 + 2000 * 3);
+    CHECK(nt::reduce(nt::par, tensor, std::plus<>{}, 0) == 3 * 4 + 2000 * 3);
+    CHECK(nt::reduce(nt::unseq, tensor, std::plus<>{}, 0) == 3 * 4 + 2000 * 3);
+  }
+
+  SECTION("unaligned plane, unsequenced policy") {
+    static constexpr nt::Dimensions<1001> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<long long>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    auto fn = [](long long& v) {
+      static long long i = 0;
+      v = i++;
+    };
+    nt::execute(fn, tensor);
+
+    auto unaligned_tensor =
+        nt::create_tensor<nt::ShapeTransmutation>(plane.template like<nt::Dimensions<997>{}, nt::Strides<1>{}>(3));
+    CHECK(nt::reduce(nt::unseq, unaligned_tensor, std::plus<>{}, 0ll) == (3ll + 999ll) * 997ll / 2ll);
+  }
+
+  SECTION("sparse plane") {
+    static constexpr nt::Dimensions<10, 10> dimensions;
+    auto plane = nt::create_plane<nt::SparseBuffer<int>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    tensor.slicing_value(0u, 2u, 3u) = 5;
+    tensor.slicing_value(0u, 7u, 9u) = 4;
+
+    CHECK(nt::reduce(tensor, std::plus<>{}, 0) == 9);
+    CHECK(nt::reduce(nt::unseq, tensor, std::plus<>{}, 0) == 9);
+  }
+
+  SECTION("transform_reduce") {
+    static constexpr nt::Dimensions<64, 33> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<double>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    nt::execute([](double& v) { v = 2.0; }, tensor);
+
+    auto square = [](const auto& v) { return v * v; };
+    CHECK(nt::transform_reduce(tensor, std::plus<>{}, square, 0.0) == 4.0 * 64 * 33);
+    CHECK(nt::transform_reduce(nt::par, tensor, std::plus<>{}, square, 0.0) == 4.0 * 64 * 33);
+    CHECK(nt::transform_reduce(nt::unseq, tensor, std::plus<>{}, square, 0.0) == 4.0 * 64 * 33);
+  }
+}
+
+TEST_CASE("reduce along axes method tests") {
+  static constexpr nt::Dimensions<4, 3, 2> dimensions;
+  auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 2u>();
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+  auto fn = [](int& v) {
+    static int i = 0;
+    v = i++ % 48;
+  };
+  nt::execute(fn, tensor);
+
+  // Element (c, i, j, k) has the value of ((k * 3 + j) * 4 + i) * 2 + c
+  auto value = [](int c, int i, int j, int k) { return ((k * 3 + j) * 4 + i) * 2 + c; };
+
+  SECTION("innermost axis") {
+    auto check = [&value](auto reduced_tensor) {
+      using reduced_plane_type = std::decay_t<decltype(reduced_tensor.planes().template plane<0u>())>;
+      STATIC_REQUIRE(std::is_same_v<std::decay_t<decltype(reduced_plane_type::dimensions())>, nt::Dimensions<3, 2>>);
+      STATIC_REQUIRE(reduced_plane_type::channels() == 2u);
+
+      for (int k = 0; k < 2; ++k) {
+        for (int j = 0; j < 3; ++j) {
+          for (int c = 0; c < 2; ++c) {
+            const int expected = value(c, 0, j, k) + value(c, 1, j, k) + value(c, 2, j, k) + value(c, 3, j, k);
+            CHECK(reduced_tensor.slicing_value(c, static_cast<unsigned>(j), static_cast<unsigned>(k)) == expected);
+          }
+        }
+      }
+    };
+
+    check(nt::reduce<0>(tensor, std::plus<>{}, 0));
+    check(nt::reduce<0>(nt::par, tensor, std::plus<>{}, 0));
+    check(nt::reduce<0>(nt::unseq, tensor, std::plus<>{}, 0));
+  }
+
+  SECTION("outermost axis, with an initial value") {
+    auto reduced_tensor = nt::reduce<2>(nt::par, tensor, std::plus<>{}, 100);
+    using reduced_plane_type = std::decay_t<decltype(reduced_tensor.planes().template plane<0u>())>;
+    STATIC_REQUIRE(std::is_same_v<std::decay_t<decltype(reduced_plane_type::dimensions())>, nt::Dimensions<4, 3>>);
+
+    for (int j = 0; j < 3; ++j) {
+      for (int i = 0; i < 4; ++i) {
+        for (int c = 0; c < 2; ++c) {
+          CHECK(reduced_tensor.slicing_value(c, static_cast<unsigned>(i), static_cast<unsigned>(j)) ==
+                100 + value(c, i, j, 0) + value(c, i, j, 1));
+        }
+      }
+    }
+  }
+
+  SECTION("two axes, maximum") {
+    auto reduced_tensor =
+        nt::reduce<2, 0>(tensor, [](int lhs, int rhs) { return std::max(lhs, rhs); }, std::numeric_limits<int>::min());
+    using reduced_plane_type = std::decay_t<decltype(reduced_tensor.planes().template plane<0u>())>;
+    STATIC_REQUIRE(std::is_same_v<std::decay_t<decltype(reduced_plane_type::dimensions())>, nt::Dimensions<3>>);
+
+    for (int j = 0; j < 3; ++j) {
+      for (int c = 0; c < 2; ++c) {
+        CHECK(reduced_tensor.slicing_value(c, static_cast<unsigned>(j)) == value(c, 3, j, 1));
+      }
+    }
+  }
+
+  SECTION("transform_reduce along an axis") {
+    auto reduced_tensor = nt::transform_reduce<1>(tensor, std::plus<>{}, [](int v) { return v % 2 ? 1.0 : 0.0; }, 0.0);
+    using reduced_plane_type = std::decay_t<decltype(reduced_tensor.planes().template plane<0u>())>;
+    STATIC_REQUIRE(std::is_same_v<typename reduced_plane_type::value_type, double>);
+
+    for (unsigned k = 0u; k < 2u; ++k) {
+      for (unsigned i = 0u; i < 4u; ++i) {
+        CHECK(reduced_tensor.slicing_value(0u, i, k) == 0.0);
+        CHECK(reduced_tensor.slicing_value(1u, i, k) == 3.0);
+      }
+    }
+  }
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <dense_buffer.hpp>
+#include <execute.hpp>
 #include <plane.hpp>
 #include <reshape.hpp>
 #include <shape_transmutation.hpp>
@@ -75,4 +76,79 @@ TEST_CASE("reshape method tests") {
       }
     }
   }
+
+  SECTION("reshape view with padding") {
+    static constexpr nt::Dimensions<5, 2, 4> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    int i = 0;
+    nt::execute([&i](int& v) { v = i++; }, tensor);
+
+    static constexpr nt::Dimensions<10, 2, 2> reshaped_dimensions;
+    auto reshaped_tensor = nt::reshape<reshaped_dimensions, 0u, nt::reshape_mode::view>(tensor);
+    using reshaped_plane_type = std::decay_t<decltype(reshaped_tensor.planes().template plane<0u>())>;
+
+    static_assert(std::is_same_v<reshaped_plane_type::buffer_type, nt::ReshapedBuffer<decltype(plane)>>);
+    static_assert(std::is_same_v<std::decay_t<decltype(reshaped_plane_type::strides())>, nt::Strides<1, 10, 20>>);
+    CHECK(reshaped_tensor.planes().template plane<0u>().buffer().size() == 40u);
+
+    int value = 0;
+
+    for (std::size_t k = 0u; k < 2u; ++k) {
+      for (std::size_t j = 0u; j < 2u; ++j) {
+        for (std::size_t i = 0u; i < 10u; ++i) {
+          CHECK(reshaped_tensor.slicing_value(0, i, j, k) == value);
+          ++value;
+        }
+      }
+    }
+
+    // The view shares the elements of the original plane
+    reshaped_tensor.slicing_value(0, 7u, 1u, 1u) = 100;
+    CHECK(tensor.slicing_value(0, 2u, 1u, 3u) == 100);
+
+    value = 0;
+    bool ordered = true;
+    nt::execute([&value, &ordered](int v) { ordered &= v == (value == 37 ? 100 : value), ++value; }, reshaped_tensor);
+    CHECK(ordered);
+  }
+
+  SECTION("reshape view of a transposed plane with channels") {
+    static constexpr nt::Dimensions<37, 45> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 3u>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    int i = 0;
+    nt::execute([&i](int& v) { v = i++; }, tensor);
+    auto transposed = tensor.template permute<0u, 1u, 0u>();
+
+    static constexpr nt::Dimensions<15, 111> reshaped_dimensions;
+    auto view = nt::reshape<reshaped_dimensions, 0u, nt::reshape_mode::view>(transposed);
+    auto copy = nt::reshape<reshaped_dimensions, 0u, nt::reshape_mode::materialize>(transposed);
+
+    bool equal = true;
+    nt::execute([&equal](int lhs, int rhs) { equal &= lhs == rhs; }, view, copy);
+    CHECK(equal);
+    CHECK(view.slicing_value(2u, 14u, 110u) == copy.slicing_value(2u, 14u, 110u));
+    CHECK(view.slicing_value(1u, 3u, 0u) == tensor.slicing_value(1u, 0u, 3u));
+  }
+
+  SECTION("reshape view with negative strides") {
+    static constexpr nt::Dimensions<3, 4> dimensions;
+    auto plane = nt::create_plane<nt::DenseBuffer<int>, dimensions, 1u, false>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    int i = 0;
+    nt::execute([&i](int& v) { v = i++; }, tensor);
+
+    // Iterates the rows from the last to the first one
+    auto reversed_plane = plane.template like<dimensions, nt::Strides<1, -3>{}>(9);
+    auto reversed = nt::create_tensor<nt::ShapeTransmutation>(reversed_plane);
+    auto view = nt::reshape<nt::Dimensions<6, 2>{}, 0u, nt::reshape_mode::view>(reversed);
+
+    const int expected[12] = {9, 10, 11, 6, 7, 8, 3, 4, 5, 0, 1, 2};
+    int position = 0;
+    bool equal = true;
+    nt::execute([&](int v) { equal &= v == expected[position++]; }, view);
+    CHECK(equal);
+    CHECK(position == 12);
+  }
 }
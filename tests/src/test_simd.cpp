@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+#include <simd.hpp>
+
+namespace nt = ntensor;
+
+TEST_CASE("simd_pack class tests") {
+  SECTION("size and width") {
+    STATIC_REQUIRE(nt::simd_pack<float, 16>::size() == 16u);
+    STATIC_REQUIRE(nt::simd_width_v<float> == NT_SIMD_WIDTH / sizeof(float));
+    STATIC_REQUIRE(nt::simd_width_v<double> == NT_SIMD_WIDTH / sizeof(double));
+  }
+
+  SECTION("broadcast, load and store") {
+    nt::simd_pack<int, 8> broadcast{3};
+    for (std::size_t i = 0u; i < 8u; ++i) CHECK(broadcast[i] == 3);
+
+    int values[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    auto pack = nt::simd_pack<int, 8>::load(values + 1);
+    for (std::size_t i = 0u; i < 8u; ++i) CHECK(pack[i] == static_cast<int>(i) + 1);
+
+    int result[9] = {};
+    pack.store(result + 1);
+    CHECK(result[0] == 0);
+    for (std::size_t i = 1u; i < 9u; ++i) CHECK(result[i] == static_cast<int>(i));
+  }
+
+  SECTION("arithmetic operators") {
+    float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    auto pack = nt::simd_pack<float, 4>::load(values);
+
+    auto result = (pack * 2.0f + 1.0f - pack) / 2.0f;
+    for (std::size_t i = 0u; i < 4u; ++i) CHECK(result[i] == (values[i] + 1.0f) / 2.0f);
+
+    auto negated = -pack;
+    for (std::size_t i = 0u; i < 4u; ++i) CHECK(negated[i] == -values[i]);
+
+    pack += 1.0f;
+    pack *= pack;
+    for (std::size_t i = 0u; i < 4u; ++i) CHECK(pack[i] == (values[i] + 1.0f) * (values[i] + 1.0f));
+  }
+
+  SECTION("min and max") {
+    int fst_values[4] = {1, 5, 3, 7};
+    int snd_values[4] = {4, 2, 6, 0};
+    auto fst = nt::simd_pack<int, 4>::load(fst_values);
+    auto snd = nt::simd_pack<int, 4>::load(snd_values);
+
+    int min_values[4] = {1, 2, 3, 0};
+    int max_values[4] = {4, 5, 6, 7};
+    CHECK(min(fst, snd) == nt::simd_pack<int, 4>::load(min_values));
+    CHECK(max(fst, snd) == nt::simd_pack<int, 4>::load(max_values));
+  }
+
+  SECTION("comparison") {
+    nt::simd_pack<double, 2> fst{0.0};
+    nt::simd_pack<double, 2> snd{-0.0};
+
+    CHECK(fst == snd);
+    CHECK_FALSE(bitwise_equal(fst, snd));
+    CHECK(bitwise_equal(fst, nt::simd_pack<double, 2>{0.0}));
+  }
+}
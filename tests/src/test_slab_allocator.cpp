@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <execute.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <slab_allocator.hpp>
+#include <tensor.hpp>
+#include <thread>
+#include <vector>
+
+namespace nt = ntensor;
+
+TEST_CASE("SlabAllocator class tests") {
+  nt::SlabAllocator<int> allocator{};
+
+  SECTION("allocation and deallocation") {
+    int* p = allocator.allocate(10);
+    REQUIRE(p);
+    CHECK(!(reinterpret_cast<uintptr_t>(p) % NT_ALIGNMENT));
+    allocator.deallocate(p, 10);
+  }
+
+  SECTION("deallocated blocks are recycled") {
+    int* first = allocator.allocate(1000);
+    int* second = allocator.allocate(1000);
+    CHECK(first != second);
+    allocator.deallocate(first, 1000);
+
+    // Allocations of a different size don't use the same blocks
+    double* other = nt::SlabAllocator<double>{allocator}.allocate(1000);
+    CHECK(static_cast<void*>(other) != static_cast<void*>(first));
+
+    int* third = allocator.allocate(1000);
+    CHECK(third == first);
+
+    allocator.deallocate(second, 1000);
+    allocator.deallocate(third, 1000);
+    nt::SlabAllocator<double>{}.deallocate(other, 1000);
+  }
+
+  SECTION("blocks deallocated by other threads") {
+    std::vector<int*> blocks;
+    for (std::size_t i = 0u; i < 100u; ++i) {
+      blocks.push_back(allocator.allocate(3000));
+    }
+
+    std::thread{[&blocks] {
+      for (int* p : blocks) {
+        nt::SlabAllocator<int>{}.deallocate(p, 3000);
+      }
+    }}.join();
+
+    // The exiting thread hands its blocks back, so they are reused instead of allocating new slabs
+    const std::size_t capacity = nt::slab_pool_capacity();
+    for (std::size_t i = 0u; i < 100u; ++i) {
+      blocks[i] = allocator.allocate(3000);
+    }
+    CHECK(nt::slab_pool_capacity() == capacity);
+
+    for (int* p : blocks) {
+      allocator.deallocate(p, 3000);
+    }
+  }
+
+  SECTION("equality operator") {
+    CHECK(nt::SlabAllocator<int>{} == nt::SlabAllocator<float>{});
+    CHECK(!(nt::SlabAllocator<int>{} != nt::SlabAllocator<float>{}));
+  }
+}
+
+TEST_CASE("PooledBuffer tests") {
+  static constexpr nt::Dimensions<33u, 17u> dimensions;
+
+  SECTION("creating the same planes repeatedly doesn't allocate new slabs") {
+    auto iteration = [] {
+      auto first = nt::create_plane<nt::PooledBuffer<float>, dimensions>();
+      auto second = nt::create_plane<nt::PooledBuffer<float>, dimensions, 3u>();
+      auto tensor = nt::create_tensor<nt::ShapeTransmutation>(first, second);
+      nt::execute([](float& v) { v = 2.0f; }, tensor);
+      CHECK(tensor.slicing_value(0u, 32u, 16u) == 2.0f);
+      CHECK(tensor.template slicing_value<1u>(2u, 32u, 16u) == 2.0f);
+    };
+
+    iteration();
+    const std::size_t capacity = nt::slab_pool_capacity();
+    for (std::size_t i = 0u; i < 50u; ++i) {
+      iteration();
+    }
+    CHECK(nt::slab_pool_capacity() == capacity);
+  }
+
+  SECTION("the memory is kept alive by copies of the buffer") {
+    nt::PooledBuffer<int> copy;
+    {
+      nt::PooledBuffer<int> buffer(1000u);
+      buffer[999u] = 42;
+      copy = buffer;
+    }
+    nt::PooledBuffer<int> other(1000u);
+    CHECK(other.data() != copy.data());
+    CHECK(copy[999u] == 42);
+  }
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <sparse_buffer.hpp>
 
 namespace nt = ntensor;
@@ -184,13 +185,13 @@ TEST_CASE("SparseValue class tests") {
 
     {
       int assigned_value = 5;
-      int value = 0;
-      auto callback = [&value](int*& ptr, const int& v) {
-        ptr = &value;
-        value = v;
-      };
-      nt::SparseBuffer<int>::SparseValue<int> sparse_value{callback};
+      nt::SparseBuffer<int> buffer{10};
+      nt::SparseBuffer<int>::SparseValue<int> sparse_value{buffer, 3u};
+      sparse_value = 0;
+      CHECK(!buffer.nonzeros());
       sparse_value = assigned_value;
+      CHECK(buffer.nonzeros() == 1u);
+      CHECK(buffer[3u] == assigned_value);
 
       CHECK(sparse_value == assigned_value);
       CHECK(!(sparse_value > assigned_value));
@@ -209,6 +210,34 @@ TEST_CASE("SparseValue class tests") {
       CHECK(sparse_value == 20);
       sparse_value /= 2;
       CHECK(sparse_value == 10);
+      CHECK(buffer[3u] == 10);
+    }
+
+    {
+      // Writes to elements that aren't stored, using the values the elements would have after the write
+      nt::SparseBuffer<float> buffer{10};
+      buffer[0u] += 2.0f;
+      buffer[1u] -= 3.0f;
+      buffer[2u] *= 4.0f;
+      buffer[3u] /= 5.0f;
+      buffer[4u] /= 0.0f;
+      CHECK(buffer[0u] == 2.0f);
+      CHECK(buffer[1u] == -3.0f);
+      CHECK(buffer[2u] == 0.0f);
+      CHECK(buffer[3u] == 0.0f);
+      CHECK(std::isnan(static_cast<float>(buffer[4u])));
+      CHECK(buffer.nonzeros() == 3u);
+    }
+
+    {
+      // Assigning one element to another copies the value, not the reference
+      nt::SparseBuffer<int> buffer{10};
+      buffer[0u] = 7;
+      buffer[5u] = buffer[0u];
+      buffer[6u] = buffer[1u];
+      CHECK(buffer[5u] == 7);
+      CHECK(buffer[0u] == 7);
+      CHECK(buffer.nonzeros() == 2u);
     }
   }
 }
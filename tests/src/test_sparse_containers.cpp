@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <map>
+#include <sparse_buffer.hpp>
+#include <sparse_containers.hpp>
+#include <vector>
+
+namespace nt = ntensor;
+
+namespace {
+
+constexpr std::size_t num_elements = 64u * 50u;
+
+/*
+ * Stores the same elements (in a shuffled order) into a SparseBuffer and a reference map, and compares them
+ */
+template <typename Container>
+void check_sparse_buffer() {
+  nt::SparseBuffer<float, Container> buffer{num_elements};
+  std::map<std::size_t, float> expected;
+
+  for (std::size_t i = 0u; i < 400u; ++i) {
+    const std::size_t index = (i * 2654435761u) % num_elements;
+    const auto value = static_cast<float>(i + 1u);
+    buffer[index] = value;
+    expected[index] = value;
+  }
+
+  // Assigning zero to an element that isn't stored doesn't store it
+  const std::size_t absent = (400u * 2654435761u) % num_elements;
+  if (!expected.contains(absent)) {
+    const std::size_t nonzeros = buffer.nonzeros();
+    buffer[absent] = 0.0f;
+    CHECK(buffer.nonzeros() == nonzeros);
+  }
+
+  for (std::size_t index = 0u; index < num_elements; ++index) {
+    const auto it = expected.find(index);
+    const float value = it != expected.end() ? it->second : 0.0f;
+    CHECK(buffer[index] == value);
+    CHECK(std::as_const(buffer)[index] == value);
+  }
+
+  // Modifying existing elements
+  for (const auto& [index, value] : expected) {
+    buffer[index] += 1.0f;
+    CHECK(buffer[index] == value + 1.0f);
+  }
+
+  CHECK(buffer.nonzeros() >= expected.size());
+  CHECK(buffer.bytes_per_nonzero() > 0.0);
+}
+
+/*
+ * Returns the indices of the stored elements in the order in which the container iterates them
+ */
+template <typename Container>
+std::vector<std::size_t> iteration_order(const Container& container) {
+  std::vector<std::size_t> indices;
+  container.for_each([&indices](std::size_t index, const float&) { indices.push_back(index); });
+  return indices;
+}
+
+/*
+ * Stores elements with insert_range and assign_sorted, and compares them with a reference map
+ */
+template <typename Container>
+void check_bulk_insertion() {
+  nt::SparseBuffer<float, Container> buffer{num_elements};
+  std::map<std::size_t, float> expected;
+
+  auto insert = [&buffer, &expected](std::size_t first, std::size_t step, std::size_t count, float value) {
+    std::vector<std::size_t> indices;
+    std::vector<float> values;
+    for (std::size_t i = 0u; i < count; ++i) {
+      indices.push_back(first + i * step);
+      values.push_back(i % 5u ? value + static_cast<float>(i) : 0.0f);
+      if (values.back() != 0.0f || expected.contains(indices.back())) expected[indices.back()] = values.back();
+    }
+    buffer.insert_range(indices, values);
+  };
+
+  // Appending, then inserting in between the stored elements, then overwriting them
+  insert(0u, 10u, 100u, 1.0f);
+  insert(1500u, 3u, 200u, 2.0f);
+  insert(5u, 7u, 300u, 3.0f);
+  insert(0u, 10u, 50u, 4.0f);
+
+  for (std::size_t index = 0u; index < num_elements; ++index) {
+    const auto it = expected.find(index);
+    CHECK(buffer[index] == (it != expected.end() ? it->second : 0.0f));
+  }
+
+  const std::vector<std::size_t> indices{3u, 64u, 65u, 3000u};
+  const std::vector<float> values{1.0f, 0.0f, 2.0f, 3.0f};
+  buffer.assign_sorted(indices, values);
+  CHECK(buffer[3u] == 1.0f);
+  CHECK(buffer[64u] == 0.0f);
+  CHECK(buffer[65u] == 2.0f);
+  CHECK(buffer[3000u] == 3.0f);
+  CHECK(buffer[10u] == 0.0f);
+  CHECK(buffer[1503u] == 0.0f);
+}
+
+}  // namespace
+
+TEST_CASE("sparse container tests") {
+  SECTION("bulk insertion") {
+    check_bulk_insertion<std::unordered_map<std::size_t, float>>();
+    check_bulk_insertion<nt::CooContainer<float>>();
+    check_bulk_insertion<nt::CsrContainer<float, 64u>>();
+    check_bulk_insertion<nt::BlockSparseContainer<float>>();
+  }
+
+  SECTION("SparseBuffer with different containers") {
+    check_sparse_buffer<std::unordered_map<std::size_t, float>>();
+    check_sparse_buffer<nt::CooContainer<float>>();
+    check_sparse_buffer<nt::CsrContainer<float, 64u>>();
+    check_sparse_buffer<nt::BlockSparseContainer<float>>();
+  }
+
+  SECTION("COO container") {
+    nt::CooContainer<float> container;
+    container.insert(10u, 1.0f);
+    container.insert(3u, 2.0f);
+    container.insert(7u, 3.0f);
+    container.insert(20u, 4.0f);
+
+    CHECK(container.nonzeros() == 4u);
+    CHECK(*container.find(7u) == 3.0f);
+    CHECK(!container.find(8u));
+    CHECK(iteration_order(container) == std::vector<std::size_t>{3u, 7u, 10u, 20u});
+  }
+
+  SECTION("CSR container") {
+    nt::CsrContainer<float, 10u> container{100u};
+    container.insert(55u, 1.0f);
+    container.insert(12u, 2.0f);
+    container.insert(51u, 3.0f);
+    container.insert(98u, 4.0f);
+    container.insert(0u, 5.0f);
+
+    CHECK(container.nonzeros() == 5u);
+    CHECK(*container.find(51u) == 3.0f);
+    CHECK(*container.find(98u) == 4.0f);
+    CHECK(*container.find(0u) == 5.0f);
+    CHECK(!container.find(52u));
+    CHECK(!container.find(99u));
+    CHECK(iteration_order(container) == std::vector<std::size_t>{0u, 12u, 51u, 55u, 98u});
+  }
+
+  SECTION("block-sparse container") {
+    static constexpr std::size_t block_size = NT_ALIGNMENT / sizeof(float);
+    nt::BlockSparseContainer<float> container;
+    container.insert(5u * block_size + 1u, 1.0f);
+    container.insert(2u * block_size, 2.0f);
+
+    // All of the elements of the stored blocks are stored
+    CHECK(container.nonzeros() == 2u * block_size);
+    CHECK(*container.find(5u * block_size + 1u) == 1.0f);
+    CHECK(*container.find(5u * block_size) == 0.0f);
+    CHECK(!container.find(3u * block_size));
+
+    const float* block = container.block(2u * block_size + 3u);
+    REQUIRE(block);
+    CHECK(!(reinterpret_cast<std::uintptr_t>(block) % NT_ALIGNMENT));
+    CHECK(block[0u] == 2.0f);
+
+    const auto order = iteration_order(container);
+    REQUIRE(order.size() == 2u * block_size);
+    CHECK(order.front() == 2u * block_size);
+    CHECK(order.back() == 6u * block_size - 1u);
+  }
+
+  SECTION("memory per non-zero element") {
+    nt::SparseBuffer<float> hashed{num_elements};
+    nt::SparseBuffer<float, nt::CooContainer<float>> coo{num_elements};
+    nt::SparseBuffer<float, nt::CsrContainer<float, 64u>> csr{num_elements};
+
+    for (std::size_t i = 0u; i < num_elements; i += 7u) {
+      hashed[i] = 1.0f;
+      coo[i] = 1.0f;
+      csr[i] = 1.0f;
+    }
+
+    CHECK(coo.bytes_per_nonzero() < hashed.bytes_per_nonzero());
+    CHECK(csr.bytes_per_nonzero() < coo.bytes_per_nonzero());
+  }
+}
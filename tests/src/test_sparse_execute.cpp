@@ -0,0 +1,167 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <dense_buffer.hpp>
+#include <plane.hpp>
+#include <shape_transmutation.hpp>
+#include <sparse_buffer.hpp>
+#include <sparse_containers.hpp>
+#include <sparse_execute.hpp>
+#include <tensor.hpp>
+
+namespace nt = ntensor;
+
+namespace {
+
+/*
+ * Stores the value i + 100 * j into every 7th element of a 2D plane, and returns the number of stored elements
+ */
+template <typename Tensor>
+std::size_t fill(Tensor& tensor, std::size_t width, std::size_t height, std::size_t channels = 1u) {
+  std::size_t stored = 0u;
+  for (unsigned j = 0u; j < height; ++j) {
+    for (unsigned i = 0u; i < width; ++i) {
+      for (unsigned c = 0u; c < channels; ++c) {
+        if ((i + j * width + c) % 7u == 0u) {
+          tensor.slicing_value(c, i, j) = static_cast<float>(i + 100u * j + 1000u * c + 1u);
+          ++stored;
+        }
+      }
+    }
+  }
+  return stored;
+}
+
+template <typename Container>
+void check_container() {
+  static constexpr nt::Dimensions<10u, 6u> dimensions;
+  auto tensor =
+      nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::SparseBuffer<float, Container>, dimensions>());
+  const std::size_t stored = fill(tensor, 10u, 6u);
+
+  SECTION("only the stored elements are visited, with their multi-indices") {
+    std::size_t visited = 0u;
+    nt::execute_sparse(
+        [&visited](float& value, std::size_t channel, const std::array<std::size_t, 2u>& indexes) {
+          CHECK(channel == 0u);
+          CHECK(value == static_cast<float>(indexes[0] + 100u * indexes[1] + 1u));
+          ++visited;
+        },
+        tensor);
+    CHECK(visited == stored);
+  }
+
+  SECTION("stored elements can be modified") {
+    nt::execute_sparse([](float& value) { value *= 2.0f; }, tensor);
+    CHECK(tensor.slicing_value(0u, 7u, 0u) == 16.0f);
+    CHECK(tensor.slicing_value(0u, 1u, 0u) == 0.0f);
+  }
+
+  SECTION("visiting all elements stores the ones that became non-zero") {
+    std::size_t visited = 0u;
+    nt::execute_sparse<nt::sparse_visit::all>(
+        [&visited](float& value) {
+          value += 1.0f;
+          ++visited;
+        },
+        tensor);
+    CHECK(visited == 60u);
+
+    for (unsigned j = 0u; j < 6u; ++j) {
+      for (unsigned i = 0u; i < 10u; ++i) {
+        const float expected = (i + j * 10u) % 7u == 0u ? static_cast<float>(i + 100u * j + 2u) : 1.0f;
+        CHECK(tensor.slicing_value(0u, i, j) == expected);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("execute_sparse method tests") {
+  SECTION("unordered_map container") { check_container<std::unordered_map<std::size_t, float>>(); }
+  SECTION("COO container") { check_container<nt::CooContainer<float>>(); }
+  SECTION("CSR container") { check_container<nt::CsrContainer<float, 16u>>(); }
+
+  SECTION("planes viewing a part of a buffer") {
+    static constexpr nt::Dimensions<10u, 6u> dimensions;
+    auto plane = nt::create_plane<nt::SparseBuffer<float, nt::CooContainer<float>>, dimensions>();
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(plane);
+    fill(tensor, 10u, 6u);
+
+    // Rows 2 to 4, columns 3 to 7
+    static constexpr auto strides = decltype(plane)::strides();
+    auto view = plane.template like<nt::Dimensions<5u, 3u>{}, strides>(2 * strides.template at<1u>() + 3);
+    auto view_tensor = nt::create_tensor<nt::ShapeTransmutation>(view);
+
+    std::size_t visited = 0u;
+    nt::execute_sparse(
+        [&visited](const float& value, std::size_t, const std::array<std::size_t, 2u>& indexes) {
+          CHECK(indexes[0] < 5u);
+          CHECK(indexes[1] < 3u);
+          CHECK(value == static_cast<float>(indexes[0] + 3u + 100u * (indexes[1] + 2u) + 1u));
+          ++visited;
+        },
+        view_tensor);
+
+    std::size_t expected = 0u;
+    for (unsigned j = 2u; j < 5u; ++j) {
+      for (unsigned i = 3u; i < 8u; ++i) {
+        expected += (i + j * 10u) % 7u == 0u;
+      }
+    }
+    CHECK(visited == expected);
+  }
+
+  SECTION("planes with channels") {
+    static constexpr nt::Dimensions<4u, 5u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::SparseBuffer<float, nt::CooContainer<float>>, dimensions, 3u>());
+    const std::size_t stored = fill(tensor, 4u, 5u, 3u);
+
+    std::size_t visited = 0u;
+    nt::execute_sparse(
+        [&visited](float& value, std::size_t channel, const std::array<std::size_t, 2u>& indexes) {
+          CHECK(value == static_cast<float>(indexes[0] + 100u * indexes[1] + 1000u * channel + 1u));
+          ++visited;
+        },
+        tensor);
+    CHECK(visited == stored);
+  }
+
+  SECTION("dense planes visit all elements") {
+    static constexpr nt::Dimensions<4u, 5u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<float>, dimensions>(),
+                                                            nt::create_plane<nt::SparseBuffer<float>, dimensions>());
+    std::size_t visited = 0u;
+    nt::execute_sparse([&visited](auto&) { ++visited; }, tensor);
+    CHECK(visited == 20u);
+  }
+
+  SECTION("dense planes pass the channels and the multi-indices") {
+    static constexpr nt::Dimensions<4u, 5u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<float>, dimensions, 2u>(),
+        nt::create_plane<nt::SparseBuffer<float, nt::CooContainer<float>>, dimensions, 2u>());
+    for (unsigned j = 0u; j < 5u; ++j) {
+      for (unsigned i = 0u; i < 4u; ++i) {
+        for (unsigned c = 0u; c < 2u; ++c) {
+          tensor.slicing_value(c, i, j) = static_cast<float>(i + 100u * j + 1000u * c + 1u);
+        }
+      }
+    }
+    tensor.template slicing_value<1u>(1u, 2u, 3u) = 1.0f;
+
+    std::size_t visited = 0u;
+    nt::execute_sparse(
+        [&visited](float& value, std::size_t channel, const std::array<std::size_t, 2u>& indexes) {
+          if (visited++ < 40u) {
+            CHECK(value == static_cast<float>(indexes[0] + 100u * indexes[1] + 1000u * channel + 1u));
+          } else {
+            CHECK((channel == 1u && indexes == std::array<std::size_t, 2u>{2u, 3u}));
+          }
+        },
+        tensor);
+    // All elements of the dense plane, and the stored element of the sparse plane
+    CHECK(visited == 41u);
+  }
+}
@@ -1,11 +1,17 @@
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <charconv>
+#include <cstdio>
 #include <dense_buffer.hpp>
+#include <iomanip>
 #include <plane.hpp>
 #include <shape_transmutation.hpp>
 #include <sparse_buffer.hpp>
 #include <sstream>
 #include <stream_io.hpp>
+#include <string>
 #include <tensor.hpp>
+#include <thread_pool.hpp>
 
 namespace nt = ntensor;
 
@@ -389,4 +395,204 @@ TEST_CASE("write_to_sink and load_from_source") {
       }
     }
   }
+
+  SECTION("read in parallel") {
+    nt::ThreadPool pool{4u};
+
+    // Compares the elements of two tensors in the logical order
+    auto elements_equal = [](auto& lhs, auto& rhs) {
+      bool equal = true;
+      nt::execute([&equal](int l, int r) { equal &= l == r; }, lhs, rhs);
+      return equal;
+    };
+
+    {
+      // The text of the first plane is long enough to be split into several chunks
+      static constexpr nt::Dimensions<300u, 250u> fst_dimensions;
+      static constexpr nt::Dimensions<7u, 9u> snd_dimensions;
+      static constexpr std::size_t channels{3u};
+      auto out_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_plane<nt::DenseBuffer<int>, fst_dimensions, channels>(),
+          nt::create_plane<nt::DenseBuffer<int>, snd_dimensions, channels, false>());
+      std::stringstream ss;
+
+      nt::execute([&expected_value](int& v) { v = expected_value++ * 7 - 100000; }, out_tensor);
+      nt::write_to_sink(out_tensor, ss, nt::additional_output_content{"header", "footer"});
+
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_plane<nt::DenseBuffer<int>, fst_dimensions, channels, false>(),
+          nt::create_plane<nt::DenseBuffer<int>, snd_dimensions, channels>());
+      nt::load_from_source(nt::par.on(pool), in_tensor, ss.view());
+
+      CHECK(elements_equal(in_tensor, out_tensor));
+      CHECK(in_tensor.slicing_value(2u, 299u, 249u) == out_tensor.slicing_value(2u, 299u, 249u));
+      CHECK(in_tensor.template slicing_value<1u>(1u, 6u, 8u) == out_tensor.template slicing_value<1u>(1u, 6u, 8u));
+    }
+  }
+
+  SECTION("read from a stream") {
+    auto elements_equal = [](auto& lhs, auto& rhs) {
+      bool equal = true;
+      nt::execute([&equal](int l, int r) { equal &= l == r; }, lhs, rhs);
+      return equal;
+    };
+
+    // The text of the first plane is larger than the reader's buffer
+    static constexpr nt::Dimensions<300u, 250u> fst_dimensions;
+    static constexpr nt::Dimensions<7u, 9u> snd_dimensions;
+    static constexpr std::size_t channels{3u};
+    auto out_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, fst_dimensions, channels>(),
+        nt::create_plane<nt::DenseBuffer<int>, snd_dimensions, channels, false>());
+    std::stringstream ss;
+
+    nt::execute([&expected_value](int& v) { v = expected_value++ * 7 - 100000; }, out_tensor);
+    nt::write_to_sink(out_tensor, ss, nt::additional_output_content{"header\nsecond line", "footer"});
+    REQUIRE(ss.view().size() > nt::reader_buffer_size);
+
+    {
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_plane<nt::DenseBuffer<int>, fst_dimensions, channels, false>(),
+          nt::create_plane<nt::DenseBuffer<int>, snd_dimensions, channels>());
+      std::stringstream in{ss.str()};
+      nt::load_from_stream(in_tensor, in);
+
+      CHECK(elements_equal(in_tensor, out_tensor));
+      CHECK(in_tensor.template slicing_value<1u>(2u, 6u, 8u) == out_tensor.template slicing_value<1u>(2u, 6u, 8u));
+    }
+
+    {
+      // The callback delivers a few characters at a time, so most values are split between two reads
+      const std::string text = ss.str();
+      std::size_t read = 0u;
+      auto callback = [&text, &read](char* buffer, std::size_t size) {
+        const std::size_t length = std::min({size, std::size_t{7u}, text.size() - read});
+        text.copy(buffer, length, read);
+        read += length;
+        return length;
+      };
+
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(
+          nt::create_plane<nt::DenseBuffer<int>, fst_dimensions, channels>(),
+          nt::create_plane<nt::DenseBuffer<int>, snd_dimensions, channels>());
+      nt::load_from_stream(in_tensor, callback);
+
+      CHECK(elements_equal(in_tensor, out_tensor));
+    }
+
+    {
+      // Floating point values, read with a custom converter
+      auto out_plane = nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<4u, 3u>{}>();
+      auto float_tensor = nt::create_tensor<nt::ShapeTransmutation>(out_plane);
+      float value = 0.25f;
+      nt::execute([&value](float& v) { v = value *= -1.5f; }, float_tensor);
+
+      std::stringstream float_ss;
+      nt::write_to_sink(float_tensor, float_ss);
+
+      auto in_plane = nt::create_plane<nt::DenseBuffer<float>, nt::Dimensions<4u, 3u>{}>();
+      auto in_tensor = nt::create_tensor<nt::ShapeTransmutation>(in_plane);
+      nt::load_from_stream(in_tensor, float_ss, [](std::string_view view, float& v) {
+        return std::from_chars(view.data(), view.data() + view.size(), v).ec == std::errc{};
+      });
+
+      bool equal = true;
+      nt::execute([&equal](float l, float r) { equal &= l == r; }, in_tensor, float_tensor);
+      CHECK(equal);
+    }
+  }
+}
+
+TEST_CASE("BufferedWriter class tests") {
+  SECTION("formatting") {
+    std::stringstream ss;
+    {
+      nt::BufferedWriter writer{ss};
+      writer << 'a' << std::string_view{"bc"} << -42 << ',' << 0.1f << ',' << 2.5 << ',' << true << ','
+             << std::uint8_t{200} << ',' << std::string{"text"};
+      CHECK(ss.view().empty());
+      writer.flush();
+      CHECK(ss.view() == "abc-42,0.1,2.5,1,200,text");
+    }
+  }
+
+  SECTION("blocks written to a callback") {
+    std::string text;
+    std::size_t num_blocks = 0u;
+    auto callback = [&text, &num_blocks](std::string_view block) {
+      text += block;
+      ++num_blocks;
+    };
+
+    {
+      nt::BufferedWriter writer{callback};
+      for (int i = 0; i < 10000; ++i) {
+        writer << i << ',';
+      }
+      writer << std::string(2u * nt::writer_buffer_size, 'x');
+    }
+
+    std::string expected;
+    for (int i = 0; i < 10000; ++i) {
+      expected += std::to_string(i) + ',';
+    }
+    expected += std::string(2u * nt::writer_buffer_size, 'x');
+
+    CHECK(text == expected);
+    // The text is written in blocks, and the long sequence of characters is written directly
+    CHECK(num_blocks <= expected.size() / nt::writer_buffer_size + 2u);
+  }
+
+  SECTION("write a tensor to a file") {
+    static constexpr nt::Dimensions<3u, 2u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<double>, dimensions>());
+    double value = 0.0;
+    nt::execute([&value](double& v) { v = (value += 0.25); }, tensor);
+
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file);
+    nt::write_to_sink(tensor, file);
+
+    std::string text(std::ftell(file), '\0');
+    std::rewind(file);
+    CHECK(std::fread(text.data(), 1u, text.size(), file) == text.size());
+    std::fclose(file);
+
+    CHECK(text == "{\n[\n[0.25,0.5,0.75]\n[1,1.25,1.5]\n]\n}\n\n");
+  }
+
+  SECTION("custom formatter") {
+    static constexpr nt::Dimensions<3u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<int>, dimensions>());
+    int value = 0;
+    nt::execute([&value](int& v) { v = value++; }, tensor);
+
+    std::stringstream ss;
+    nt::write_to_sink(tensor, ss, {}, [](auto& writer, int v) { writer << 'v' << v * 10; });
+    CHECK(ss.view() == "{\n[v0,v10,v20]\n}\n\n");
+  }
+
+  SECTION("custom formatter taking the stream") {
+    static constexpr nt::Dimensions<3u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<double>, dimensions>());
+    double value = 0.5;
+    nt::execute([&value](double& v) { v = value++; }, tensor);
+
+    // The formatter writes to the stream itself, so the stream's formatting flags apply
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    nt::write_to_sink(tensor, ss, {}, [](std::ostream& stream, double v) { stream << v; });
+    CHECK(ss.view() == "{\n[0.50,1.50,2.50]\n}\n\n");
+  }
+
+  SECTION("custom formatter writing characters") {
+    static constexpr nt::Dimensions<3u> dimensions;
+    auto tensor = nt::create_tensor<nt::ShapeTransmutation>(nt::create_plane<nt::DenseBuffer<char>, dimensions>());
+    char value = 'a';
+    nt::execute([&value](char& v) { v = value++; }, tensor);
+
+    std::stringstream ss;
+    nt::write_to_sink(tensor, ss, {}, [](std::ostream& stream, char c) { stream << c; });
+    CHECK(ss.view() == "{\n[a,b,c]\n}\n\n");
+  }
 }
@@ -1,8 +1,14 @@
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <dense_buffer.hpp>
+#include <future>
+#include <mutex>
 #include <plane.hpp>
 #include <shape_transmutation.hpp>
+#include <stdexcept>
 #include <tensor.hpp>
+#include <thread_pool.hpp>
+#include <vector>
 
 namespace nt = ntensor;
 
@@ -289,3 +295,76 @@ TEST_CASE("Tensor class without policies tests") {
     }
   }
 }
+
+TEST_CASE("for_each_plane method tests") {
+  // Planes of a YUV 4:2:0 image, and a plane with several channels
+  auto tensor = nt::create_tensor<nt::ShapeTransmutation>(
+      nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<16u, 8u>{}>(),
+      nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<8u, 4u>{}>(),
+      nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<8u, 4u>{}>(),
+      nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<8u, 2u>{}, 3u>());
+
+  // Work of each plane (elements of all channels)
+  std::mutex mutex;
+  std::vector<std::size_t> visited;
+  auto visit = [&mutex, &visited](auto& plane) {
+    std::scoped_lock lock{mutex};
+    visited.emplace_back(nt::plane_elements(plane) * std::decay_t<decltype(plane)>::channels());
+  };
+
+  SECTION("each plane is visited once") {
+    nt::ThreadPool pool{3u};
+    nt::for_each_plane(nt::par.on(pool), visit, tensor);
+
+    std::sort(visited.begin(), visited.end());
+    CHECK(visited == std::vector<std::size_t>{32u, 32u, 48u, 128u});
+  }
+
+  SECTION("planes are started in order of decreasing work") {
+    // On the only worker of the pool, the calling thread claims all planes before the submitted chunk runs
+    nt::ThreadPool pool{1u};
+    std::promise<void> done;
+    pool.submit([&] {
+      nt::for_each_plane(nt::par.on(pool), visit, tensor);
+      done.set_value();
+    });
+    done.get_future().get();
+
+    CHECK(visited == std::vector<std::size_t>{128u, 48u, 32u, 32u});
+  }
+
+  SECTION("sequenced policy") {
+    nt::for_each_plane(nt::seq, visit, tensor);
+    CHECK(visited == std::vector<std::size_t>{128u, 32u, 32u, 48u});
+  }
+
+  SECTION("planes of several tensors") {
+    auto other = nt::create_tensor<nt::ShapeTransmutation>(
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4u>{}>(),
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<200u>{}>(),
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4u>{}>(),
+        nt::create_plane<nt::DenseBuffer<int>, nt::Dimensions<4u>{}>());
+
+    nt::ThreadPool pool{1u};
+    std::promise<void> done;
+    pool.submit([&] {
+      nt::for_all_planes(nt::par.on(pool), [&visit](auto& plane, auto&) { visit(plane); }, tensor, other);
+      done.set_value();
+    });
+    done.get_future().get();
+
+    // The second planes have the most work in total
+    CHECK(visited == std::vector<std::size_t>{32u, 128u, 48u, 32u});
+  }
+
+  SECTION("exceptions are rethrown once all planes are visited") {
+    nt::ThreadPool pool{2u};
+    auto throwing = [&visit](auto& plane) {
+      visit(plane);
+      if (nt::plane_elements(plane) == 128u) throw std::runtime_error("failure");
+    };
+
+    CHECK_THROWS_AS(nt::for_each_plane(nt::par.on(pool), throwing, tensor), std::runtime_error);
+    CHECK(visited.size() == 4u);
+  }
+}
@@ -0,0 +1,79 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <thread_pool.hpp>
+#include <vector>
+
+namespace nt = ntensor;
+
+TEST_CASE("ThreadPool class tests") {
+  SECTION("size") {
+    nt::ThreadPool pool{4u};
+    CHECK(pool.size() == 4u);
+
+    nt::ThreadPool single_thread_pool{0u};
+    CHECK(single_thread_pool.size() == 1u);
+  }
+
+  SECTION("parallel_for visits each index exactly once") {
+    nt::ThreadPool pool{4u};
+    std::vector<std::atomic<int>> visits(1000u);
+
+    pool.parallel_for(0u, visits.size(), 7u, [&visits](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) {
+        ++visits[i];
+      }
+    });
+
+    for (const auto& v : visits) {
+      CHECK(v == 1);
+    }
+  }
+
+  SECTION("parallel_for with an empty range") {
+    nt::ThreadPool pool{2u};
+    bool called = false;
+    pool.parallel_for(5u, 5u, 1u, [&called](std::size_t, std::size_t) { called = true; });
+    CHECK(!called);
+  }
+
+  SECTION("nested parallel_for") {
+    nt::ThreadPool pool{2u};
+    std::atomic<int> sum{0};
+
+    pool.parallel_for(0u, 8u, 1u, [&pool, &sum](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) {
+        pool.parallel_for(0u, 8u, 1u, [&sum](std::size_t f, std::size_t l) { sum += static_cast<int>(l - f); });
+      }
+    });
+
+    CHECK(sum == 64);
+  }
+
+  SECTION("parallel_for rethrows exceptions") {
+    nt::ThreadPool pool{2u};
+    auto throwing = [](std::size_t first, std::size_t) {
+      if (first == 3u) {
+        throw std::runtime_error("failure");
+      }
+    };
+    CHECK_THROWS_AS(pool.parallel_for(0u, 10u, 1u, throwing), std::runtime_error);
+  }
+
+  SECTION("submit") {
+    nt::ThreadPool pool{2u};
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; ++i) {
+      pool.submit([&counter] { ++counter; });
+    }
+
+    while (counter < 100) {
+      pool.try_run_pending_task();
+    }
+
+    CHECK(counter == 100);
+  }
+
+  SECTION("default thread pool") { CHECK(nt::default_thread_pool().size() > 0u); }
+}